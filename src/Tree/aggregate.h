@@ -0,0 +1,128 @@
+#ifndef __AGGREGATE_H__
+#define __AGGREGATE_H__
+
+#include <algorithm>
+#include <cstddef>
+#include <limits>
+#include <type_traits>
+#include <utility>
+
+namespace s21 {
+// Aggregate policies for trees that keep a summary of every subtree. A
+// policy is a monoid over value_type: identity() is its neutral element,
+// combine() is associative and gets its arguments in key order, lift()
+// turns one mapped value into a value_type.
+
+// Policy of the trees that keep no aggregate
+struct TreeNoAggregate {};
+
+// Policies whose lift() takes the key and the mapped value see both, for
+// aggregates of the keys themselves
+template <typename Aggregate, typename Key, typename Value, typename = void>
+struct lifts_key : std::false_type {};
+
+template <typename Aggregate, typename Key, typename Value>
+struct lifts_key<Aggregate, Key, Value,
+                 std::void_t<decltype(Aggregate::lift(std::declval<const Key&>(), std::declval<const Value&>()))>>
+    : std::true_type {};
+
+template <typename T>
+struct SumAggregate {
+    using value_type = T;
+
+    static T identity() {
+        return T();
+    }
+
+    static T lift(const T& value) {
+        return value;
+    }
+
+    static T combine(const T& a, const T& b) {
+        return a + b;
+    }
+};
+
+// The identity is the largest value, infinity where there is one
+template <typename T>
+struct MinAggregate {
+    using value_type = T;
+
+    static T identity() {
+        if constexpr (std::numeric_limits<T>::has_infinity) {
+            return std::numeric_limits<T>::infinity();
+        } else {
+            return std::numeric_limits<T>::max();
+        }
+    }
+
+    static T lift(const T& value) {
+        return value;
+    }
+
+    static T combine(const T& a, const T& b) {
+        return std::min(a, b);
+    }
+};
+
+// The identity is the lowest value, minus infinity where there is one
+template <typename T>
+struct MaxAggregate {
+    using value_type = T;
+
+    static T identity() {
+        if constexpr (std::numeric_limits<T>::has_infinity) {
+            return -std::numeric_limits<T>::infinity();
+        } else {
+            return std::numeric_limits<T>::lowest();
+        }
+    }
+
+    static T lift(const T& value) {
+        return value;
+    }
+
+    static T combine(const T& a, const T& b) {
+        return std::max(a, b);
+    }
+};
+
+struct CountAggregate {
+    using value_type = std::size_t;
+
+    static std::size_t identity() {
+        return 0;
+    }
+
+    template <typename T>
+    static std::size_t lift(const T&) {
+        return 1;
+    }
+
+    static std::size_t combine(std::size_t a, std::size_t b) {
+        return a + b;
+    }
+};
+
+// Two policies kept side by side, for example the sum and the maximum of
+// the same values in one query
+template <typename First, typename Second>
+struct PairAggregate {
+    using value_type = std::pair<typename First::value_type, typename Second::value_type>;
+
+    static value_type identity() {
+        return {First::identity(), Second::identity()};
+    }
+
+    template <typename T>
+    static value_type lift(const T& value) {
+        return {First::lift(value), Second::lift(value)};
+    }
+
+    static value_type combine(const value_type& a, const value_type& b) {
+        return {First::combine(a.first, b.first), Second::combine(a.second, b.second)};
+    }
+};
+}
+
+#endif
@@ -0,0 +1,584 @@
+#ifndef __BTREE_H__
+#define __BTREE_H__
+
+#include <cstddef>
+#include <functional>
+#include <type_traits>
+#include <utility>
+
+#include "transparent.h"
+
+namespace s21 {
+// Mapped type of the key-only B-tree containers
+struct BTreeNoValue {};
+
+// B+tree with keys kept in contiguous per-node arrays. Elements live in the
+// leaves, which are chained for iteration, inner nodes only route lookups:
+// every key of children[i] <= keys[i] <= every key of children[i + 1].
+// Nodes span a few cache lines, so a lookup touches about log_B(n) nodes
+// and scans each of them linearly. Key and Value must be default
+// constructible and move assignable, slots past count hold spare objects.
+template <typename Key, typename Value, typename Compare = std::less<Key>>
+class BTree {
+public:
+    BTree() : root(nullptr), firstLeaf(nullptr), lastLeaf(nullptr), elements(0), comp() {}
+
+    BTree(const BTree& other) : BTree() {
+        copyFrom(other);
+    }
+
+    BTree(BTree&& other) noexcept : BTree() {
+        takeTree(other);
+    }
+
+    BTree& operator=(const BTree& other) {
+        if (this != &other) {
+            clearTree();
+            copyFrom(other);
+        }
+        return *this;
+    }
+
+    BTree& operator=(BTree&& other) noexcept {
+        if (this != &other) {
+            clearTree();
+            takeTree(other);
+        }
+        return *this;
+    }
+
+    ~BTree() {
+        clearTree();
+    }
+
+protected:
+    static constexpr std::size_t kNodeBytes = 256;
+
+    static constexpr int slotsFor(std::size_t slotBytes) {
+        std::size_t slots = kNodeBytes / slotBytes;
+        return slots < 4 ? 4 : (slots > 64 ? 64 : static_cast<int>(slots));
+    }
+
+    static constexpr int kLeafSlots = slotsFor(sizeof(Key) + (std::is_empty_v<Value> ? 0 : sizeof(Value)));
+    static constexpr int kInnerSlots = slotsFor(sizeof(Key) + sizeof(void*));
+    static constexpr int kLeafMin = kLeafSlots / 2;
+    static constexpr int kInnerMin = kInnerSlots / 2;
+
+    struct Inner;
+
+    struct NodeBase {
+        explicit NodeBase(bool isLeaf) : parent(nullptr), count(0), leaf(isLeaf) {}
+
+        Inner* parent;
+        int count;
+        bool leaf;
+    };
+
+    // The spare slot lets a node overflow by one before it is split
+    struct Leaf : NodeBase {
+        Leaf() : NodeBase(true), prev(nullptr), next(nullptr) {}
+
+        Leaf* prev;
+        Leaf* next;
+        Key keys[kLeafSlots + 1];
+        Value values[kLeafSlots + 1];
+    };
+
+    // count is the number of separators, there are count + 1 children
+    struct Inner : NodeBase {
+        Inner() : NodeBase(false) {}
+
+        Key keys[kInnerSlots + 1];
+        NodeBase* children[kInnerSlots + 2];
+    };
+
+    // Element index inside a leaf, end() is {nullptr, 0}
+    struct Position {
+        Leaf* leaf;
+        int index;
+    };
+
+    NodeBase* root;
+    Leaf* firstLeaf;
+    Leaf* lastLeaf;
+    std::size_t elements;
+    Compare comp;
+
+    Position beginPosition() const {
+        return {firstLeaf, 0};
+    }
+
+    static void stepForward(Leaf*& leaf, int& index) {
+        if (++index == leaf->count) {
+            leaf = leaf->next;
+            index = 0;
+        }
+    }
+
+    // Stepping back from end() lands on the last element
+    void stepBackward(Leaf*& leaf, int& index) const {
+        if (leaf == nullptr) {
+            leaf = lastLeaf;
+            index = leaf->count - 1;
+        } else if (index == 0) {
+            leaf = leaf->prev;
+            index = leaf->count - 1;
+        } else {
+            --index;
+        }
+    }
+
+    template <typename K>
+    int lowerIndex(const Key* keys, int count, const K& key) const {
+        int i = 0;
+        while (i < count && comp(keys[i], key)) {
+            ++i;
+        }
+        return i;
+    }
+
+    template <typename K>
+    int upperIndex(const Key* keys, int count, const K& key) const {
+        int i = 0;
+        while (i < count && !comp(key, keys[i])) {
+            ++i;
+        }
+        return i;
+    }
+
+    template <typename K>
+    Leaf* descendLower(const K& key) const {
+        NodeBase* node = root;
+        while (!node->leaf) {
+            Inner* inner = static_cast<Inner*>(node);
+            node = inner->children[lowerIndex(inner->keys, inner->count, key)];
+        }
+        return static_cast<Leaf*>(node);
+    }
+
+    template <typename K>
+    Leaf* descendUpper(const K& key) const {
+        NodeBase* node = root;
+        while (!node->leaf) {
+            Inner* inner = static_cast<Inner*>(node);
+            node = inner->children[upperIndex(inner->keys, inner->count, key)];
+        }
+        return static_cast<Leaf*>(node);
+    }
+
+    // An index one past the last element of a leaf moves on to the next leaf
+    static Position normalize(Leaf* leaf, int index) {
+        if (index == leaf->count) {
+            return {leaf->next, 0};
+        }
+        return {leaf, index};
+    }
+
+    template <typename K>
+    Position lowerBound(const K& key) const {
+        if (root == nullptr) {
+            return {nullptr, 0};
+        }
+        Leaf* leaf = descendLower(key);
+        return normalize(leaf, lowerIndex(leaf->keys, leaf->count, key));
+    }
+
+    template <typename K>
+    Position upperBound(const K& key) const {
+        if (root == nullptr) {
+            return {nullptr, 0};
+        }
+        Leaf* leaf = descendUpper(key);
+        return normalize(leaf, upperIndex(leaf->keys, leaf->count, key));
+    }
+
+    template <typename K>
+    Position findKey(const K& key) const {
+        Position pos = lowerBound(key);
+        if (pos.leaf != nullptr && comp(key, pos.leaf->keys[pos.index])) {
+            return {nullptr, 0};
+        }
+        return pos;
+    }
+
+    // Returns the existing element and false when an equal key is present
+    template <typename K, typename V>
+    std::pair<Position, bool> insertUnique(K&& key, V&& value) {
+        if (root == nullptr) {
+            return {insertEqual(std::forward<K>(key), std::forward<V>(value)), true};
+        }
+        Leaf* leaf = descendUpper(key);
+        int index = upperIndex(leaf->keys, leaf->count, key);
+        Leaf* before = leaf;
+        int beforeIndex = index - 1;
+        if (index == 0) {
+            before = leaf->prev;
+            beforeIndex = before != nullptr ? before->count - 1 : 0;
+        }
+        if (before != nullptr && !comp(before->keys[beforeIndex], key)) {
+            return {{before, beforeIndex}, false};
+        }
+        return {insertAt(leaf, index, std::forward<K>(key), std::forward<V>(value)), true};
+    }
+
+    // Equal keys keep their insertion order
+    template <typename K, typename V>
+    Position insertEqual(K&& key, V&& value) {
+        if (root == nullptr) {
+            Leaf* leaf = new Leaf;
+            root = leaf;
+            firstLeaf = leaf;
+            lastLeaf = leaf;
+        }
+        Leaf* leaf = descendUpper(key);
+        int index = upperIndex(leaf->keys, leaf->count, key);
+        return insertAt(leaf, index, std::forward<K>(key), std::forward<V>(value));
+    }
+
+    template <typename K, typename V>
+    Position insertAt(Leaf* leaf, int index, K&& key, V&& value) {
+        for (int i = leaf->count; i > index; --i) {
+            leaf->keys[i] = std::move(leaf->keys[i - 1]);
+            leaf->values[i] = std::move(leaf->values[i - 1]);
+        }
+        leaf->keys[index] = std::forward<K>(key);
+        leaf->values[index] = std::forward<V>(value);
+        ++leaf->count;
+        ++elements;
+        if (leaf->count > kLeafSlots) {
+            Leaf* right = splitLeaf(leaf);
+            if (index >= leaf->count) {
+                return {right, index - leaf->count};
+            }
+        }
+        return {leaf, index};
+    }
+
+    Leaf* splitLeaf(Leaf* leaf) {
+        Leaf* right = new Leaf;
+        int mid = leaf->count / 2;
+        for (int i = mid; i < leaf->count; ++i) {
+            right->keys[i - mid] = std::move(leaf->keys[i]);
+            right->values[i - mid] = std::move(leaf->values[i]);
+        }
+        right->count = leaf->count - mid;
+        leaf->count = mid;
+
+        right->prev = leaf;
+        right->next = leaf->next;
+        if (leaf->next != nullptr) {
+            leaf->next->prev = right;
+        } else {
+            lastLeaf = right;
+        }
+        leaf->next = right;
+
+        insertChild(leaf, right->keys[0], right);
+        return right;
+    }
+
+    void splitInner(Inner* node) {
+        Inner* right = new Inner;
+        int mid = node->count / 2;
+        Key separator = std::move(node->keys[mid]);
+        for (int i = mid + 1; i < node->count; ++i) {
+            right->keys[i - mid - 1] = std::move(node->keys[i]);
+        }
+        for (int i = mid + 1; i <= node->count; ++i) {
+            right->children[i - mid - 1] = node->children[i];
+            node->children[i]->parent = right;
+        }
+        right->count = node->count - mid - 1;
+        node->count = mid;
+        insertChild(node, separator, right);
+    }
+
+    // Links right in after left, splitting parents that overflow
+    void insertChild(NodeBase* left, const Key& separator, NodeBase* right) {
+        Inner* parent = left->parent;
+        if (parent == nullptr) {
+            parent = new Inner;
+            parent->keys[0] = separator;
+            parent->children[0] = left;
+            parent->children[1] = right;
+            parent->count = 1;
+            left->parent = parent;
+            right->parent = parent;
+            root = parent;
+            return;
+        }
+        int index = childIndex(parent, left);
+        for (int i = parent->count; i > index; --i) {
+            parent->keys[i] = std::move(parent->keys[i - 1]);
+            parent->children[i + 1] = parent->children[i];
+        }
+        parent->keys[index] = separator;
+        parent->children[index + 1] = right;
+        right->parent = parent;
+        ++parent->count;
+        if (parent->count > kInnerSlots) {
+            splitInner(parent);
+        }
+    }
+
+    static int childIndex(const Inner* parent, const NodeBase* child) {
+        int index = 0;
+        while (parent->children[index] != child) {
+            ++index;
+        }
+        return index;
+    }
+
+    // Removes the element at index and returns the position of the element
+    // that followed it
+    Position eraseAt(Leaf* leaf, int index) {
+        for (int i = index + 1; i < leaf->count; ++i) {
+            leaf->keys[i - 1] = std::move(leaf->keys[i]);
+            leaf->values[i - 1] = std::move(leaf->values[i]);
+        }
+        --leaf->count;
+        --elements;
+        leaf->keys[leaf->count] = Key();
+        leaf->values[leaf->count] = Value();
+
+        if (leaf == root) {
+            if (leaf->count == 0) {
+                delete leaf;
+                root = nullptr;
+                firstLeaf = nullptr;
+                lastLeaf = nullptr;
+                return {nullptr, 0};
+            }
+            return normalize(leaf, index);
+        }
+        if (leaf->count < kLeafMin) {
+            return rebalanceLeaf(leaf, index);
+        }
+        return normalize(leaf, index);
+    }
+
+    // Refills an underfull leaf from a sibling or merges it into one, index
+    // is tracked through the moves
+    Position rebalanceLeaf(Leaf* leaf, int index) {
+        Inner* parent = leaf->parent;
+        int at = childIndex(parent, leaf);
+        Leaf* left = at > 0 ? static_cast<Leaf*>(parent->children[at - 1]) : nullptr;
+        Leaf* right = at < parent->count ? static_cast<Leaf*>(parent->children[at + 1]) : nullptr;
+
+        if (left != nullptr && left->count > kLeafMin) {
+            for (int i = leaf->count; i > 0; --i) {
+                leaf->keys[i] = std::move(leaf->keys[i - 1]);
+                leaf->values[i] = std::move(leaf->values[i - 1]);
+            }
+            --left->count;
+            leaf->keys[0] = std::move(left->keys[left->count]);
+            leaf->values[0] = std::move(left->values[left->count]);
+            ++leaf->count;
+            parent->keys[at - 1] = leaf->keys[0];
+            return normalize(leaf, index + 1);
+        }
+        if (right != nullptr && right->count > kLeafMin) {
+            leaf->keys[leaf->count] = std::move(right->keys[0]);
+            leaf->values[leaf->count] = std::move(right->values[0]);
+            ++leaf->count;
+            for (int i = 1; i < right->count; ++i) {
+                right->keys[i - 1] = std::move(right->keys[i]);
+                right->values[i - 1] = std::move(right->values[i]);
+            }
+            --right->count;
+            parent->keys[at] = right->keys[0];
+            return normalize(leaf, index);
+        }
+        if (left != nullptr) {
+            int offset = left->count;
+            mergeLeaves(left, leaf);
+            removeChild(parent, at - 1);
+            return normalize(left, offset + index);
+        }
+        mergeLeaves(leaf, right);
+        removeChild(parent, at);
+        return normalize(leaf, index);
+    }
+
+    void mergeLeaves(Leaf* left, Leaf* right) {
+        for (int i = 0; i < right->count; ++i) {
+            left->keys[left->count + i] = std::move(right->keys[i]);
+            left->values[left->count + i] = std::move(right->values[i]);
+        }
+        left->count += right->count;
+        left->next = right->next;
+        if (right->next != nullptr) {
+            right->next->prev = left;
+        } else {
+            lastLeaf = left;
+        }
+        delete right;
+    }
+
+    // Drops keys[separator] and children[separator + 1] from node
+    void removeChild(Inner* node, int separator) {
+        for (int i = separator + 1; i < node->count; ++i) {
+            node->keys[i - 1] = std::move(node->keys[i]);
+            node->children[i] = node->children[i + 1];
+        }
+        --node->count;
+
+        if (node == root) {
+            if (node->count == 0) {
+                root = node->children[0];
+                root->parent = nullptr;
+                delete node;
+            }
+            return;
+        }
+        if (node->count < kInnerMin) {
+            rebalanceInner(node);
+        }
+    }
+
+    void rebalanceInner(Inner* node) {
+        Inner* parent = node->parent;
+        int at = childIndex(parent, node);
+        Inner* left = at > 0 ? static_cast<Inner*>(parent->children[at - 1]) : nullptr;
+        Inner* right = at < parent->count ? static_cast<Inner*>(parent->children[at + 1]) : nullptr;
+
+        if (left != nullptr && left->count > kInnerMin) {
+            node->children[node->count + 1] = node->children[node->count];
+            for (int i = node->count; i > 0; --i) {
+                node->keys[i] = std::move(node->keys[i - 1]);
+                node->children[i] = node->children[i - 1];
+            }
+            node->keys[0] = std::move(parent->keys[at - 1]);
+            node->children[0] = left->children[left->count];
+            node->children[0]->parent = node;
+            ++node->count;
+            --left->count;
+            parent->keys[at - 1] = std::move(left->keys[left->count]);
+            return;
+        }
+        if (right != nullptr && right->count > kInnerMin) {
+            node->keys[node->count] = std::move(parent->keys[at]);
+            node->children[node->count + 1] = right->children[0];
+            node->children[node->count + 1]->parent = node;
+            ++node->count;
+            parent->keys[at] = std::move(right->keys[0]);
+            for (int i = 1; i < right->count; ++i) {
+                right->keys[i - 1] = std::move(right->keys[i]);
+            }
+            for (int i = 1; i <= right->count; ++i) {
+                right->children[i - 1] = right->children[i];
+            }
+            --right->count;
+            return;
+        }
+        if (left != nullptr) {
+            mergeInner(left, node, parent->keys[at - 1]);
+            removeChild(parent, at - 1);
+        } else {
+            mergeInner(node, right, parent->keys[at]);
+            removeChild(parent, at);
+        }
+    }
+
+    // Appends the separator and everything of right to left
+    void mergeInner(Inner* left, Inner* right, Key& separator) {
+        left->keys[left->count] = std::move(separator);
+        for (int i = 0; i < right->count; ++i) {
+            left->keys[left->count + 1 + i] = std::move(right->keys[i]);
+        }
+        for (int i = 0; i <= right->count; ++i) {
+            left->children[left->count + 1 + i] = right->children[i];
+            right->children[i]->parent = left;
+        }
+        left->count += right->count + 1;
+        delete right;
+    }
+
+    void clearTree() {
+        if (root != nullptr) {
+            destroyNode(root);
+        }
+        root = nullptr;
+        firstLeaf = nullptr;
+        lastLeaf = nullptr;
+        elements = 0;
+    }
+
+    void destroyNode(NodeBase* node) {
+        if (node->leaf) {
+            delete static_cast<Leaf*>(node);
+            return;
+        }
+        Inner* inner = static_cast<Inner*>(node);
+        for (int i = 0; i <= inner->count; ++i) {
+            destroyNode(inner->children[i]);
+        }
+        delete inner;
+    }
+
+    void copyFrom(const BTree& other) {
+        comp = other.comp;
+        if (other.root != nullptr) {
+            Leaf* previous = nullptr;
+            root = copyNode(other.root, nullptr, previous);
+            lastLeaf = previous;
+        }
+        elements = other.elements;
+    }
+
+    // previous is the last leaf copied so far, new leaves are chained to it
+    NodeBase* copyNode(const NodeBase* node, Inner* parent, Leaf*& previous) {
+        if (node->leaf) {
+            const Leaf* source = static_cast<const Leaf*>(node);
+            Leaf* leaf = new Leaf;
+            for (int i = 0; i < source->count; ++i) {
+                leaf->keys[i] = source->keys[i];
+                leaf->values[i] = source->values[i];
+            }
+            leaf->count = source->count;
+            leaf->parent = parent;
+            leaf->prev = previous;
+            if (previous != nullptr) {
+                previous->next = leaf;
+            } else {
+                firstLeaf = leaf;
+            }
+            previous = leaf;
+            return leaf;
+        }
+        const Inner* source = static_cast<const Inner*>(node);
+        Inner* inner = new Inner;
+        for (int i = 0; i < source->count; ++i) {
+            inner->keys[i] = source->keys[i];
+        }
+        inner->count = source->count;
+        inner->parent = parent;
+        for (int i = 0; i <= source->count; ++i) {
+            inner->children[i] = copyNode(source->children[i], inner, previous);
+        }
+        return inner;
+    }
+
+    void takeTree(BTree& other) {
+        root = other.root;
+        firstLeaf = other.firstLeaf;
+        lastLeaf = other.lastLeaf;
+        elements = other.elements;
+        comp = other.comp;
+        other.root = nullptr;
+        other.firstLeaf = nullptr;
+        other.lastLeaf = nullptr;
+        other.elements = 0;
+    }
+
+    void swapTree(BTree& other) noexcept {
+        std::swap(root, other.root);
+        std::swap(firstLeaf, other.firstLeaf);
+        std::swap(lastLeaf, other.lastLeaf);
+        std::swap(elements, other.elements);
+        std::swap(comp, other.comp);
+    }
+};
+}
+
+#endif
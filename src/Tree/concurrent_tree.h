@@ -0,0 +1,268 @@
+#ifndef __CONCURRENT_TREE_H__
+#define __CONCURRENT_TREE_H__
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+
+#include "epoch.h"
+
+namespace s21 {
+// AVL tree for many readers and one writer at a time. Nodes carry the key,
+// value, children and height of Tree's nodes but no parent link, and they
+// never change once readers can reach them. A writer copies the nodes on
+// the path it touches, relinks the copies freely since nobody else sees
+// them, and publishes the new version with a single store of the root.
+// Readers pin an epoch, load the root and walk a consistent version
+// without taking locks; replaced nodes are retired to the epoch domain.
+template <typename Key, typename Value, typename Compare = std::less<Key>>
+class ConcurrentTree {
+public:
+    ConcurrentTree() : root(nullptr), elements(0), writeVersion(0), comp() {}
+
+    ConcurrentTree(const ConcurrentTree&) = delete;
+    ConcurrentTree& operator=(const ConcurrentTree&) = delete;
+
+    // No reader may be inside the tree any more
+    ~ConcurrentTree() {
+        destroyTree(root.load());
+    }
+
+protected:
+    struct Node {
+        Node(const Key& k, const Value& v, std::uint64_t created)
+        : key(k), value(v), left(nullptr), right(nullptr), height(1), version(created) {}
+
+        Key key;
+        Value value;
+        Node* left;
+        Node* right;
+        int height;
+        // Write that created the node, only the writer reads it
+        std::uint64_t version;
+    };
+
+    std::atomic<Node*> root;
+    std::atomic<std::size_t> elements;
+    EpochDomain epochs;
+    std::mutex writer;
+    std::uint64_t writeVersion;
+    Compare comp;
+
+    // Readers
+
+    // Pinned for as long as the caller reads nodes of the loaded root
+    typename EpochDomain::Guard pin() const {
+        return epochs.pin();
+    }
+
+    Node* loadRoot() const {
+        return root.load();
+    }
+
+    template <typename K>
+    const Node* findNode(const Node* node, const K& key) const {
+        while (node) {
+            if (comp(key, node->key)) {
+                node = node->left;
+            } else if (comp(node->key, key)) {
+                node = node->right;
+            } else {
+                return node;
+            }
+        }
+        return nullptr;
+    }
+
+    // In order walk of the keys in [from, to), stops when visit returns false
+    template <typename K, typename Visit>
+    bool visitRange(const Node* node, const K& from, const K& to, Visit& visit) const {
+        if (!node) {
+            return true;
+        }
+        bool aboveFrom = !comp(node->key, from);
+        bool belowTo = comp(node->key, to);
+        if (aboveFrom && !visitRange(node->left, from, to, visit)) {
+            return false;
+        }
+        if (aboveFrom && belowTo && !visit(node->key, node->value)) {
+            return false;
+        }
+        return !belowTo || visitRange(node->right, from, to, visit);
+    }
+
+    template <typename Visit>
+    static bool visitAll(const Node* node, Visit& visit) {
+        if (!node) {
+            return true;
+        }
+        return visitAll(node->left, visit) && visit(node->key, node->value) && visitAll(node->right, visit);
+    }
+
+    // Writers, every call below runs with writer locked
+
+    // Starts a write: nodes created from here on belong to it
+    void beginWrite() {
+        ++writeVersion;
+    }
+
+    // Publishes the new root. The epoch cannot move during a write, so the
+    // nodes it retired are tagged no older than the readers that saw them.
+    void publish(Node* newRoot) {
+        root.store(newRoot);
+        epochs.collect();
+    }
+
+    bool fresh(const Node* node) const {
+        return node->version == writeVersion;
+    }
+
+    // A node this write may change: itself when it was created by this
+    // write, otherwise a copy, and the original is retired
+    Node* writable(Node* node) {
+        if (fresh(node)) {
+            return node;
+        }
+        Node* copy = new Node(node->key, node->value, writeVersion);
+        copy->left = node->left;
+        copy->right = node->right;
+        copy->height = node->height;
+        epochs.retire(node);
+        return copy;
+    }
+
+    // Drops a node that is no longer linked
+    void discard(Node* node) {
+        if (fresh(node)) {
+            delete node;
+        } else {
+            epochs.retire(node);
+        }
+    }
+
+    static int heightOf(const Node* node) {
+        return node ? node->height : 0;
+    }
+
+    static void updateHeight(Node* node) {
+        node->height = 1 + std::max(heightOf(node->left), heightOf(node->right));
+    }
+
+    Node* rotateRight(Node* node) {
+        Node* left = writable(node->left);
+        node->left = left->right;
+        left->right = node;
+        updateHeight(node);
+        updateHeight(left);
+        return left;
+    }
+
+    Node* rotateLeft(Node* node) {
+        Node* right = writable(node->right);
+        node->right = right->left;
+        right->left = node;
+        updateHeight(node);
+        updateHeight(right);
+        return right;
+    }
+
+    // node is writable
+    Node* balance(Node* node) {
+        updateHeight(node);
+        int factor = heightOf(node->left) - heightOf(node->right);
+        if (factor > 1) {
+            if (heightOf(node->left->left) < heightOf(node->left->right)) {
+                node->left = rotateLeft(writable(node->left));
+            }
+            return rotateRight(node);
+        }
+        if (factor < -1) {
+            if (heightOf(node->right->right) < heightOf(node->right->left)) {
+                node->right = rotateRight(writable(node->right));
+            }
+            return rotateLeft(node);
+        }
+        return node;
+    }
+
+    // Root of the tree with key mapped to value, replacing the value of an
+    // equal key
+    template <typename K>
+    Node* insertNode(Node* node, const K& key, const Value& value) {
+        if (!node) {
+            return new Node(Key(key), value, writeVersion);
+        }
+        Node* copy = writable(node);
+        if (comp(key, copy->key)) {
+            copy->left = insertNode(copy->left, key, value);
+        } else if (comp(copy->key, key)) {
+            copy->right = insertNode(copy->right, key, value);
+        } else {
+            copy->value = value;
+            return copy;
+        }
+        return balance(copy);
+    }
+
+    // Root of the tree without key, which must be present
+    template <typename K>
+    Node* eraseNode(Node* node, const K& key) {
+        if (comp(key, node->key)) {
+            Node* copy = writable(node);
+            copy->left = eraseNode(copy->left, key);
+            return balance(copy);
+        }
+        if (comp(node->key, key)) {
+            Node* copy = writable(node);
+            copy->right = eraseNode(copy->right, key);
+            return balance(copy);
+        }
+        Node* left = node->left;
+        Node* right = node->right;
+        discard(node);
+        if (!left || !right) {
+            return left ? left : right;
+        }
+        Node* successor = nullptr;
+        right = eraseMin(right, successor);
+        successor->left = left;
+        successor->right = right;
+        return balance(successor);
+    }
+
+    // Unlinks the smallest node of the subtree and returns it writable
+    Node* eraseMin(Node* node, Node*& min) {
+        Node* copy = writable(node);
+        if (!copy->left) {
+            min = copy;
+            return copy->right;
+        }
+        copy->left = eraseMin(copy->left, min);
+        return balance(copy);
+    }
+
+    // Unlinks every node, they are retired since readers may be inside
+    void retireTree(Node* node) {
+        while (node) {
+            retireTree(node->left);
+            Node* right = node->right;
+            epochs.retire(node);
+            node = right;
+        }
+    }
+
+    static void destroyTree(Node* node) {
+        while (node) {
+            destroyTree(node->left);
+            Node* right = node->right;
+            delete node;
+            node = right;
+        }
+    }
+};
+}
+
+#endif
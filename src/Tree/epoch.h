@@ -0,0 +1,127 @@
+#ifndef __EPOCH_H__
+#define __EPOCH_H__
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <thread>
+
+namespace s21 {
+// Epoch based reclamation. Readers pin the current epoch for the length of
+// a read, writers retire unlinked objects instead of deleting them and the
+// domain frees them once every reader that could still hold one has left.
+// Readers announce themselves in one of a few padded counter slots chosen
+// by thread id, so they do not all write the same cache line. Each slot
+// counts readers by epoch parity, which is enough because the epoch only
+// moves on when no reader is left two epochs behind.
+// pin() may be called from any thread, retire() and collect() must be
+// serialized by the caller.
+class EpochDomain {
+    static constexpr std::size_t kSlots = 64;
+
+    struct alignas(64) Slot {
+        std::atomic<std::size_t> active[2];
+    };
+
+public:
+    // Keeps the epoch it entered pinned until destroyed
+    class Guard {
+    public:
+        explicit Guard(const EpochDomain& domain) : slot(&domain.slots[slotIndex()]) {
+            for (;;) {
+                std::uint64_t current = domain.epoch.load();
+                parity = current & 1;
+                slot->active[parity].fetch_add(1);
+                if (domain.epoch.load() == current) {
+                    return;
+                }
+                slot->active[parity].fetch_sub(1);
+            }
+        }
+
+        Guard(const Guard&) = delete;
+        Guard& operator=(const Guard&) = delete;
+
+        ~Guard() {
+            slot->active[parity].fetch_sub(1, std::memory_order_release);
+        }
+
+    private:
+        Slot* slot;
+        std::size_t parity;
+    };
+
+    EpochDomain() : epoch(0) {
+        for (Slot& slot : slots) {
+            slot.active[0].store(0);
+            slot.active[1].store(0);
+        }
+    }
+
+    EpochDomain(const EpochDomain&) = delete;
+    EpochDomain& operator=(const EpochDomain&) = delete;
+
+    // No reader may be pinned any more
+    ~EpochDomain() {
+        for (Retired& item : retired) {
+            item.destroy(item.object);
+        }
+    }
+
+    Guard pin() const {
+        return Guard(*this);
+    }
+
+    // object must already be unreachable for readers that pin from now on
+    template <typename T>
+    void retire(T* object) {
+        retired.push_back({object, [](void* p) { delete static_cast<T*>(p); }, epoch.load()});
+    }
+
+    // Moves the epoch on when the readers allow it and frees whatever was
+    // retired two or more epochs ago
+    void collect() {
+        std::uint64_t current = epoch.load();
+        if (quiet((current + 1) & 1)) {
+            epoch.store(++current);
+        }
+        while (!retired.empty() && retired.front().epoch + 2 <= current) {
+            retired.front().destroy(retired.front().object);
+            retired.pop_front();
+        }
+    }
+
+    std::size_t pending() const {
+        return retired.size();
+    }
+
+private:
+    struct Retired {
+        void* object;
+        void (*destroy)(void*);
+        std::uint64_t epoch;
+    };
+
+    mutable Slot slots[kSlots];
+    std::atomic<std::uint64_t> epoch;
+    std::deque<Retired> retired;
+
+    static std::size_t slotIndex() {
+        static thread_local const std::size_t index = std::hash<std::thread::id>()(std::this_thread::get_id()) % kSlots;
+        return index;
+    }
+
+    bool quiet(std::size_t parity) const {
+        for (const Slot& slot : slots) {
+            if (slot.active[parity].load() != 0) {
+                return false;
+            }
+        }
+        return true;
+    }
+};
+}
+
+#endif
@@ -0,0 +1,269 @@
+#ifndef __EYTZINGER_H__
+#define __EYTZINGER_H__
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <type_traits>
+
+#if (defined(__GNUC__) || defined(__clang__)) && defined(__x86_64__)
+#include <immintrin.h>
+#define S21_EYTZINGER_AVX2 1
+#endif
+
+namespace s21 {
+// Searches over sorted keys stored in Eytzinger order: the implicit binary
+// tree of a heap, slot 1 holding the root and slots 2k and 2k + 1 the
+// children of slot k, slot 0 unused. A search reads slots 1, 2 or 3, 4 to
+// 7 and so on, so its first levels share a few cache lines for every key,
+// and the 2^d descendants of a slot d levels down are contiguous and can
+// be prefetched with one request. Slot 0 stands for "none" and for end().
+
+// Levels whose descendants fit in one 64-byte line, prefetched ahead
+template <typename Key>
+constexpr unsigned eytzingerPrefetchLevels() {
+    unsigned levels = 0;
+    while ((sizeof(Key) << (levels + 1)) <= 64) {
+        ++levels;
+    }
+    return levels;
+}
+
+inline std::size_t countTrailingOnes(std::size_t k) {
+#if defined(__GNUC__) || defined(__clang__)
+    return static_cast<std::size_t>(__builtin_ctzll(~static_cast<unsigned long long>(k)));
+#else
+    std::size_t ones = 0;
+    for (; k & 1; k >>= 1) {
+        ++ones;
+    }
+    return ones;
+#endif
+}
+
+// Slot where a descent ended past the leaves back to the last slot where
+// it went left, 0 when it never did
+inline std::size_t eytzingerResolve(std::size_t k) {
+    return k >> (countTrailingOnes(k) + 1);
+}
+
+// Number of levels of a tree of count slots
+inline unsigned eytzingerLevels(std::size_t count) {
+    unsigned levels = 0;
+    for (; count != 0; count >>= 1) {
+        ++levels;
+    }
+    return levels;
+}
+
+inline std::size_t eytzingerFirst(std::size_t count) {
+    std::size_t k = count == 0 ? 0 : 1;
+    while (k != 0 && 2 * k <= count) {
+        k = 2 * k;
+    }
+    return k;
+}
+
+inline std::size_t eytzingerLast(std::size_t count) {
+    std::size_t k = count == 0 ? 0 : 1;
+    while (k != 0 && 2 * k + 1 <= count) {
+        k = 2 * k + 1;
+    }
+    return k;
+}
+
+// In-order successor of slot k, 0 after the last one. O(1) amortized.
+inline std::size_t eytzingerNext(std::size_t k, std::size_t count) {
+    if (2 * k + 1 <= count) {
+        k = 2 * k + 1;
+        while (2 * k <= count) {
+            k = 2 * k;
+        }
+        return k;
+    }
+    return eytzingerResolve(k);
+}
+
+// In-order predecessor of slot k, the last slot for 0
+inline std::size_t eytzingerPrev(std::size_t k, std::size_t count) {
+    if (k == 0) {
+        return eytzingerLast(count);
+    }
+    if (2 * k <= count) {
+        k = 2 * k;
+        while (2 * k + 1 <= count) {
+            k = 2 * k + 1;
+        }
+        return k;
+    }
+    while (k != 0 && (k & 1) == 0) {
+        k >>= 1;
+    }
+    return k >> 1;
+}
+
+template <typename Key>
+void prefetchSlot(const Key* slot) {
+#if defined(__GNUC__) || defined(__clang__)
+    __builtin_prefetch(slot);
+#else
+    (void)slot;
+#endif
+}
+
+// Slot of the first key not less than key, 0 when there is none. The
+// descent has no data dependent branch: each level picks the child with
+// the result of the comparison, and the line holding the descendants a
+// few levels down is requested while the current level is compared.
+template <typename Key, typename K, typename Compare>
+std::size_t eytzingerLowerBound(const Key* keys, std::size_t count, const K& key, const Compare& comp) {
+    constexpr unsigned ahead = eytzingerPrefetchLevels<Key>();
+    std::size_t k = 1;
+    while (k <= count) {
+        prefetchSlot(keys + (k << ahead));
+        k = 2 * k + (comp(keys[k], key) ? 1 : 0);
+    }
+    return eytzingerResolve(k);
+}
+
+template <typename Key, typename K, typename Compare>
+std::size_t eytzingerUpperBound(const Key* keys, std::size_t count, const K& key, const Compare& comp) {
+    constexpr unsigned ahead = eytzingerPrefetchLevels<Key>();
+    std::size_t k = 1;
+    while (k <= count) {
+        prefetchSlot(keys + (k << ahead));
+        k = 2 * k + (comp(key, keys[k]) ? 0 : 1);
+    }
+    return eytzingerResolve(k);
+}
+
+// Descents kept in flight by eytzingerLowerBoundMany()
+constexpr std::size_t kEytzingerLanes = 32;
+
+// slots[i] = eytzingerLowerBound(keys, count, queries[i], comp) for a
+// batch. Up to kEytzingerLanes descents go down level by level together,
+// so the cache misses of different queries overlap.
+template <typename Key, typename Queries, typename Compare>
+void eytzingerLowerBoundLanes(const Key* keys, std::size_t count, const Queries& queries, std::size_t first,
+                              std::size_t last, const Compare& comp, std::size_t* slots) {
+    unsigned levels = eytzingerLevels(count);
+    for (; first < last; first += kEytzingerLanes) {
+        std::size_t lanes = last - first < kEytzingerLanes ? last - first : kEytzingerLanes;
+        std::size_t k[kEytzingerLanes];
+        for (std::size_t lane = 0; lane < lanes; ++lane) {
+            k[lane] = 1;
+        }
+        for (unsigned level = 0; level < levels; ++level) {
+            for (std::size_t lane = 0; lane < lanes; ++lane) {
+                if (k[lane] <= count) {
+                    k[lane] = 2 * k[lane] + (comp(keys[k[lane]], queries[first + lane]) ? 1 : 0);
+                    prefetchSlot(keys + k[lane]);
+                }
+            }
+        }
+        for (std::size_t lane = 0; lane < lanes; ++lane) {
+            slots[first + lane] = eytzingerResolve(k[lane]);
+        }
+    }
+}
+
+// Integral keys of 4 or 8 bytes ordered by std::less and searched for
+// with queries of the same type can use AVX2 gathers
+template <typename Key, typename Query, typename Compare>
+struct eytzinger_simd
+    : std::integral_constant<bool, std::is_integral<Key>::value && (sizeof(Key) == 4 || sizeof(Key) == 8) &&
+                                       std::is_same<Key, Query>::value &&
+                                       (std::is_same<Compare, std::less<Key>>::value ||
+                                        std::is_same<Compare, std::less<>>::value)> {};
+
+#ifdef S21_EYTZINGER_AVX2
+inline bool hasAvx2() {
+    static const bool supported = __builtin_cpu_supports("avx2");
+    return supported;
+}
+
+// A key widened to a signed 64-bit lane that compares like the key
+template <typename Key>
+long long eytzingerLane(Key key) {
+    if constexpr (std::is_unsigned<Key>::value && sizeof(Key) == 8) {
+        return static_cast<long long>(static_cast<unsigned long long>(key) ^ (1ULL << 63));
+    }
+    return static_cast<long long>(key);
+}
+
+// Four descents per vector, eight vectors in flight: every level gathers
+// the keys of the current slots of all lanes at once, compares them with
+// the queries and moves each lane to a child with a blend. Lanes that
+// already left the tree are masked out of the gather and keep their slot.
+template <typename Key, typename Queries>
+__attribute__((target("avx2"))) void eytzingerLowerBoundAvx2(const Key* keys, std::size_t count,
+                                                              const Queries& queries, std::size_t first,
+                                                              std::size_t last, std::size_t* slots) {
+    constexpr std::size_t kVectors = kEytzingerLanes / 4;
+    unsigned levels = eytzingerLevels(count);
+    const __m256i limit = _mm256_set1_epi64x(static_cast<long long>(count));
+    const __m256i ones = _mm256_set1_epi64x(-1);
+    const __m256i sign = _mm256_set1_epi64x(static_cast<long long>(1ULL << 63));
+    const __m256i odd = _mm256_setr_epi32(0, 2, 4, 6, 0, 2, 4, 6);
+    for (; first + kEytzingerLanes <= last; first += kEytzingerLanes) {
+        __m256i k[kVectors];
+        __m256i q[kVectors];
+        for (std::size_t v = 0; v < kVectors; ++v) {
+            std::size_t i = first + 4 * v;
+            k[v] = _mm256_set1_epi64x(1);
+            q[v] = _mm256_setr_epi64x(eytzingerLane(queries[i]), eytzingerLane(queries[i + 1]),
+                                      eytzingerLane(queries[i + 2]), eytzingerLane(queries[i + 3]));
+        }
+        for (unsigned level = 0; level < levels; ++level) {
+            for (std::size_t v = 0; v < kVectors; ++v) {
+                __m256i active = _mm256_xor_si256(_mm256_cmpgt_epi64(k[v], limit), ones);
+                __m256i found;
+                if constexpr (sizeof(Key) == 8) {
+                    found = _mm256_mask_i64gather_epi64(_mm256_setzero_si256(), reinterpret_cast<const long long*>(keys),
+                                                        k[v], active, 8);
+                    if constexpr (std::is_unsigned<Key>::value) {
+                        found = _mm256_xor_si256(found, sign);
+                    }
+                } else {
+                    __m128i mask = _mm256_castsi256_si128(_mm256_permutevar8x32_epi32(active, odd));
+                    __m128i narrow = _mm256_mask_i64gather_epi32(_mm_setzero_si128(), reinterpret_cast<const int*>(keys),
+                                                                 k[v], mask, 4);
+                    found = std::is_unsigned<Key>::value ? _mm256_cvtepu32_epi64(narrow)
+                                                         : _mm256_cvtepi32_epi64(narrow);
+                }
+                __m256i less = _mm256_cmpgt_epi64(q[v], found);
+                __m256i child = _mm256_sub_epi64(_mm256_add_epi64(k[v], k[v]), less);
+                k[v] = _mm256_blendv_epi8(k[v], child, active);
+            }
+        }
+        for (std::size_t v = 0; v < kVectors; ++v) {
+            alignas(32) unsigned long long lanes[4];
+            _mm256_store_si256(reinterpret_cast<__m256i*>(lanes), k[v]);
+            for (std::size_t lane = 0; lane < 4; ++lane) {
+                slots[first + 4 * v + lane] = eytzingerResolve(static_cast<std::size_t>(lanes[lane]));
+            }
+        }
+    }
+    eytzingerLowerBoundLanes(keys, count, queries, first, last, std::less<Key>(), slots);
+}
+#endif
+
+// Lower bounds of a batch of queries, any indexable container of keys.
+// Integral keys go through AVX2 when the processor has it.
+template <typename Key, typename Queries, typename Compare>
+void eytzingerLowerBoundMany(const Key* keys, std::size_t count, const Queries& queries, const Compare& comp,
+                             std::size_t* slots) {
+#ifdef S21_EYTZINGER_AVX2
+    using Query = std::remove_cv_t<std::remove_reference_t<decltype(queries[0])>>;
+    if constexpr (eytzinger_simd<Key, Query, Compare>::value) {
+        if (hasAvx2()) {
+            eytzingerLowerBoundAvx2(keys, count, queries, 0, queries.size(), slots);
+            return;
+        }
+    }
+#endif
+    eytzingerLowerBoundLanes(keys, count, queries, 0, queries.size(), comp, slots);
+}
+}
+
+#endif
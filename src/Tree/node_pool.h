@@ -0,0 +1,120 @@
+#ifndef __NODE_POOL_H__
+#define __NODE_POOL_H__
+
+#include <cstddef>
+#include <new>
+#include <utility>
+
+namespace s21 {
+// Slab allocator for tree nodes. Nodes are carved out of contiguous slabs
+// that grow geometrically, freed nodes are recycled through an intrusive
+// free list and release() gives every slab back at once.
+// A pool is not thread-safe, only the tree that owns it allocates from it
+// and frees into it. It is held through a shared_ptr so that node handles
+// and trees that took nodes living in its slabs keep the slabs alive.
+template <typename Node>
+class NodePool {
+public:
+    NodePool()
+    : slabs(nullptr), cursor(nullptr), limit(nullptr), freeList(nullptr), nextCapacity(kFirstSlab), bytes(0) {}
+
+    NodePool(const NodePool&) = delete;
+    NodePool& operator=(const NodePool&) = delete;
+
+    ~NodePool() {
+        release();
+    }
+
+    template <typename... Args>
+    Node* create(Args&&... args) {
+        void* place = allocate();
+        try {
+            return new (place) Node(std::forward<Args>(args)...);
+        } catch (...) {
+            deallocate(place);
+            throw;
+        }
+    }
+
+    void destroy(Node* node) {
+        node->~Node();
+        deallocate(node);
+    }
+
+    // Frees all slabs without running node destructors
+    void release() {
+        while (slabs != nullptr) {
+            Slab* next = slabs->next;
+            ::operator delete(slabs, std::align_val_t(kAlign));
+            slabs = next;
+        }
+        cursor = nullptr;
+        limit = nullptr;
+        freeList = nullptr;
+        nextCapacity = kFirstSlab;
+        bytes = 0;
+    }
+
+    std::size_t allocatedBytes() const {
+        return bytes;
+    }
+
+private:
+    struct Slab {
+        Slab* next;
+    };
+
+    struct FreeNode {
+        FreeNode* next;
+    };
+
+    static_assert(sizeof(Node) >= sizeof(FreeNode), "node is too small for the free list");
+
+    static constexpr std::size_t kAlign = alignof(Node) > alignof(Slab) ? alignof(Node) : alignof(Slab);
+    static constexpr std::size_t kHeader = (sizeof(Slab) + alignof(Node) - 1) / alignof(Node) * alignof(Node);
+    static constexpr std::size_t kFirstSlab = 16;
+    static constexpr std::size_t kMaxSlab = 4096;
+
+    void* allocate() {
+        if (freeList != nullptr) {
+            FreeNode* node = freeList;
+            freeList = node->next;
+            return node;
+        }
+        if (cursor == limit) {
+            grow();
+        }
+        void* place = cursor;
+        cursor += sizeof(Node);
+        return place;
+    }
+
+    void deallocate(void* place) {
+        FreeNode* node = static_cast<FreeNode*>(place);
+        node->next = freeList;
+        freeList = node;
+    }
+
+    void grow() {
+        std::size_t size = kHeader + nextCapacity * sizeof(Node);
+        Slab* slab = static_cast<Slab*>(::operator new(size, std::align_val_t(kAlign)));
+        slab->next = slabs;
+        slabs = slab;
+        cursor = reinterpret_cast<char*>(slab) + kHeader;
+        limit = cursor + nextCapacity * sizeof(Node);
+        bytes += size;
+        if (nextCapacity < kMaxSlab) {
+            nextCapacity *= 2;
+        }
+    }
+
+    Slab* slabs;
+    char* cursor;
+    char* limit;
+    FreeNode* freeList;
+    std::size_t nextCapacity;
+    std::size_t bytes;
+};
+}
+
+#endif
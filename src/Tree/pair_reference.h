@@ -0,0 +1,33 @@
+#ifndef __PAIR_REFERENCE_H__
+#define __PAIR_REFERENCE_H__
+
+#include <type_traits>
+#include <utility>
+
+namespace s21 {
+// What the iterators of maps keeping keys and values in separate arrays
+// hand out instead of a std::pair<const Key, T>&: references to the key
+// and the value of one element, so it->second = v writes into the map.
+// Const iterators use a const T.
+template <typename Key, typename T>
+struct PairReference {
+    const Key& first;
+    T& second;
+
+    operator std::pair<const Key, std::remove_const_t<T>>() const {
+        return {first, second};
+    }
+};
+
+// What operator-> of those iterators returns, it holds the references
+template <typename Key, typename T>
+struct PairPointer {
+    PairReference<Key, T> element;
+
+    const PairReference<Key, T>* operator->() const {
+        return &element;
+    }
+};
+}
+
+#endif
@@ -0,0 +1,347 @@
+#ifndef __PERSISTENT_TREE_H__
+#define __PERSISTENT_TREE_H__
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <functional>
+#include <utility>
+#include <vector>
+
+#include "sorted_array.h"
+#include "transparent.h"
+
+namespace s21 {
+// Mapped type of the key-only persistent containers
+struct PersistentNoValue {};
+
+// Immutable AVL tree. Nodes never change once built, an update copies the
+// path from the root down to the touched node and links the copies to the
+// untouched subtrees of the old version, so every version shares all but
+// O(log n) nodes with the one it came from. Nodes are reference counted:
+// a version owns one reference to its root, a node one to each child.
+// Counts are atomic, versions that share nodes may be read and released
+// from different threads; a single version object is not synchronized.
+template <typename Key, typename Value, typename Compare = std::less<Key>>
+class PersistentTree {
+public:
+    PersistentTree() : root(nullptr), comp() {}
+
+    // A copy is a snapshot: it takes one more reference to the root
+    PersistentTree(const PersistentTree& other) : root(acquire(other.root)), comp(other.comp) {}
+
+    PersistentTree(PersistentTree&& other) noexcept : root(other.root), comp(other.comp) {
+        other.root = nullptr;
+    }
+
+    PersistentTree& operator=(const PersistentTree& other) {
+        if (this != &other) {
+            const Node* old = root;
+            root = acquire(other.root);
+            comp = other.comp;
+            release(old);
+        }
+        return *this;
+    }
+
+    PersistentTree& operator=(PersistentTree&& other) noexcept {
+        if (this != &other) {
+            release(root);
+            root = other.root;
+            comp = other.comp;
+            other.root = nullptr;
+        }
+        return *this;
+    }
+
+    ~PersistentTree() {
+        release(root);
+    }
+
+protected:
+    // The element is kept as the pair map iterators hand out references
+    // to; sets only read its key
+    struct Node {
+        Node(const Key& k, const Value& v, const Node* l, const Node* r)
+        : data(k, v), left(l), right(r), height(1 + std::max(heightOf(l), heightOf(r))),
+          size(1 + sizeOf(l) + sizeOf(r)), refs(1) {}
+
+        const Key& key() const {
+            return data.first;
+        }
+
+        const Value& value() const {
+            return data.second;
+        }
+
+        const std::pair<const Key, Value> data;
+        const Node* const left;
+        const Node* const right;
+        const int height;
+        const std::size_t size;
+        mutable std::atomic<std::size_t> refs;
+    };
+
+    const Node* root;
+    Compare comp;
+
+    // Takes ownership of the reference held by newRoot
+    explicit PersistentTree(const Node* newRoot, const Compare& compare) : root(newRoot), comp(compare) {}
+
+    static int heightOf(const Node* node) {
+        return node ? node->height : 0;
+    }
+
+    static std::size_t sizeOf(const Node* node) {
+        return node ? node->size : 0;
+    }
+
+    static const Node* acquire(const Node* node) {
+        if (node) {
+            node->refs.fetch_add(1, std::memory_order_relaxed);
+        }
+        return node;
+    }
+
+    // Drops one reference and frees the nodes nobody else holds. Only nodes
+    // private to this version are visited, so the walk is O(freed nodes).
+    static void release(const Node* node) {
+        while (node && node->refs.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+            const Node* left = node->left;
+            const Node* right = node->right;
+            delete node;
+            release(left);
+            node = right;
+        }
+    }
+
+    template <typename K>
+    const Node* findNode(const K& key) const {
+        const Node* node = root;
+        while (node) {
+            if (comp(key, node->key())) {
+                node = node->left;
+            } else if (comp(node->key(), key)) {
+                node = node->right;
+            } else {
+                return node;
+            }
+        }
+        return nullptr;
+    }
+
+    // New root with key mapped to value, replacing the value of an equal
+    // key. The returned reference belongs to the caller.
+    template <typename K>
+    const Node* insertNode(const Node* node, const K& key, const Value& value) const {
+        if (!node) {
+            return new Node(Key(key), value, nullptr, nullptr);
+        }
+        if (comp(key, node->key())) {
+            return balance(node->key(), node->value(), insertNode(node->left, key, value), acquire(node->right));
+        }
+        if (comp(node->key(), key)) {
+            return balance(node->key(), node->value(), acquire(node->left), insertNode(node->right, key, value));
+        }
+        return new Node(node->key(), value, acquire(node->left), acquire(node->right));
+    }
+
+    // New root without key, which must be present
+    template <typename K>
+    const Node* eraseNode(const Node* node, const K& key) const {
+        if (comp(key, node->key())) {
+            return balance(node->key(), node->value(), eraseNode(node->left, key), acquire(node->right));
+        }
+        if (comp(node->key(), key)) {
+            return balance(node->key(), node->value(), acquire(node->left), eraseNode(node->right, key));
+        }
+        if (!node->left) {
+            return acquire(node->right);
+        }
+        if (!node->right) {
+            return acquire(node->left);
+        }
+        const Node* successor = node->right;
+        while (successor->left) {
+            successor = successor->left;
+        }
+        return balance(successor->key(), successor->value(), acquire(node->left), eraseMin(node->right));
+    }
+
+    static const Node* eraseMin(const Node* node) {
+        if (!node->left) {
+            return acquire(node->right);
+        }
+        return balance(node->key(), node->value(), eraseMin(node->left), acquire(node->right));
+    }
+
+    // Builds a node over owned children that differ in height by at most
+    // two and rotates it back into AVL shape. Shared nodes cannot be
+    // relinked, a rotation copies the child it lifts instead.
+    static const Node* balance(const Key& key, const Value& value, const Node* left, const Node* right) {
+        if (heightOf(left) > heightOf(right) + 1) {
+            const Node* result;
+            if (heightOf(left->left) >= heightOf(left->right)) {
+                result = new Node(left->key(), left->value(), acquire(left->left),
+                                  new Node(key, value, acquire(left->right), right));
+            } else {
+                const Node* middle = left->right;
+                result = new Node(middle->key(), middle->value(),
+                                  new Node(left->key(), left->value(), acquire(left->left), acquire(middle->left)),
+                                  new Node(key, value, acquire(middle->right), right));
+            }
+            release(left);
+            return result;
+        }
+        if (heightOf(right) > heightOf(left) + 1) {
+            const Node* result;
+            if (heightOf(right->right) >= heightOf(right->left)) {
+                result = new Node(right->key(), right->value(), new Node(key, value, left, acquire(right->left)),
+                                  acquire(right->right));
+            } else {
+                const Node* middle = right->left;
+                result = new Node(middle->key(), middle->value(), new Node(key, value, left, acquire(middle->left)),
+                                  new Node(right->key(), right->value(), acquire(middle->right), acquire(right->right)));
+            }
+            release(right);
+            return result;
+        }
+        return new Node(key, value, left, right);
+    }
+
+    // Perfectly balanced tree over items[first, last), sorted and unique
+    template <typename Item, typename KeyOf, typename ValueOf>
+    static const Node* buildSorted(const Item* items, std::size_t first, std::size_t last, KeyOf keyOf,
+                                   ValueOf valueOf) {
+        if (first == last) {
+            return nullptr;
+        }
+        std::size_t middle = first + (last - first) / 2;
+        const Node* left = buildSorted(items, first, middle, keyOf, valueOf);
+        const Node* right = buildSorted(items, middle + 1, last, keyOf, valueOf);
+        return new Node(keyOf(items[middle]), valueOf(items[middle]), left, right);
+    }
+
+    template <typename Item, typename KeyOf, typename ValueOf>
+    void assignItems(std::vector<Item>& items, KeyOf keyOf, ValueOf valueOf) {
+        std::size_t count = sortUnique(items.data(), items.size(), keyOf, comp);
+        const Node* old = root;
+        root = buildSorted(items.data(), 0, count, keyOf, valueOf);
+        release(old);
+    }
+
+    // Nodes have no parent links, shared subtrees have many parents.
+    // Iterators keep the path from the root instead, end() is an empty path.
+    // No AVL tree of fewer than 2^64 nodes is taller than kMaxPath levels,
+    // so the path is a fixed array and a copy only takes its used part.
+    static constexpr std::size_t kMaxPath = 92;
+
+    class Path {
+    public:
+        Path() : depth(0) {}
+
+        Path(const Path& other) : depth(other.depth) {
+            std::copy(other.nodes, other.nodes + depth, nodes);
+        }
+
+        Path& operator=(const Path& other) {
+            depth = other.depth;
+            std::copy(other.nodes, other.nodes + depth, nodes);
+            return *this;
+        }
+
+        bool empty() const {
+            return depth == 0;
+        }
+
+        const Node* back() const {
+            return nodes[depth - 1];
+        }
+
+        void push_back(const Node* node) {
+            nodes[depth++] = node;
+        }
+
+        void pop_back() {
+            --depth;
+        }
+
+        void clear() {
+            depth = 0;
+        }
+
+    private:
+        const Node* nodes[kMaxPath];
+        std::size_t depth;
+    };
+
+    static void descendLeft(Path& path, const Node* node) {
+        for (; node; node = node->left) {
+            path.push_back(node);
+        }
+    }
+
+    static void descendRight(Path& path, const Node* node) {
+        for (; node; node = node->right) {
+            path.push_back(node);
+        }
+    }
+
+    static void stepForward(Path& path) {
+        const Node* node = path.back();
+        if (node->right) {
+            descendLeft(path, node->right);
+            return;
+        }
+        const Node* child;
+        do {
+            child = path.back();
+            path.pop_back();
+        } while (!path.empty() && path.back()->right == child);
+    }
+
+    static void stepBackward(const Node* top, Path& path) {
+        if (path.empty()) {
+            descendRight(path, top);
+            return;
+        }
+        const Node* node = path.back();
+        if (node->left) {
+            descendRight(path, node->left);
+            return;
+        }
+        const Node* child;
+        do {
+            child = path.back();
+            path.pop_back();
+        } while (!path.empty() && path.back()->left == child);
+    }
+
+    Path beginPath() const {
+        Path path;
+        descendLeft(path, root);
+        return path;
+    }
+
+    // Path to key, empty when it is absent
+    template <typename K>
+    Path findPath(const K& key) const {
+        Path path;
+        const Node* node = root;
+        while (node) {
+            path.push_back(node);
+            if (comp(key, node->key())) {
+                node = node->left;
+            } else if (comp(node->key(), key)) {
+                node = node->right;
+            } else {
+                return path;
+            }
+        }
+        path.clear();
+        return path;
+    }
+};
+}
+
+#endif
@@ -0,0 +1,325 @@
+#ifndef __SNAPSHOT_H__
+#define __SNAPSHOT_H__
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <new>
+#include <stdexcept>
+#include <string>
+
+#include "eytzinger.h"
+
+namespace s21 {
+// Binary images of sorted maps and sets, written by save_snapshot() and
+// served by frozen_map and frozen_set. An image holds a header, then the
+// keys as one array in Eytzinger order (see eytzinger.h), then the values
+// as a second array in the same order, each array starting on a page
+// boundary with its unused slot 0. Elements are raw bytes of trivially
+// copyable types, so an image is only readable on the architecture that
+// wrote it; the header records enough to refuse others.
+struct SnapshotHeader {
+    char magic[8];
+    std::uint32_t version;
+    std::uint32_t byteOrder;
+    std::uint64_t count;
+    std::uint32_t keySize;
+    std::uint32_t keyAlign;
+    std::uint32_t valueSize;
+    std::uint32_t valueAlign;
+    std::uint64_t keysOffset;
+    std::uint64_t valuesOffset;
+    std::uint64_t fileSize;
+};
+
+constexpr char kSnapshotMagic[8] = {'S', '2', '1', 'S', 'N', 'A', 'P', '\0'};
+constexpr std::uint32_t kSnapshotVersion = 2;
+constexpr std::uint32_t kSnapshotByteOrder = 0x01020304;
+constexpr std::uint64_t kSnapshotPage = 4096;
+
+// Element layout of an image, sets have no values and a valueSize of 0
+template <typename Key, typename Value>
+struct SnapshotType {
+    static constexpr std::uint32_t keySize = sizeof(Key);
+    static constexpr std::uint32_t keyAlign = alignof(Key);
+    static constexpr std::uint32_t valueSize = sizeof(Value);
+    static constexpr std::uint32_t valueAlign = alignof(Value);
+};
+
+template <typename Key>
+struct SnapshotType<Key, void> {
+    static constexpr std::uint32_t keySize = sizeof(Key);
+    static constexpr std::uint32_t keyAlign = alignof(Key);
+    static constexpr std::uint32_t valueSize = 0;
+    static constexpr std::uint32_t valueAlign = 1;
+};
+
+inline std::uint64_t snapshotPageAlign(std::uint64_t offset) {
+    return (offset + kSnapshotPage - 1) / kSnapshotPage * kSnapshotPage;
+}
+
+template <typename Type>
+SnapshotHeader snapshotLayout(std::uint64_t count) {
+    SnapshotHeader header;
+    std::memset(&header, 0, sizeof(header));
+    std::memcpy(header.magic, kSnapshotMagic, sizeof(header.magic));
+    header.version = kSnapshotVersion;
+    header.byteOrder = kSnapshotByteOrder;
+    header.count = count;
+    header.keySize = Type::keySize;
+    header.keyAlign = Type::keyAlign;
+    header.valueSize = Type::valueSize;
+    header.valueAlign = Type::valueAlign;
+    header.keysOffset = snapshotPageAlign(sizeof(SnapshotHeader));
+    header.valuesOffset = snapshotPageAlign(header.keysOffset + (count + 1) * Type::keySize);
+    header.fileSize = header.valuesOffset + (count + 1) * Type::valueSize;
+    return header;
+}
+
+inline std::runtime_error snapshotError(const char* what, const std::string& path) {
+    return std::runtime_error(std::string(what) + " " + path + ": " + std::strerror(errno));
+}
+
+// Fills the arrays of an image from elements appended in key order, each
+// going to its Eytzinger slot
+class SnapshotFiller {
+public:
+    SnapshotFiller() : bytes(nullptr), header(), slot(0) {}
+
+    template <typename Key>
+    void append(const Key& key) {
+        std::memcpy(bytes + header.keysOffset + slot * sizeof(Key), &key, sizeof(Key));
+        slot = eytzingerNext(slot, header.count);
+    }
+
+    template <typename Key, typename Value>
+    void append(const Key& key, const Value& value) {
+        std::memcpy(bytes + header.valuesOffset + slot * sizeof(Value), &value, sizeof(Value));
+        append(key);
+    }
+
+protected:
+    char* bytes;
+    SnapshotHeader header;
+    std::uint64_t slot;
+
+    void start(char* image, const SnapshotHeader& layout) {
+        bytes = image;
+        header = layout;
+        slot = eytzingerFirst(layout.count);
+        std::memcpy(bytes, &header, sizeof(header));
+    }
+};
+
+// Writes an image through a shared mapping of a temporary file next to
+// path. commit() renames it over path, so readers never see a partial
+// image; a writer destroyed before commit() removes its file.
+class SnapshotWriter : public SnapshotFiller {
+public:
+    SnapshotWriter(const std::string& path, const SnapshotHeader& layout)
+    : target(path), temporary(path + ".tmp"), fd(-1), length(layout.fileSize) {
+        fd = ::open(temporary.c_str(), O_RDWR | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+        if (fd < 0) {
+            throw snapshotError("Cannot create snapshot", temporary);
+        }
+        if (::ftruncate(fd, static_cast<off_t>(length)) != 0) {
+            std::runtime_error error = snapshotError("Cannot size snapshot", temporary);
+            discard();
+            throw error;
+        }
+        void* mapped = ::mmap(nullptr, length, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        if (mapped == MAP_FAILED) {
+            std::runtime_error error = snapshotError("Cannot map snapshot", temporary);
+            discard();
+            throw error;
+        }
+        start(static_cast<char*>(mapped), layout);
+    }
+
+    SnapshotWriter(const SnapshotWriter&) = delete;
+    SnapshotWriter& operator=(const SnapshotWriter&) = delete;
+
+    ~SnapshotWriter() {
+        discard();
+    }
+
+    void commit() {
+        int failed = ::munmap(bytes, length);
+        bytes = nullptr;
+        if (failed != 0 || ::fsync(fd) != 0) {
+            std::runtime_error error = snapshotError("Cannot write snapshot", temporary);
+            discard();
+            throw error;
+        }
+        ::close(fd);
+        fd = -1;
+        if (std::rename(temporary.c_str(), target.c_str()) != 0) {
+            std::runtime_error error = snapshotError("Cannot replace snapshot", target);
+            discard();
+            throw error;
+        }
+        temporary.clear();
+    }
+
+private:
+    std::string target;
+    std::string temporary;
+    int fd;
+    std::uint64_t length;
+
+    void discard() {
+        if (bytes != nullptr) {
+            ::munmap(bytes, length);
+            bytes = nullptr;
+        }
+        if (fd >= 0) {
+            ::close(fd);
+            fd = -1;
+        }
+        if (!temporary.empty()) {
+            ::unlink(temporary.c_str());
+            temporary.clear();
+        }
+    }
+};
+
+// Read-only image, either a mapping of a whole file or built in memory.
+// Opening a file reads nothing but the header: pages of the arrays fault
+// in as lookups touch them and stay shared with every other process
+// mapping the same file.
+class SnapshotMapping {
+public:
+    SnapshotMapping() : bytes(nullptr), length(0) {}
+
+    template <typename Type>
+    static SnapshotMapping open(const std::string& path) {
+        SnapshotMapping mapping;
+        mapping.map(path);
+        const SnapshotHeader& header = mapping.header();
+        if (header.keySize != Type::keySize || header.keyAlign != Type::keyAlign ||
+            header.valueSize != Type::valueSize || header.valueAlign != Type::valueAlign) {
+            throw std::runtime_error("Snapshot element types differ: " + path);
+        }
+        return mapping;
+    }
+
+    // Image of count elements in anonymous memory, made read-only once
+    // fill(SnapshotFiller&) has appended all of them in key order
+    template <typename Type, typename Fill>
+    static SnapshotMapping build(std::uint64_t count, Fill fill) {
+        SnapshotHeader layout = snapshotLayout<Type>(count);
+        void* mapped = ::mmap(nullptr, layout.fileSize, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (mapped == MAP_FAILED) {
+            throw std::bad_alloc();
+        }
+        SnapshotMapping mapping;
+        mapping.bytes = static_cast<const char*>(mapped);
+        mapping.length = layout.fileSize;
+        struct Filler : SnapshotFiller {
+            Filler(char* image, const SnapshotHeader& header) {
+                start(image, header);
+            }
+        } filler(static_cast<char*>(mapped), layout);
+        fill(static_cast<SnapshotFiller&>(filler));
+        ::mprotect(mapped, layout.fileSize, PROT_READ);
+        return mapping;
+    }
+
+    SnapshotMapping(SnapshotMapping&& other) noexcept : bytes(other.bytes), length(other.length) {
+        other.bytes = nullptr;
+        other.length = 0;
+    }
+
+    SnapshotMapping& operator=(SnapshotMapping&& other) noexcept {
+        if (this != &other) {
+            unmap();
+            bytes = other.bytes;
+            length = other.length;
+            other.bytes = nullptr;
+            other.length = 0;
+        }
+        return *this;
+    }
+
+    SnapshotMapping(const SnapshotMapping&) = delete;
+    SnapshotMapping& operator=(const SnapshotMapping&) = delete;
+
+    ~SnapshotMapping() {
+        unmap();
+    }
+
+    const SnapshotHeader& header() const {
+        return *reinterpret_cast<const SnapshotHeader*>(bytes);
+    }
+
+    std::uint64_t count() const {
+        return bytes == nullptr ? 0 : header().count;
+    }
+
+    // Slot arrays, index 0 is unused
+    template <typename Key>
+    const Key* keys() const {
+        return bytes == nullptr ? nullptr : reinterpret_cast<const Key*>(bytes + header().keysOffset);
+    }
+
+    template <typename Value>
+    const Value* values() const {
+        return bytes == nullptr ? nullptr : reinterpret_cast<const Value*>(bytes + header().valuesOffset);
+    }
+
+private:
+    const char* bytes;
+    std::uint64_t length;
+
+    void map(const std::string& path) {
+        int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+        if (fd < 0) {
+            throw snapshotError("Cannot open snapshot", path);
+        }
+        struct stat info;
+        if (::fstat(fd, &info) != 0) {
+            std::runtime_error error = snapshotError("Cannot read snapshot", path);
+            ::close(fd);
+            throw error;
+        }
+        length = static_cast<std::uint64_t>(info.st_size);
+        if (length < sizeof(SnapshotHeader)) {
+            ::close(fd);
+            throw std::runtime_error("Not a snapshot: " + path);
+        }
+        void* mapped = ::mmap(nullptr, length, PROT_READ, MAP_SHARED, fd, 0);
+        ::close(fd);
+        if (mapped == MAP_FAILED) {
+            throw snapshotError("Cannot map snapshot", path);
+        }
+        bytes = static_cast<const char*>(mapped);
+        const SnapshotHeader& header = this->header();
+        if (std::memcmp(header.magic, kSnapshotMagic, sizeof(header.magic)) != 0 ||
+            header.version != kSnapshotVersion || header.byteOrder != kSnapshotByteOrder) {
+            throw std::runtime_error("Not a snapshot of this format: " + path);
+        }
+        if (header.fileSize != length || header.count >= length || header.keysOffset % kSnapshotPage != 0 ||
+            header.valuesOffset % kSnapshotPage != 0 ||
+            header.keysOffset + (header.count + 1) * header.keySize > header.valuesOffset ||
+            header.valuesOffset + (header.count + 1) * header.valueSize > length) {
+            throw std::runtime_error("Truncated or damaged snapshot: " + path);
+        }
+    }
+
+    void unmap() {
+        if (bytes != nullptr) {
+            ::munmap(const_cast<char*>(bytes), length);
+            bytes = nullptr;
+            length = 0;
+        }
+    }
+};
+}
+
+#endif
@@ -0,0 +1,73 @@
+#ifndef __SORTED_ARRAY_H__
+#define __SORTED_ARRAY_H__
+
+#include <algorithm>
+#include <cstddef>
+#include <utility>
+
+namespace s21 {
+// Binary searches over a sorted array without data dependent branches:
+// every step halves the window with a conditional move, so the loop runs
+// log2(n) times whatever the key and never mispredicts.
+template <typename Key, typename K, typename Compare>
+std::size_t lowerBoundIndex(const Key* keys, std::size_t count, const K& key, const Compare& comp) {
+    if (count == 0) {
+        return 0;
+    }
+    const Key* base = keys;
+    while (count > 1) {
+        std::size_t half = count / 2;
+        base = comp(base[half], key) ? base + half : base;
+        count -= half;
+    }
+    return static_cast<std::size_t>(base - keys) + (comp(*base, key) ? 1 : 0);
+}
+
+template <typename Key, typename K, typename Compare>
+std::size_t upperBoundIndex(const Key* keys, std::size_t count, const K& key, const Compare& comp) {
+    if (count == 0) {
+        return 0;
+    }
+    const Key* base = keys;
+    while (count > 1) {
+        std::size_t half = count / 2;
+        base = comp(key, base[half]) ? base : base + half;
+        count -= half;
+    }
+    return static_cast<std::size_t>(base - keys) + (comp(key, *base) ? 0 : 1);
+}
+
+template <typename Key, typename Compare>
+bool isStrictlySorted(const Key* keys, std::size_t count, const Compare& comp) {
+    for (std::size_t i = 1; i < count; ++i) {
+        if (!comp(keys[i - 1], keys[i])) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Sorts items by keyOf(item) and moves the first item of every run of equal
+// keys to the front. Returns the number of items kept.
+template <typename Item, typename KeyOf, typename Compare>
+std::size_t sortUnique(Item* items, std::size_t count, KeyOf keyOf, const Compare& comp) {
+    if (count == 0) {
+        return 0;
+    }
+    std::stable_sort(items, items + count, [&](const Item& a, const Item& b) {
+        return comp(keyOf(a), keyOf(b));
+    });
+    std::size_t kept = 1;
+    for (std::size_t i = 1; i < count; ++i) {
+        if (comp(keyOf(items[kept - 1]), keyOf(items[i]))) {
+            if (kept != i) {
+                items[kept] = std::move(items[i]);
+            }
+            ++kept;
+        }
+    }
+    return kept;
+}
+}
+
+#endif
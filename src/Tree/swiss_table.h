@@ -0,0 +1,432 @@
+#ifndef __SWISS_TABLE_H__
+#define __SWISS_TABLE_H__
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <new>
+#include <utility>
+
+#if defined(__SSE2__)
+#include <immintrin.h>
+#endif
+
+namespace s21 {
+// Control byte of a slot: empty, deleted, the end sentinel or, when the
+// slot is full, the low 7 bits of the hash of its key
+using CtrlByte = signed char;
+
+constexpr CtrlByte kCtrlEmpty = -128;
+constexpr CtrlByte kCtrlDeleted = -2;
+constexpr CtrlByte kCtrlSentinel = -1;
+
+// A group is the window of control bytes probed at once. Each match
+// returns a bitmask with bit i set when byte i of the window qualifies.
+#if defined(__AVX2__)
+struct SwissGroup {
+    static constexpr std::size_t kWidth = 32;
+
+    explicit SwissGroup(const CtrlByte* pos) : bytes(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(pos))) {}
+
+    std::uint32_t match(CtrlByte h2) const {
+        return static_cast<std::uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(_mm256_set1_epi8(h2), bytes)));
+    }
+
+    std::uint32_t matchEmpty() const {
+        return match(kCtrlEmpty);
+    }
+
+    std::uint32_t matchEmptyOrDeleted() const {
+        return static_cast<std::uint32_t>(_mm256_movemask_epi8(_mm256_cmpgt_epi8(_mm256_set1_epi8(kCtrlSentinel), bytes)));
+    }
+
+    __m256i bytes;
+};
+#elif defined(__SSE2__)
+struct SwissGroup {
+    static constexpr std::size_t kWidth = 16;
+
+    explicit SwissGroup(const CtrlByte* pos) : bytes(_mm_loadu_si128(reinterpret_cast<const __m128i*>(pos))) {}
+
+    std::uint32_t match(CtrlByte h2) const {
+        return static_cast<std::uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_set1_epi8(h2), bytes)));
+    }
+
+    std::uint32_t matchEmpty() const {
+        return match(kCtrlEmpty);
+    }
+
+    std::uint32_t matchEmptyOrDeleted() const {
+        return static_cast<std::uint32_t>(_mm_movemask_epi8(_mm_cmpgt_epi8(_mm_set1_epi8(kCtrlSentinel), bytes)));
+    }
+
+    __m128i bytes;
+};
+#else
+struct SwissGroup {
+    static constexpr std::size_t kWidth = 16;
+
+    explicit SwissGroup(const CtrlByte* pos) {
+        std::memcpy(bytes, pos, kWidth);
+    }
+
+    std::uint32_t match(CtrlByte h2) const {
+        std::uint32_t mask = 0;
+        for (std::size_t i = 0; i < kWidth; ++i) {
+            mask |= static_cast<std::uint32_t>(bytes[i] == h2) << i;
+        }
+        return mask;
+    }
+
+    std::uint32_t matchEmpty() const {
+        return match(kCtrlEmpty);
+    }
+
+    std::uint32_t matchEmptyOrDeleted() const {
+        std::uint32_t mask = 0;
+        for (std::size_t i = 0; i < kWidth; ++i) {
+            mask |= static_cast<std::uint32_t>(bytes[i] < kCtrlSentinel) << i;
+        }
+        return mask;
+    }
+
+    CtrlByte bytes[kWidth];
+};
+#endif
+
+// Control bytes of a table without slots: the sentinel, then empties so
+// that a probe of the first group finds nothing and stops
+struct SwissEmptyGroup {
+    alignas(16) CtrlByte bytes[SwissGroup::kWidth];
+};
+
+constexpr SwissEmptyGroup makeSwissEmptyGroup() {
+    SwissEmptyGroup group{};
+    group.bytes[0] = kCtrlSentinel;
+    for (std::size_t i = 1; i < SwissGroup::kWidth; ++i) {
+        group.bytes[i] = kCtrlEmpty;
+    }
+    return group;
+}
+
+inline constexpr SwissEmptyGroup kSwissEmptyGroup = makeSwissEmptyGroup();
+
+// Key extractors for the slots of maps (pairs) and sets (bare keys)
+struct SwissPairKey {
+    template <typename Pair>
+    const auto& operator()(const Pair& slot) const {
+        return slot.first;
+    }
+};
+
+struct SwissSelfKey {
+    template <typename Key>
+    const Key& operator()(const Key& slot) const {
+        return slot;
+    }
+};
+
+// Open addressing hash table in the style of Swiss tables. Slots sit in one
+// flat array next to an array of control bytes; a lookup hashes once, then
+// compares 7 bits of the hash against a whole group of control bytes with
+// one SIMD instruction and only touches slots whose byte matched. Capacity
+// is 2^k - 1 so that the sentinel and a clone of the first group fit after
+// the last control byte, letting a group load start at any slot.
+template <typename Slot, typename Key, typename KeyOf, typename Hash, typename KeyEqual>
+class SwissTable {
+public:
+    SwissTable()
+    : ctrl(emptyCtrl()), slots(nullptr), capacity(0), elements(0), growthLeft(0), hashFunction(), keyEqual() {}
+
+    SwissTable(const SwissTable& other) : SwissTable() {
+        copyFrom(other);
+    }
+
+    SwissTable(SwissTable&& other) noexcept : SwissTable() {
+        swapTable(other);
+    }
+
+    SwissTable& operator=(const SwissTable& other) {
+        if (this != &other) {
+            destroyTable();
+            copyFrom(other);
+        }
+        return *this;
+    }
+
+    SwissTable& operator=(SwissTable&& other) noexcept {
+        if (this != &other) {
+            destroyTable();
+            swapTable(other);
+        }
+        return *this;
+    }
+
+    ~SwissTable() {
+        destroyTable();
+    }
+
+protected:
+    static constexpr std::size_t kWidth = SwissGroup::kWidth;
+    static constexpr std::size_t kClonedBytes = kWidth - 1;
+
+    CtrlByte* ctrl;
+    Slot* slots;
+    std::size_t capacity;
+    std::size_t elements;
+    std::size_t growthLeft;
+    Hash hashFunction;
+    KeyEqual keyEqual;
+
+    static CtrlByte* emptyCtrl() {
+        return const_cast<CtrlByte*>(kSwissEmptyGroup.bytes);
+    }
+
+    // Tables are kept at most 7/8 full
+    static std::size_t maxLoad(std::size_t cap) {
+        return cap - cap / 8;
+    }
+
+    // std::hash of integers is the identity, the finalizer of MurmurHash3
+    // spreads every input bit over the probe start and the 7 stored bits
+    static std::size_t mix(std::size_t hash) {
+        std::uint64_t x = hash;
+        x ^= x >> 33;
+        x *= 0xff51afd7ed558ccdULL;
+        x ^= x >> 33;
+        x *= 0xc4ceb9fe1a85ec53ULL;
+        x ^= x >> 33;
+        return static_cast<std::size_t>(x);
+    }
+
+    static CtrlByte h2Of(std::size_t hash) {
+        return static_cast<CtrlByte>(hash & 0x7F);
+    }
+
+    template <typename K>
+    std::size_t hashOf(const K& key) const {
+        return mix(hashFunction(key));
+    }
+
+    static bool isFull(CtrlByte byte) {
+        return byte >= 0;
+    }
+
+    // Moves ctrl and slot forward to the next full slot or the sentinel
+    static void skipFree(CtrlByte*& byte, Slot*& slot) {
+        while (*byte < kCtrlSentinel) {
+            ++byte;
+            ++slot;
+        }
+    }
+
+    // Index of the slot holding key, capacity when there is none
+    template <typename K>
+    std::size_t findIndex(const K& key, std::size_t hash) const {
+        std::size_t pos = (hash >> 7) & capacity;
+        std::size_t stride = 0;
+        while (true) {
+            SwissGroup group(ctrl + pos);
+            for (std::uint32_t mask = group.match(h2Of(hash)); mask != 0; mask &= mask - 1) {
+                std::size_t index = (pos + __builtin_ctz(mask)) & capacity;
+                if (keyEqual(KeyOf()(slots[index]), key)) {
+                    return index;
+                }
+            }
+            if (group.matchEmpty() != 0) {
+                return capacity;
+            }
+            stride += kWidth;
+            pos = (pos + stride) & capacity;
+        }
+    }
+
+    template <typename K>
+    std::size_t findIndex(const K& key) const {
+        return findIndex(key, hashOf(key));
+    }
+
+    // First empty or deleted slot on the probe sequence of hash
+    std::size_t findInsertSlot(std::size_t hash) const {
+        std::size_t pos = (hash >> 7) & capacity;
+        std::size_t stride = 0;
+        while (true) {
+            std::uint32_t mask = SwissGroup(ctrl + pos).matchEmptyOrDeleted();
+            if (mask != 0) {
+                return (pos + __builtin_ctz(mask)) & capacity;
+            }
+            stride += kWidth;
+            pos = (pos + stride) & capacity;
+        }
+    }
+
+    // The first kClonedBytes control bytes are mirrored after the sentinel
+    void setCtrl(std::size_t index, CtrlByte byte) {
+        ctrl[index] = byte;
+        if (index < kClonedBytes) {
+            ctrl[capacity + 1 + index] = byte;
+        }
+    }
+
+    // Returns the index of the slot with key and whether it was created from
+    // args. The slot is constructed only when key is absent.
+    template <typename K, typename... Args>
+    std::pair<std::size_t, bool> emplaceUnique(const K& key, Args&&... args) {
+        std::size_t hash = hashOf(key);
+        std::size_t index = findIndex(key, hash);
+        if (index != capacity) {
+            return {index, false};
+        }
+        index = findInsertSlot(hash);
+        if (growthLeft == 0 && ctrl[index] != kCtrlDeleted) {
+            rehashForInsert();
+            index = findInsertSlot(hash);
+        }
+        new (slots + index) Slot(std::forward<Args>(args)...);
+        if (ctrl[index] == kCtrlEmpty) {
+            --growthLeft;
+        }
+        setCtrl(index, h2Of(hash));
+        ++elements;
+        return {index, true};
+    }
+
+    // A slot goes back to empty when every probe window over it also holds
+    // an empty slot, so no lookup can have passed it. Otherwise it becomes
+    // a tombstone.
+    void eraseAt(std::size_t index) {
+        slots[index].~Slot();
+        --elements;
+        std::size_t before = (index - kWidth) & capacity;
+        std::uint32_t emptyAfter = SwissGroup(ctrl + index).matchEmpty();
+        std::uint32_t emptyBefore = SwissGroup(ctrl + before).matchEmpty();
+        bool wasNeverFull = emptyAfter != 0 && emptyBefore != 0 &&
+                            static_cast<std::size_t>(__builtin_ctz(emptyAfter)) +
+                                    static_cast<std::size_t>(__builtin_clz(emptyBefore) - (32 - kWidth)) <
+                                kWidth;
+        if (wasNeverFull) {
+            setCtrl(index, kCtrlEmpty);
+            ++growthLeft;
+        } else {
+            setCtrl(index, kCtrlDeleted);
+        }
+    }
+
+    // Tables full of tombstones are rebuilt at the same size, others double
+    void rehashForInsert() {
+        if (capacity != 0 && elements < maxLoad(capacity) / 2) {
+            resize(capacity);
+        } else {
+            resize(capacity == 0 ? kClonedBytes : capacity * 2 + 1);
+        }
+    }
+
+    void reserveFor(std::size_t count) {
+        if (count <= elements + growthLeft) {
+            return;
+        }
+        std::size_t cap = capacity == 0 ? kClonedBytes : capacity;
+        while (maxLoad(cap) < count) {
+            cap = cap * 2 + 1;
+        }
+        resize(cap);
+    }
+
+    void resize(std::size_t newCapacity) {
+        CtrlByte* oldCtrl = ctrl;
+        Slot* oldSlots = slots;
+        std::size_t oldCapacity = capacity;
+
+        allocate(newCapacity);
+        for (std::size_t i = 0; i < oldCapacity; ++i) {
+            if (isFull(oldCtrl[i])) {
+                std::size_t hash = hashOf(KeyOf()(oldSlots[i]));
+                std::size_t index = findInsertSlot(hash);
+                new (slots + index) Slot(std::move(oldSlots[i]));
+                oldSlots[i].~Slot();
+                setCtrl(index, h2Of(hash));
+            }
+        }
+        growthLeft -= elements;
+        release(oldCtrl, oldSlots, oldCapacity);
+    }
+
+    // Installs empty arrays of newCapacity slots, elements is left as is
+    void allocate(std::size_t newCapacity) {
+        ctrl = new CtrlByte[newCapacity + 1 + kClonedBytes];
+        std::memset(ctrl, static_cast<unsigned char>(kCtrlEmpty), newCapacity + 1 + kClonedBytes);
+        ctrl[newCapacity] = kCtrlSentinel;
+        slots = std::allocator<Slot>().allocate(newCapacity);
+        capacity = newCapacity;
+        growthLeft = maxLoad(newCapacity);
+    }
+
+    static void release(CtrlByte* oldCtrl, Slot* oldSlots, std::size_t oldCapacity) {
+        if (oldCapacity != 0) {
+            delete[] oldCtrl;
+            std::allocator<Slot>().deallocate(oldSlots, oldCapacity);
+        }
+    }
+
+    void destroySlots() {
+        for (std::size_t i = 0; i < capacity; ++i) {
+            if (isFull(ctrl[i])) {
+                slots[i].~Slot();
+            }
+        }
+    }
+
+    // Destroys the elements but keeps the arrays for reuse
+    void clearTable() {
+        if (capacity == 0) {
+            return;
+        }
+        destroySlots();
+        std::memset(ctrl, static_cast<unsigned char>(kCtrlEmpty), capacity + 1 + kClonedBytes);
+        ctrl[capacity] = kCtrlSentinel;
+        elements = 0;
+        growthLeft = maxLoad(capacity);
+    }
+
+    void destroyTable() {
+        destroySlots();
+        release(ctrl, slots, capacity);
+        ctrl = emptyCtrl();
+        slots = nullptr;
+        capacity = 0;
+        elements = 0;
+        growthLeft = 0;
+    }
+
+    // Same capacity and layout as other, so no key is hashed again
+    void copyFrom(const SwissTable& other) {
+        hashFunction = other.hashFunction;
+        keyEqual = other.keyEqual;
+        if (other.capacity == 0) {
+            return;
+        }
+        allocate(other.capacity);
+        std::memcpy(ctrl, other.ctrl, capacity + 1 + kClonedBytes);
+        for (std::size_t i = 0; i < capacity; ++i) {
+            if (isFull(ctrl[i])) {
+                new (slots + i) Slot(other.slots[i]);
+            }
+        }
+        elements = other.elements;
+        growthLeft = other.growthLeft;
+    }
+
+    void swapTable(SwissTable& other) noexcept {
+        std::swap(ctrl, other.ctrl);
+        std::swap(slots, other.slots);
+        std::swap(capacity, other.capacity);
+        std::swap(elements, other.elements);
+        std::swap(growthLeft, other.growthLeft);
+        std::swap(hashFunction, other.hashFunction);
+        std::swap(keyEqual, other.keyEqual);
+    }
+};
+}
+
+#endif
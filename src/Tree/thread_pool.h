@@ -0,0 +1,139 @@
+#ifndef __THREAD_POOL_H__
+#define __THREAD_POOL_H__
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace s21 {
+// Fork-join pool for the parallel tree algorithms. invoke() runs two
+// functions, one on the calling thread and one queued for the workers.
+// While a caller waits for its queued half it runs other pending tasks,
+// so nested invoke() calls never block the pool.
+class ThreadPool {
+public:
+    // threads counts the calling thread, so threads - 1 workers are started
+    explicit ThreadPool(std::size_t threads = std::thread::hardware_concurrency()) : stop(false) {
+        for (std::size_t i = 1; i < threads; ++i) {
+            workers.emplace_back([this] { work(); });
+        }
+    }
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    ~ThreadPool() {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stop = true;
+        }
+        wake.notify_all();
+        for (std::thread& worker : workers) {
+            worker.join();
+        }
+    }
+
+    std::size_t size() const {
+        return workers.size() + 1;
+    }
+
+    template <typename Left, typename Right>
+    void invoke(Left&& left, Right&& right) {
+        if (workers.empty()) {
+            left();
+            right();
+            return;
+        }
+
+        Task task(std::forward<Right>(right));
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            queue.push_back(&task);
+        }
+        wake.notify_one();
+
+        std::exception_ptr error;
+        try {
+            left();
+        } catch (...) {
+            error = std::current_exception();
+        }
+        while (!task.done.load(std::memory_order_acquire)) {
+            if (!runPending()) {
+                std::this_thread::yield();
+            }
+        }
+        if (error) {
+            std::rethrow_exception(error);
+        }
+        if (task.error) {
+            std::rethrow_exception(task.error);
+        }
+    }
+
+private:
+    struct Task {
+        template <typename F>
+        explicit Task(F&& f) : run(std::forward<F>(f)), done(false) {}
+
+        std::function<void()> run;
+        std::exception_ptr error;
+        std::atomic<bool> done;
+    };
+
+    static void execute(Task* task) {
+        try {
+            task->run();
+        } catch (...) {
+            task->error = std::current_exception();
+        }
+        task->done.store(true, std::memory_order_release);
+    }
+
+    // Helping waiters take the newest task, which is usually their own
+    bool runPending() {
+        Task* task;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (queue.empty()) {
+                return false;
+            }
+            task = queue.back();
+            queue.pop_back();
+        }
+        execute(task);
+        return true;
+    }
+
+    // Workers take the oldest, and therefore largest, task
+    void work() {
+        while (true) {
+            Task* task;
+            {
+                std::unique_lock<std::mutex> lock(mutex);
+                wake.wait(lock, [this] { return stop || !queue.empty(); });
+                if (stop && queue.empty()) {
+                    return;
+                }
+                task = queue.front();
+                queue.pop_front();
+            }
+            execute(task);
+        }
+    }
+
+    std::vector<std::thread> workers;
+    std::deque<Task*> queue;
+    std::mutex mutex;
+    std::condition_variable wake;
+    bool stop;
+};
+}
+
+#endif
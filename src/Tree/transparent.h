@@ -0,0 +1,17 @@
+#ifndef __TRANSPARENT_H__
+#define __TRANSPARENT_H__
+
+#include <type_traits>
+
+namespace s21 {
+// Comparators declaring is_transparent (std::less<> and the like) can order
+// keys against other types, which enables heterogeneous lookup
+template <typename Compare, typename = void>
+struct is_transparent : std::false_type {};
+
+template <typename Compare>
+struct is_transparent<Compare, std::void_t<typename Compare::is_transparent>> : std::true_type {};
+
+}
+
+#endif
@@ -1,154 +1,962 @@
 #ifndef __TREE_H__
 #define __TREE_H__
 
+#include <algorithm>
+#include <functional>
 #include <iostream>
+#include <iterator>
 #include <limits>
+#include <memory>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "aggregate.h"
+#include "node_pool.h"
+#include "thread_pool.h"
+#include "transparent.h"
+#include "tree_stats.h"
 
 namespace s21 {
-    template <typename Key, typename Value>
-class Tree {
+// Mapped type of the key-only trees, their nodes store the key alone
+struct TreeNoValue {};
+
+// What a node holds besides its links: the value_type of the container,
+// a std::pair<const Key, Value> for maps and the key alone for key-only
+// trees, so iterators can hand out references into the node. It lives in
+// an anonymous union so that the header can be a Node without constructing
+// it; Tree::destroyNode() destroys it.
+template <typename Key, typename Value>
+struct TreeNodeData {
+    using Data = std::pair<const Key, Value>;
+
+    union {
+        Data data;
+    };
+
+    TreeNodeData() {}
+
+    TreeNodeData(const Data& pair) : data(pair) {}
+
+    // Builds the key from k and the value from args in place
+    template <typename K, typename... Args>
+    TreeNodeData(std::piecewise_construct_t, K&& k, Args&&... args)
+    : data(std::piecewise_construct, std::forward_as_tuple(std::forward<K>(k)),
+           std::forward_as_tuple(std::forward<Args>(args)...)) {}
+
+    ~TreeNodeData() {}
+
+    const Key& key() const {
+        return data.first;
+    }
+
+    Value& value() {
+        return data.second;
+    }
+
+    void destroyData() {
+        data.~Data();
+    }
+};
+
+template <typename Key>
+struct TreeNodeData<Key, TreeNoValue> {
+    using Data = Key;
+
+    union {
+        Data data;
+    };
+
+    TreeNodeData() {}
+
+    TreeNodeData(const Key& k) : data(k) {}
+
+    TreeNodeData(Key&& k) : data(std::move(k)) {}
+
+    ~TreeNodeData() {}
+
+    const Key& key() const {
+        return data;
+    }
+
+    void destroyData() {
+        data.~Data();
+    }
+};
+
+// Aggregate of the node's subtree under the tree's aggregate policy,
+// nothing at all for TreeNoAggregate
+template <typename Aggregate>
+struct TreeNodeAggregate {
+    typename Aggregate::value_type aggregate;
+};
+
+template <>
+struct TreeNodeAggregate<TreeNoAggregate> {};
+
+// Aggregate is a policy from aggregate.h. With one set every node keeps
+// the aggregate of its subtree, refreshed by updateNode() wherever sizes
+// and heights are, and ranges of keys are summarized in O(log n).
+// Stats is a policy from tree_stats.h, TreeCountStats compiles in the
+// rotation and comparison counters of treeStats().
+    template <typename Key, typename Value, typename Compare = std::less<Key>, typename Aggregate = TreeNoAggregate,
+              typename Stats = TreeNoStats>
+class Tree : protected TreeCounters<Stats> {
 protected:
-    struct Node {
-        Key key;
-        Value value;
+    // Height and subtree size share one word: AVL heights stay far below
+    // 255 and sizes below 2^56, so a node costs three links and one word on
+    // top of its data.
+    struct Node : TreeNodeData<Key, Value>, TreeNodeAggregate<Aggregate> {
         Node* parent;
         Node* left;
         Node* right;
-        int height;
+        std::size_t size : 56;
+        std::size_t height : 8;
 
-        Node(const std::pair<const Key, Value>& pair)
-        : key(pair.first), value(pair.second), parent(nullptr), left(nullptr), right(nullptr), height(0) {}
+        // Header sentinel, the only node with kHeaderHeight
+        Node() : parent(nullptr), left(nullptr), right(nullptr), size(0), height(kHeaderHeight) {}
 
-        Node(const Key& key_value)
-        : key(key_value), value(key_value), parent(nullptr), left(nullptr), right(nullptr), height(0) {}
+        template <typename... Args>
+        Node(Args&&... args)
+        : TreeNodeData<Key, Value>(std::forward<Args>(args)...), parent(nullptr), left(nullptr), right(nullptr),
+          size(1), height(0) {}
     };
+    static constexpr std::size_t kHeaderHeight = 255;
+    static constexpr bool kAggregated = !std::is_same_v<Aggregate, TreeNoAggregate>;
+    using TreeCounters<Stats>::kCounted;
+    // Pools of other trees whose slabs hold nodes of this tree, see pool.
+    // Lists are never changed once shared, a tree that retains one more
+    // pool builds a new list.
+    using PoolList = std::vector<std::shared_ptr<NodePool<Node>>>;
+
+public:
+    // Owns an element taken out of a tree with extract(). The handle keeps
+    // the pools of that tree alive, so insert() links the node into any
+    // tree as it is, no node is allocated or copied. A handle dropped with
+    // its node gives the node back to the pool it came from, which counts
+    // as a change to that tree. key() and mapped() are for maps, value()
+    // for sets.
+    class NodeHandle {
+    public:
+        NodeHandle() : node(nullptr) {}
+
+        NodeHandle(NodeHandle&& other) noexcept
+        : node(other.node), pool(std::move(other.pool)), retained(std::move(other.retained)) {
+            other.node = nullptr;
+        }
+
+        NodeHandle& operator=(NodeHandle&& other) noexcept {
+            if (this != &other) {
+                reset();
+                node = other.node;
+                pool = std::move(other.pool);
+                retained = std::move(other.retained);
+                other.node = nullptr;
+            }
+            return *this;
+        }
+
+        ~NodeHandle() {
+            reset();
+        }
+
+        bool empty() const {
+            return node == nullptr;
+        }
+
+        explicit operator bool() const {
+            return node != nullptr;
+        }
+
+        // Read-only: the node stores a const key, so it cannot be changed
+        // in place
+        const Key& key() const {
+            return node->key();
+        }
+
+        Value& mapped() const {
+            return node->value();
+        }
+
+        typename TreeNodeData<Key, Value>::Data& value() const {
+            return node->data;
+        }
+
+        void swap(NodeHandle& other) noexcept {
+            std::swap(node, other.node);
+            std::swap(pool, other.pool);
+            std::swap(retained, other.retained);
+        }
+
+    private:
+        friend class Tree;
+
+        NodeHandle(Node* n, const std::shared_ptr<NodePool<Node>>& p, const std::shared_ptr<const PoolList>& r)
+        : node(n), pool(p), retained(r) {}
+
+        // Gives up the node, which now belongs to a tree
+        Node* release() {
+            Node* n = node;
+            node = nullptr;
+            pool.reset();
+            retained.reset();
+            return n;
+        }
+
+        void reset() {
+            if (node != nullptr) {
+                node->destroyData();
+                pool->destroy(node);
+                node = nullptr;
+            }
+            pool.reset();
+            retained.reset();
+        }
+
+        Node* node;
+        std::shared_ptr<NodePool<Node>> pool;
+        std::shared_ptr<const PoolList> retained;
+    };
+
+protected:
+
     Node* root;
+    // end() of the tree. The root hangs below it, header.parent caches the
+    // leftmost node and header.right the rightmost one. An empty tree points
+    // both at the header itself.
+    Node header;
+    // Created on the first insert, so an empty tree does not allocate. Only
+    // this tree allocates from its pool and frees into it, so different
+    // trees can be modified from different threads. Nodes move between
+    // trees by relinking: the receiving tree adds the pools of the giving
+    // one to retained, which keeps their slabs alive, and frees the node
+    // into its own pool when it is erased. Memory a tree hands over this
+    // way goes back to the system when the last tree retaining its pool
+    // is cleared or destroyed.
+    std::shared_ptr<NodePool<Node>> pool;
+    std::shared_ptr<const PoolList> retained;
+    // Every ordering decision goes through comp. Lookups are templates on
+    // the probe type, containers only expose them for types other than Key
+    // when Compare is transparent. Under TreeCountStats it counts its calls.
+    typename TreeCompare<Compare, Stats>::type comp;
 
 public:
-    Tree() : root(nullptr) {}
+    Tree() : root(nullptr) {
+        syncHeader();
+    }
 
-    Tree(const Tree &other) : root(nullptr) {
+    // The copy counts from zero, see TreeCounters
+    Tree(const Tree &other) : TreeCounters<Stats>(), root(nullptr) {
         root = copyTree(other.root);
+        syncHeader();
     }
 
-    Tree(Tree &&other) noexcept {
-        this -> root = other.root;
-        other.root = nullptr;
+    Tree(Tree &&other) noexcept : root(nullptr) {
+        takeTree(other);
     }
 
     ~Tree() {
-        deleteTree(root);
+        clearTree();
+    }
+
+    // Header maintenance
+    static bool isHeader(const Node* node) {
+        return node->height == kHeaderHeight;
+    }
+
+    // Const so that const containers can hand out const iterators, which
+    // hold the same node pointers
+    Node* endNode() const {
+        return const_cast<Node*>(&header);
+    }
+
+    Node* firstNode() const {
+        return header.parent;
+    }
+
+    Node* lastNode() {
+        return header.right;
+    }
+
+    Node* nodeOrEnd(Node* node) {
+        return node == nullptr ? &header : node;
+    }
+
+    // Recomputes the header links after the root was replaced wholesale
+    void syncHeader() {
+        if (root == nullptr) {
+            header.parent = &header;
+            header.right = &header;
+            return;
+        }
+        root->parent = &header;
+        header.parent = getMin(root);
+        header.right = getMax(root);
+    }
+
+    // Takes the nodes of other in O(1), this tree must be empty
+    void takeTree(Tree& other) {
+        root = other.root;
+        pool = std::move(other.pool);
+        retained = std::move(other.retained);
+        if (root != nullptr) {
+            root->parent = &header;
+            header.parent = other.header.parent;
+            header.right = other.header.right;
+        }
+        other.root = nullptr;
+        other.syncHeader();
+        if (root == nullptr) {
+            syncHeader();
+        }
+    }
+
+    // Exchanges the nodes, pools and comparators of both trees in O(1)
+    void swapTree(Tree& other) {
+        std::swap(root, other.root);
+        std::swap(header.parent, other.header.parent);
+        std::swap(header.right, other.header.right);
+        std::swap(pool, other.pool);
+        std::swap(retained, other.retained);
+        std::swap(comp, other.comp);
+        relinkHeader();
+        other.relinkHeader();
+    }
+
+    // Points the root at the header after the roots were exchanged, the
+    // cached edges moved along with them
+    void relinkHeader() {
+        if (root == nullptr) {
+            syncHeader();
+        } else {
+            root->parent = &header;
+        }
+    }
+
+    // In-order neighbours. The step past the last node lands on the header
+    // and stepping back from the header gives the last node.
+    static Node* nextNode(Node* node) {
+        if (node->right) {
+            node = node->right;
+            while (node->left) {
+                node = node->left;
+            }
+            return node;
+        }
+        Node* parent = node->parent;
+        while (!isHeader(parent) && node == parent->right) {
+            node = parent;
+            parent = parent->parent;
+        }
+        return parent;
+    }
+
+    static Node* prevNode(Node* node) {
+        if (isHeader(node)) {
+            return node->right;
+        }
+        if (node->left) {
+            node = node->left;
+            while (node->right) {
+                node = node->right;
+            }
+            return node;
+        }
+        Node* parent = node->parent;
+        while (!isHeader(parent) && node == parent->left) {
+            node = parent;
+            parent = parent->parent;
+        }
+        return parent;
+    }
+
+    // Top-level erase, keeping the header current
+    template <typename K>
+    void eraseKey(const K& key) {
+        if (root == nullptr) {
+            return;
+        }
+        bool edge = !comp(firstNode()->key(), key) || !comp(key, lastNode()->key());
+        root = erase(root, key);
+        if (root) {
+            root->parent = &header;
+        }
+        if (edge) {
+            syncHeader();
+        }
+    }
+
+    // Free child slot where key belongs, found by a descent from the root:
+    // parent and left tell where to link. Equal keys go after the present
+    // ones. With unique set an equal key stops the search, the function
+    // returns false and parent is the node holding it.
+    template <typename K>
+    bool findSlot(const K& key, bool unique, Node*& parent, bool& left) {
+        parent = &header;
+        left = true;
+        Node* node = root;
+        while (node != nullptr) {
+            parent = node;
+            if (comp(key, node->key())) {
+                left = true;
+                node = node->left;
+            } else if (!unique || comp(node->key(), key)) {
+                left = false;
+                node = node->right;
+            } else {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    // Same as findSlot, but tries the gap right before hint and the one
+    // right after it first. Appending with end() or with the position of the
+    // previous insert as hint costs a comparison or two instead of a descent.
+    template <typename K>
+    bool hintSlot(Node* hint, const K& key, bool unique, Node*& parent, bool& left) {
+        Node* prev = hint == firstNode() ? nullptr : prevNode(hint);
+        bool afterPrev = prev == nullptr || (unique ? comp(prev->key(), key) : !comp(key, prev->key()));
+        bool beforeHint = isHeader(hint) || (unique ? comp(key, hint->key()) : !comp(hint->key(), key));
+        if (afterPrev && beforeHint) {
+            if (root == nullptr) {
+                parent = &header;
+                left = true;
+            } else if (!isHeader(hint) && hint->left == nullptr) {
+                parent = hint;
+                left = true;
+            } else {
+                // prev is the rightmost node of hint's left subtree
+                parent = prev;
+                left = false;
+            }
+            return true;
+        }
+        if (unique && prev != nullptr && !comp(prev->key(), key) && !comp(key, prev->key())) {
+            parent = prev;
+            return false;
+        }
+        if (!isHeader(hint)) {
+            if (unique && !comp(hint->key(), key) && !comp(key, hint->key())) {
+                parent = hint;
+                return false;
+            }
+            Node* next = hint == lastNode() ? endNode() : nextNode(hint);
+            bool afterHint = unique ? comp(hint->key(), key) : !comp(key, hint->key());
+            bool beforeNext = isHeader(next) || (unique ? comp(key, next->key()) : !comp(next->key(), key));
+            if (afterHint && beforeNext) {
+                if (hint->right == nullptr) {
+                    parent = hint;
+                    left = false;
+                } else {
+                    parent = next;
+                    left = true;
+                }
+                return true;
+            }
+        }
+        return findSlot(key, unique, parent, left);
+    }
+
+    // Links pt into the free slot found above and rebalances on the way up.
+    // Only the path to the root is touched, there are no key comparisons.
+    void linkNode(Node* parent, bool left, Node* pt) {
+        bool first = isHeader(parent) || (left && parent == firstNode());
+        bool last = isHeader(parent) || (!left && parent == lastNode());
+        pt->parent = parent;
+        if constexpr (kAggregated) {
+            updateAggregate(pt);
+        }
+        if (isHeader(parent)) {
+            root = pt;
+        } else if (left) {
+            parent->left = pt;
+        } else {
+            parent->right = pt;
+        }
+        rebalanceUp(parent);
+        root->parent = &header;
+        if (first) {
+            header.parent = pt;
+        }
+        if (last) {
+            header.right = pt;
+        }
+    }
+
+    // Refreshes sizes and heights from node to the root, rotating where needed
+    void rebalanceUp(Node* node) {
+        while (!isHeader(node)) {
+            Node* parent = node->parent;
+            updateNode(node);
+            Node* subtree = balance(node);
+            if (isHeader(parent)) {
+                root = subtree;
+            } else if (parent->left == node) {
+                parent->left = subtree;
+            } else {
+                parent->right = subtree;
+            }
+            node = parent;
+        }
+    }
+
+    // Takes node out of the tree without destroying it, the node comes back
+    // with no links like a new one. The successor takes its place when it
+    // has two children, so no other element moves to another node.
+    void unlinkNode(Node* node) {
+        Node* first = node == firstNode() ? nextNode(node) : nullptr;
+        Node* last = node == lastNode() ? prevNode(node) : nullptr;
+        Node* parent = node->parent;
+        Node* replacement;
+        Node* fixFrom;
+        if (node->left == nullptr || node->right == nullptr) {
+            replacement = node->left ? node->left : node->right;
+            fixFrom = parent;
+        } else {
+            replacement = getMin(node->right);
+            if (replacement->parent == node) {
+                fixFrom = replacement;
+            } else {
+                fixFrom = replacement->parent;
+                fixFrom->left = replacement->right;
+                if (replacement->right) {
+                    replacement->right->parent = fixFrom;
+                }
+                replacement->right = node->right;
+                node->right->parent = replacement;
+            }
+            replacement->left = node->left;
+            node->left->parent = replacement;
+        }
+        if (replacement) {
+            replacement->parent = parent;
+        }
+        if (isHeader(parent)) {
+            root = replacement;
+        } else if (parent->left == node) {
+            parent->left = replacement;
+        } else {
+            parent->right = replacement;
+        }
+        rebalanceUp(fixFrom);
+        if (root == nullptr) {
+            syncHeader();
+        } else {
+            root->parent = &header;
+            if (first) {
+                header.parent = first;
+            }
+            if (last) {
+                header.right = last;
+            }
+        }
+        node->parent = nullptr;
+        node->left = nullptr;
+        node->right = nullptr;
+        node->size = 1;
+        node->height = 0;
+    }
+
+    // Destroys node and returns the one after it
+    Node* eraseNode(Node* node) {
+        Node* next = nextNode(node);
+        unlinkNode(node);
+        destroyNode(node);
+        return next;
+    }
+
+    // Destroys the nodes from first up to last, which may be the header.
+    // The range is cut out with two splits and the rest joined back, so it
+    // costs O(log n) plus the nodes destroyed.
+    void eraseRange(Node* first, Node* last) {
+        if (first == last) {
+            return;
+        }
+        std::size_t from = rankOf(first);
+        std::size_t to = isHeader(last) ? getSize(root) : rankOf(last);
+        Node *left, *middle, *right;
+        splitAt(root, from, left, right);
+        splitAt(right, to - from, middle, right);
+        root = join2(left, right);
+        deleteTree(middle);
+        syncHeader();
+    }
+
+    // Position of node in key order, from the subtree sizes on its path
+    std::size_t rankOf(Node* node) const {
+        std::size_t rank = getSize(node->left);
+        while (!isHeader(node->parent)) {
+            if (node->parent->right == node) {
+                rank += getSize(node->parent->left) + 1;
+            }
+            node = node->parent;
+        }
+        return rank;
+    }
+
+    // Calls visit on the nodes with keys in [lo, hi) in order until it
+    // returns false: a descent to lo, then in-order steps, O(log n + k)
+    template <typename K, typename Visit>
+    void visitRange(const K& lo, const K& hi, Visit visit) {
+        Node* node = lowerBoundNode(root, lo);
+        while (node != nullptr && !isHeader(node) && comp(node->key(), hi)) {
+            if (!visit(node)) {
+                return;
+            }
+            node = nextNode(node);
+        }
+    }
+
+    // Runs a user visitor, one returning bool stops the visit with false
+    template <typename Visit, typename... Args>
+    static bool callVisitor(Visit& visit, Args&&... args) {
+        if constexpr (std::is_same_v<decltype(visit(std::forward<Args>(args)...)), bool>) {
+            return visit(std::forward<Args>(args)...);
+        } else {
+            visit(std::forward<Args>(args)...);
+            return true;
+        }
+    }
+
+    NodeHandle extractNode(Node* node) {
+        unlinkNode(node);
+        return NodeHandle(node, nodePool(), retained);
+    }
+
+    // Links the node of handle where its key belongs and empties handle.
+    // With unique set and an equal key present the handle keeps its node and
+    // the equal node comes back with false. handle must not be empty.
+    std::pair<Node*, bool> insertHandle(NodeHandle& handle, bool unique) {
+        Node* parent;
+        bool left;
+        if (!findSlot(handle.node->key(), unique, parent, left)) {
+            return {parent, false};
+        }
+        retainPools(handle.pool, handle.retained);
+        Node* pt = handle.release();
+        linkNode(parent, left, pt);
+        return {pt, true};
+    }
+
+    // Moves the nodes of other whose keys are missing here, or all of them
+    // without unique, by relinking. No node is allocated or copied.
+    void spliceFrom(Tree& other, bool unique) {
+        if (this == &other || other.root == nullptr) {
+            return;
+        }
+        retainPools(other.pool, other.retained);
+        Node* node = other.firstNode();
+        while (!isHeader(node)) {
+            Node* next = nextNode(node);
+            Node* parent;
+            bool left;
+            if (findSlot(node->key(), unique, parent, left)) {
+                other.unlinkNode(node);
+                linkNode(parent, left, node);
+            }
+            node = next;
+        }
+    }
+
+    // Single descent insert. A node is built from args and linked where
+    // key belongs; with unique set and key present nothing is built and the
+    // equal node comes back with false. args may refer to key.
+    template <typename K, typename... Args>
+    std::pair<Node*, bool> emplaceKey(const K& key, bool unique, Args&&... args) {
+        Node* parent;
+        bool left;
+        if (!findSlot(key, unique, parent, left)) {
+            return {parent, false};
+        }
+        Node* pt = createNode(std::forward<Args>(args)...);
+        linkNode(parent, left, pt);
+        return {pt, true};
+    }
+
+    // Same starting from hint, see hintSlot
+    template <typename K, typename... Args>
+    std::pair<Node*, bool> emplaceHint(Node* hint, const K& key, bool unique, Args&&... args) {
+        Node* parent;
+        bool left;
+        if (!hintSlot(hint, key, unique, parent, left)) {
+            return {parent, false};
+        }
+        Node* pt = createNode(std::forward<Args>(args)...);
+        linkNode(parent, left, pt);
+        return {pt, true};
+    }
+
+    // Node allocation
+    const std::shared_ptr<NodePool<Node>>& nodePool() {
+        if (!pool) {
+            pool = std::make_shared<NodePool<Node>>();
+        }
+        return pool;
+    }
+
+    template <typename... Args>
+    Node* createNode(Args&&... args) {
+        return nodePool()->create(std::forward<Args>(args)...);
+    }
+
+    void destroyNode(Node* node) {
+        node->destroyData();
+        nodePool()->destroy(node);
+    }
+
+    // Destroys every node and gives the slabs back. Trivially destructible
+    // nodes are dropped together with their slabs without a tree walk,
+    // unless node handles or other trees still hold nodes in the slabs.
+    void clearTree() {
+        bool shared = pool && pool.use_count() > 1;
+        if (shared || !std::is_trivially_destructible_v<Key> || !std::is_trivially_destructible_v<Value>) {
+            deleteTree(root);
+        }
+        if (!shared) {
+            if (pool) {
+                pool->release();
+            }
+            retained.reset();
+        }
         root = nullptr;
+        syncHeader();
+    }
+
+    // Keeps source and the pools it retains alive for as long as this
+    // tree, which is about to take nodes from them. A new list is built
+    // only when one of them is missing.
+    void retainPools(const std::shared_ptr<NodePool<Node>>& source, const std::shared_ptr<const PoolList>& sourceRetained) {
+        std::vector<std::shared_ptr<NodePool<Node>>> missing;
+        auto check = [&](const std::shared_ptr<NodePool<Node>>& candidate) {
+            if (candidate && candidate != pool &&
+                (!retained || std::find(retained->begin(), retained->end(), candidate) == retained->end())) {
+                missing.push_back(candidate);
+            }
+        };
+        check(source);
+        if (sourceRetained) {
+            std::for_each(sourceRetained->begin(), sourceRetained->end(), check);
+        }
+        if (missing.empty()) {
+            return;
+        }
+        auto list = retained ? std::make_shared<PoolList>(*retained) : std::make_shared<PoolList>();
+        list->insert(list->end(), missing.begin(), missing.end());
+        retained = std::move(list);
+    }
+
+    // Empties other and returns its nodes, which this tree takes over by
+    // retaining the pools of other
+    Node* adoptNodes(Tree& other) {
+        Node* nodes = other.root;
+        retainPools(other.pool, other.retained);
+        other.root = nullptr;
+        other.syncHeader();
+        return nodes;
+    }
+
+    // Takes over the nodes of other, dropping the current ones
+    void moveTree(Tree& other) {
+        clearTree();
+        takeTree(other);
     }
 
     // Balance Tree
     int getHeight(Node* node) {
-        return node == nullptr ? -1 : node->height;
+        return node == nullptr ? -1 : static_cast<int>(node->height);
     }
 
     void updateHeight(Node* node) {
         node->height = std::max(getHeight(node->left), getHeight(node->right)) + 1;
     }
 
-    int getBalance(Node* node) {
-        return (node == nullptr) ? 0 : getHeight(node->right) - getHeight(node->left); 
+    // Number of nodes in the subtree, kept in every node
+    std::size_t getSize(Node* node) const {
+        return node == nullptr ? 0 : node->size;
     }
 
-    void swap(Node* a, Node* b) {
-        Key a_key = a->key;
-        a->key = b->key;
-        b->key = a_key;
-        Value a_value = a->value;
-        a->value = b->value;
-        b->value = a_value;
+    void updateSize(Node* node) {
+        node->size = getSize(node->left) + getSize(node->right) + 1;
     }
 
-    void rightRotate(Node* node) {
-        swap(node, node->left);
-        Node* buffer = node->right;
-        node->right = node->left;
-        node->left = node->right->left;
-        node->right->left = node->right->right;
-        node->right->right = buffer;
-        updateHeight(node->right);
+    void updateNode(Node* node) {
         updateHeight(node);
+        updateSize(node);
+        if constexpr (kAggregated) {
+            updateAggregate(node);
+        }
     }
 
-    void leftRotate(Node* node) {
-        swap(node, node->right);
-        Node* buffer = node->left;
-        node->left = node->right;
-        node->right = node->left->right;
-        node->left->right = node->left->left;
-        node->left->left = buffer;
-        updateHeight(node->left);
-        updateHeight(node);
+    // Aggregates, only used with an aggregate policy
+
+    template <typename A = Aggregate>
+    static typename A::value_type aggregateOf(const Node* node) {
+        return node == nullptr ? A::identity() : node->aggregate;
     }
 
-    void balance(Node* node) {
-        int balance = getBalance(node);
-        if (balance == -2) {
-            if (getBalance(node->left) == 1) leftRotate(node->left);
-            rightRotate(node);
-        } else if (balance == 2) {
-            if (getBalance(node->right) == -1) rightRotate(node->right);
-            leftRotate(node);
+    template <typename A = Aggregate>
+    static typename A::value_type liftNode(Node* node) {
+        if constexpr (std::is_same_v<Value, TreeNoValue>) {
+            return A::lift(node->key());
+        } else if constexpr (lifts_key<A, Key, Value>::value) {
+            return A::lift(node->key(), node->value());
+        } else {
+            return A::lift(node->value());
         }
     }
 
-    Node* insertTree(Node* root, Node* pt) {
-        if (root == nullptr) {
-            return pt;
+    static void updateAggregate(Node* node) {
+        node->aggregate = Aggregate::combine(Aggregate::combine(aggregateOf(node->left), liftNode(node)),
+                                             aggregateOf(node->right));
+    }
+
+    // Recomputes the aggregates from node to the root after its value was
+    // changed in place
+    void refreshAggregates(Node* node) {
+        for (; !isHeader(node); node = node->parent) {
+            updateAggregate(node);
         }
-        if (pt->key == root->key) {
-            return root;
+    }
+
+    // Aggregate of the keys in [lo, hi): a descent to the topmost node in
+    // the range, then one path down each side of it, O(log n)
+    template <typename K, typename A = Aggregate>
+    typename A::value_type aggregateRange(const K& lo, const K& hi) {
+        Node* node = root;
+        while (node != nullptr) {
+            if (comp(node->key(), lo)) {
+                node = node->right;
+            } else if (!comp(node->key(), hi)) {
+                node = node->left;
+            } else {
+                break;
+            }
         }
-        if (pt->key < root->key) {
-            root->left = insertTree(root->left, pt);
-            root->left->parent = root;
-        } else {
-            root->right = insertTree(root->right, pt);
-            root->right->parent = root;
+        if (node == nullptr) {
+            return A::identity();
         }
-        updateHeight(root);
-        balance(root);
-        return root;
+        return A::combine(A::combine(aggregateFrom(node->left, lo), liftNode(node)), aggregateBelow(node->right, hi));
     }
 
-    Node* insertWithDuplicates(Node* root, Node* pt) {
-        if (root == nullptr) {
-            return pt;
+    // Aggregate of the keys not before lo in the subtree
+    template <typename K, typename A = Aggregate>
+    typename A::value_type aggregateFrom(Node* node, const K& lo) {
+        typename A::value_type result = A::identity();
+        while (node != nullptr) {
+            if (comp(node->key(), lo)) {
+                node = node->right;
+            } else {
+                result = A::combine(liftNode(node), A::combine(aggregateOf(node->right), result));
+                node = node->left;
+            }
         }
+        return result;
+    }
 
-        if (pt->key < root->key) {
-            root->left = insertWithDuplicates(root->left, pt);
-            root->left->parent = root;
-        } else {
-            root->right = insertWithDuplicates(root->right, pt);
-            root->right->parent = root;
+    // Aggregate of the keys before hi in the subtree
+    template <typename K, typename A = Aggregate>
+    typename A::value_type aggregateBelow(Node* node, const K& hi) {
+        typename A::value_type result = A::identity();
+        while (node != nullptr) {
+            if (comp(node->key(), hi)) {
+                result = A::combine(result, A::combine(aggregateOf(node->left), liftNode(node)));
+                node = node->right;
+            } else {
+                node = node->left;
+            }
         }
-        updateHeight(root);
-        balance(root);
-        return root;
+        return result;
     }
 
-    Node* assign(Node* node, Node* pt) {
-        if (node == nullptr) {
-            return pt;
+    int getBalance(Node* node) {
+        return (node == nullptr) ? 0 : getHeight(node->right) - getHeight(node->left); 
+    }
+
+    // Rotations only relink pointers, keys and values never move between
+    // nodes. Both return the new root of the rotated subtree.
+    Node* rightRotate(Node* node) {
+        this->countRotation();
+        Node* pivot = node->left;
+        node->left = pivot->right;
+        if (node->left) {
+            node->left->parent = node;
         }
-        if (pt->key == root->key) {
-            return pt;
+        pivot->right = node;
+        pivot->parent = node->parent;
+        node->parent = pivot;
+        updateNode(node);
+        updateNode(pivot);
+        return pivot;
+    }
+
+    Node* leftRotate(Node* node) {
+        this->countRotation();
+        Node* pivot = node->right;
+        node->right = pivot->left;
+        if (node->right) {
+            node->right->parent = node;
         }
-        if (pt->key < root->key) {
-            root->left = insertTree(root->left, pt);
-            root->left->parent = root;
-        } else {
-            root->right = insertTree(root->right, pt);
-            root->right->parent = root;
+        pivot->left = node;
+        pivot->parent = node->parent;
+        node->parent = pivot;
+        updateNode(node);
+        updateNode(pivot);
+        return pivot;
+    }
+
+    Node* balance(Node* node) {
+        int balance = getBalance(node);
+        if (balance == -2) {
+            if (getBalance(node->left) == 1) node->left = leftRotate(node->left);
+            return rightRotate(node);
+        } else if (balance == 2) {
+            if (getBalance(node->right) == -1) node->right = rightRotate(node->right);
+            return leftRotate(node);
+        }
+        return node;
+    }
+
+    // Diagnostics
+
+    // Walks every node for the shape of the tree, O(n)
+    TreeStats treeStats() {
+        TreeStats stats;
+        stats.nodes = getSize(root);
+        stats.height = 0;
+        collectDepths(root, 0, stats);
+        stats.heightBound = avlHeightBound(stats.nodes);
+        stats.counted = kCounted;
+        stats.rotations = this->rotationCount();
+        stats.comparisons = 0;
+        if constexpr (kCounted) {
+            stats.comparisons = comp.comparisons();
+        }
+        stats.bytesAllocated = pool ? pool->allocatedBytes() : 0;
+        return stats;
+    }
+
+    void resetStats() {
+        this->resetRotations();
+        if constexpr (kCounted) {
+            comp.resetComparisons();
+        }
+    }
+
+    void collectDepths(Node* node, std::size_t depth, TreeStats& stats) {
+        if (node == nullptr) {
+            return;
         }
-        updateHeight(root);
-        balance(root);
-        return root;
+        stats.height = std::max(stats.height, depth + 1);
+        if (node->left == nullptr && node->right == nullptr) {
+            if (stats.leafDepths.size() <= depth) {
+                stats.leafDepths.resize(depth + 1, 0);
+            }
+            ++stats.leafDepths[depth];
+        }
+        collectDepths(node->left, depth + 1, stats);
+        collectDepths(node->right, depth + 1, stats);
     }
 
     void printTree(Node* node) {
@@ -156,15 +964,58 @@ public:
             return ;
         }
         printTree(node -> left);
-        // std::cout << node->key << std::endl;
-        std::cout << node->value << std::endl;
+        if constexpr (std::is_same_v<Value, TreeNoValue>) {
+            std::cout << node->key() << std::endl;
+        } else {
+            std::cout << node->value() << std::endl;
+        }
         printTree(node -> right);
     }
 
-    void assign(Node* node, const Value& obj) {
-        if (node != nullptr) {
-            node->value = obj;
+    // Replaces the contents with a perfectly balanced tree built from a
+    // sorted range in O(n). Heights come out AVL-balanced, no rotations.
+    template <typename Iterator>
+    void build_from_sorted(Iterator first, Iterator last) {
+        clearTree();
+        root = buildSorted(first, static_cast<std::size_t>(std::distance(first, last)));
+        syncHeader();
+    }
+
+    // Consumes count elements from it in order, the middle one becomes the root
+    template <typename Iterator>
+    Node* buildSorted(Iterator& it, std::size_t count) {
+        if (count == 0) {
+            return nullptr;
+        }
+        std::size_t left_count = count / 2;
+        Node* left = buildSorted(it, left_count);
+        Node* node = createNode(*it);
+        ++it;
+        node->left = left;
+        node->right = buildSorted(it, count - left_count - 1);
+        if (node->left) {
+            node->left->parent = node;
         }
+        if (node->right) {
+            node->right->parent = node;
+        }
+        updateNode(node);
+        return node;
+    }
+
+    // True when the keys of the range ascend, strictly for unique trees
+    template <typename Iterator, typename KeyOf>
+    bool isSortedRange(Iterator first, Iterator last, bool unique, KeyOf keyOf) {
+        if (first == last) {
+            return true;
+        }
+        Iterator prev = first;
+        for (++first; first != last; prev = first, ++first) {
+            if (comp(keyOf(*first), keyOf(*prev)) || (unique && !comp(keyOf(*prev), keyOf(*first)))) {
+                return false;
+            }
+        }
+        return true;
     }
 
     Node* copyTree(Node* node) {
@@ -172,12 +1023,7 @@ public:
             return nullptr;
         }
 
-        Node* newNode;
-        if constexpr (std::is_same_v<Value, void>) {
-            newNode = new Node(node->key);
-        } else {
-            newNode = new Node(std::make_pair(node->key, node->value));
-        }
+        Node* newNode = createNode(node->data);
 
         newNode->left = copyTree(node->left);
         newNode->right = copyTree(node->right);
@@ -187,6 +1033,7 @@ public:
         if (newNode->right) {
             newNode->right->parent = newNode;
         }
+        updateNode(newNode);
         return newNode;
     }
 
@@ -195,33 +1042,168 @@ public:
             deleteTree(node -> left);
             deleteTree(node -> right);
 
-            delete node;
+            destroyNode(node);
         }
     }
 
-    Node* findInTree(Node* root, const Key& key) {
-        if (root == nullptr || root->key == key) {
-            return root;
+    template <typename K>
+    Node* findInTree(Node* root, const K& key) {
+        while (root != nullptr) {
+            if (comp(key, root->key())) {
+                root = root->left;
+            } else if (comp(root->key(), key)) {
+                root = root->right;
+            } else {
+                return root;
+            }
         }
+        return nullptr;
+    }
 
-        if (key < root->key) {
-            return findInTree(root->left, key);
-        } else {
-            return findInTree(root->right, key);
+    // Descents kept in flight by findMany()
+    static constexpr std::size_t kLookupLanes = 32;
+
+    static void prefetchNode(const Node* node) {
+#if defined(__GNUC__) || defined(__clang__)
+        __builtin_prefetch(node);
+#else
+        (void)node;
+#endif
+    }
+
+    // Looks up every key of keys, which is indexable, and calls
+    // found(index, node) with nullptr for absent keys, in no particular
+    // order. Up to kLookupLanes descents run interleaved: each pass moves
+    // every lane one level down and prefetches the child it moves to, so
+    // the cache misses of different lookups overlap instead of queueing.
+    template <typename Keys, typename Found>
+    void findMany(const Keys& keys, Found found) {
+        struct Lane {
+            Node* node;
+            std::size_t index;
+        };
+        Lane lanes[kLookupLanes];
+        std::size_t count = keys.size();
+        std::size_t next = 0;
+        std::size_t active = 0;
+        for (; active < kLookupLanes && next < count; ++active, ++next) {
+            lanes[active] = {root, next};
+        }
+        while (active > 0) {
+            for (std::size_t i = 0; i < active;) {
+                Lane& lane = lanes[i];
+                Node* node = lane.node;
+                Node* match = nullptr;
+                if (node != nullptr) {
+                    const auto& key = keys[lane.index];
+                    if (comp(key, node->key())) {
+                        lane.node = node->left;
+                    } else if (comp(node->key(), key)) {
+                        lane.node = node->right;
+                    } else {
+                        match = node;
+                    }
+                    if (match == nullptr) {
+                        // A null child is reported as a miss on the next pass
+                        if (lane.node != nullptr) {
+                            prefetchNode(lane.node);
+                        }
+                        ++i;
+                        continue;
+                    }
+                }
+                found(lane.index, match);
+                // The finished lane takes the next key, or the last lane
+                // moves into its place
+                if (next < count) {
+                    lane = {root, next++};
+                    ++i;
+                } else {
+                    lane = lanes[--active];
+                }
+            }
         }
     }
 
-    int getSize(Node* node, int& count) {
-        if (node == nullptr) {
-            return 0;
+    // First node not before key, nullptr when there is none
+    template <typename K>
+    Node* lowerBoundNode(Node* node, const K& key) {
+        Node* result = nullptr;
+        while (node != nullptr) {
+            if (!comp(node->key(), key)) {
+                result = node;
+                node = node->left;
+            } else {
+                node = node->right;
+            }
+        }
+        return result;
+    }
+
+    // First node after key, nullptr when there is none
+    template <typename K>
+    Node* upperBoundNode(Node* node, const K& key) {
+        Node* result = nullptr;
+        while (node != nullptr) {
+            if (comp(key, node->key())) {
+                result = node;
+                node = node->left;
+            } else {
+                node = node->right;
+            }
+        }
+        return result;
+    }
+
+    // Order statistics, O(log n) thanks to the subtree sizes
+    Node* nthNode(Node* node, std::size_t k) {
+        while (node != nullptr) {
+            std::size_t left_size = getSize(node->left);
+            if (k < left_size) {
+                node = node->left;
+            } else if (k == left_size) {
+                return node;
+            } else {
+                k -= left_size + 1;
+                node = node->right;
+            }
         }
+        return nullptr;
+    }
+
+    template <typename K>
+    std::size_t countLess(Node* node, const K& key) {
+        std::size_t count = 0;
+        while (node != nullptr) {
+            if (comp(node->key(), key)) {
+                count += getSize(node->left) + 1;
+                node = node->right;
+            } else {
+                node = node->left;
+            }
+        }
+        return count;
+    }
 
-        count += 1;
-        getSize(node -> left, count);
-        getSize(node -> right, count);
-  
+    template <typename K>
+    std::size_t countLessOrEqual(Node* node, const K& key) {
+        std::size_t count = 0;
+        while (node != nullptr) {
+            if (comp(key, node->key())) {
+                node = node->left;
+            } else {
+                count += getSize(node->left) + 1;
+                node = node->right;
+            }
+        }
         return count;
-        // return 1 + getSize(node->left) + getSize(node->right);
+    }
+
+    template <typename K>
+    std::size_t countRange(Node* node, const K& lo, const K& hi) {
+        std::size_t below_lo = countLess(node, lo);
+        std::size_t below_hi = countLess(node, hi);
+        return below_hi > below_lo ? below_hi - below_lo : 0;
     }
 
     Node* getMin(Node* node) {
@@ -232,34 +1214,342 @@ public:
         return current;
     }
 
-    Node* erase(Node* root, const Key& key) {
+    Node* getMax(Node* node) {
+        Node* current = node;
+        while (current && current->right != nullptr) {
+            current = current->right;
+        }
+        return current;
+    }
+
+    // Unlinks the minimum of the subtree without freeing it
+    Node* detachMin(Node* node) {
+        if (node->left == nullptr) {
+            Node* right = node->right;
+            if (right) {
+                right->parent = node->parent;
+            }
+            return right;
+        }
+        node->left = detachMin(node->left);
+        if (node->left) {
+            node->left->parent = node;
+        }
+        updateNode(node);
+        return balance(node);
+    }
+
+    template <typename K>
+    Node* erase(Node* root, const K& key) {
         if (root == nullptr) {
             return root; 
         }
 
-        if (key < root->key) {
+        if (comp(key, root->key())) {
             root->left = erase(root->left, key);
-        } else if (key > root->key) {
+            if (root->left) {
+                root->left->parent = root;
+            }
+        } else if (comp(root->key(), key)) {
             root->right = erase(root->right, key);
+            if (root->right) {
+                root->right->parent = root;
+            }
         } else {
+            Node* left = root->left;
+            Node* right = root->right;
+            Node* parent = root->parent;
+            destroyNode(root);
+
+            if (right == nullptr) {
+                if (left) {
+                    left->parent = parent;
+                }
+                return left;
+            }
 
-            if (root->left == nullptr) {
-                Node* temp = root->right;
-                delete root; 
-                return temp; 
-            } else if (root->right == nullptr) {
-                Node* temp = root->left;
-                delete root;
-                return temp;
+            // The successor node takes the place of the erased one
+            Node* successor = getMin(right);
+            right = detachMin(right);
+            successor->left = left;
+            successor->right = right;
+            successor->parent = parent;
+            if (left) {
+                left->parent = successor;
             }
+            if (right) {
+                right->parent = successor;
+            }
+            root = successor;
+        }
+        updateNode(root);
+        return balance(root);
+    }
+
+    // Join-based set algebra. join() and split() work on detached subtrees
+    // and return roots with a null parent.
+    enum class SetOperation { Union, Intersection, Difference, SymmetricDifference };
+
+    // Every key of left is before mid and every key of right is after it
+    Node* join(Node* left, Node* mid, Node* right) {
+        Node* result;
+        if (getHeight(left) > getHeight(right) + 1) {
+            result = joinRight(left, mid, right);
+        } else if (getHeight(right) > getHeight(left) + 1) {
+            result = joinLeft(left, mid, right);
+        } else {
+            result = attach(left, mid, right);
+        }
+        result->parent = nullptr;
+        return result;
+    }
+
+    Node* attach(Node* left, Node* mid, Node* right) {
+        mid->left = left;
+        mid->right = right;
+        if (left) {
+            left->parent = mid;
+        }
+        if (right) {
+            right->parent = mid;
+        }
+        updateNode(mid);
+        return mid;
+    }
 
-            Node* temp = getMin(root->right);
-            root->key = temp->key; 
-            root->right = erase(root->right, temp->key); 
+    // Walks down the right spine of the taller left tree
+    Node* joinRight(Node* left, Node* mid, Node* right) {
+        if (getHeight(left) <= getHeight(right) + 1) {
+            return attach(left, mid, right);
+        }
+        left->right = joinRight(left->right, mid, right);
+        left->right->parent = left;
+        updateNode(left);
+        return balance(left);
+    }
+
+    Node* joinLeft(Node* left, Node* mid, Node* right) {
+        if (getHeight(right) <= getHeight(left) + 1) {
+            return attach(left, mid, right);
+        }
+        right->left = joinLeft(left, mid, right->left);
+        right->left->parent = right;
+        updateNode(right);
+        return balance(right);
+    }
+
+    // Concatenation, every key of left is before every key of right
+    Node* join2(Node* left, Node* right) {
+        if (right == nullptr) {
+            return left;
+        }
+        Node* mid = getMin(right);
+        right = detachMin(right);
+        return join(left, mid, right);
+    }
+
+    // Splits into keys before key and the rest; equal keys go left when
+    // equalLeft is set
+    void split(Node* node, const Key& key, bool equalLeft, Node*& left, Node*& right) {
+        if (node == nullptr) {
+            left = right = nullptr;
+            return;
+        }
+        Node* l = detachLeft(node);
+        Node* r = detachRight(node);
+        if (comp(node->key(), key) || (equalLeft && !comp(key, node->key()))) {
+            Node* middle;
+            split(r, key, equalLeft, middle, right);
+            left = join(l, node, middle);
+        } else {
+            Node* middle;
+            split(l, key, equalLeft, left, middle);
+            right = join(middle, node, r);
+        }
+    }
+
+    // Three-way split into keys before, equal to and after key. With unique
+    // keys the equal part is a single node.
+    void split3(Node* node, const Key& key, bool unique, Node*& less, Node*& equal, Node*& greater) {
+        if (node == nullptr) {
+            less = equal = greater = nullptr;
+            return;
+        }
+        Node* l = detachLeft(node);
+        Node* r = detachRight(node);
+        if (comp(node->key(), key)) {
+            Node* middle;
+            split3(r, key, unique, middle, equal, greater);
+            less = join(l, node, middle);
+        } else if (comp(key, node->key())) {
+            Node* middle;
+            split3(l, key, unique, less, equal, middle);
+            greater = join(middle, node, r);
+        } else if (unique) {
+            less = l;
+            greater = r;
+            equal = attach(nullptr, node, nullptr);
+        } else {
+            Node *equal_left, *equal_right;
+            split(l, key, false, less, equal_left);
+            split(r, key, true, equal_right, greater);
+            equal = join(equal_left, node, equal_right);
+        }
+    }
+
+    // The first count nodes in order go left
+    void splitAt(Node* node, std::size_t count, Node*& left, Node*& right) {
+        if (node == nullptr) {
+            left = right = nullptr;
+            return;
+        }
+        Node* l = detachLeft(node);
+        Node* r = detachRight(node);
+        std::size_t left_size = getSize(l);
+        if (count <= left_size) {
+            Node* middle;
+            splitAt(l, count, left, middle);
+            right = join(middle, node, r);
+        } else {
+            Node* middle;
+            splitAt(r, count - left_size - 1, middle, right);
+            left = join(l, node, middle);
+        }
+    }
+
+    Node* detachLeft(Node* node) {
+        Node* child = node->left;
+        node->left = nullptr;
+        if (child) {
+            child->parent = nullptr;
+        }
+        return child;
+    }
+
+    Node* detachRight(Node* node) {
+        Node* child = node->right;
+        node->right = nullptr;
+        if (child) {
+            child->parent = nullptr;
+        }
+        return child;
+    }
+
+    // Subtrees dropped by a parallel set operation are collected and freed
+    // after all tasks finish, the node pool is not thread-safe
+    void discardTree(Node* node, std::vector<Node*>* garbage) {
+        if (node == nullptr) {
+            return;
+        }
+        if (garbage) {
+            garbage->push_back(node);
+        } else {
+            deleteTree(node);
+        }
+    }
+
+    // Below this many nodes a parallel set operation recurses sequentially
+    static constexpr std::size_t kParallelCutoff = 1 << 14;
+
+    // Combines two detached trees, reusing their nodes. Multiset counts
+    // follow std::set_union and friends: max, min, difference and absolute
+    // difference of the number of equal keys. With workers the two halves
+    // around the pivot are processed as fork-join tasks.
+    Node* setOperation(Node* a, Node* b, SetOperation op, bool unique,
+                       ThreadPool* workers = nullptr, std::vector<Node*>* garbage = nullptr) {
+        if (a == nullptr || b == nullptr) {
+            bool keep_a = op != SetOperation::Intersection;
+            bool keep_b = op == SetOperation::Union || op == SetOperation::SymmetricDifference;
+            if (a && !keep_a) {
+                discardTree(a, garbage);
+                a = nullptr;
+            }
+            if (b && !keep_b) {
+                discardTree(b, garbage);
+                b = nullptr;
+            }
+            return a ? a : b;
+        }
+        bool parallel = workers && getSize(a) + getSize(b) >= kParallelCutoff;
+
+        Node *a_less, *a_equal, *a_greater;
+        Node *b_less, *b_equal, *b_greater;
+        const Key& pivot = a->key();
+        split3(b, pivot, unique, b_less, b_equal, b_greater);
+        split3(a, pivot, unique, a_less, a_equal, a_greater);
+
+        Node *left, *right;
+        if (parallel) {
+            std::vector<Node*> right_garbage;
+            workers->invoke(
+                [&] { left = setOperation(a_less, b_less, op, unique, workers, garbage); },
+                [&] { right = setOperation(a_greater, b_greater, op, unique, workers, &right_garbage); });
+            garbage->insert(garbage->end(), right_garbage.begin(), right_garbage.end());
+        } else {
+            left = setOperation(a_less, b_less, op, unique, workers, garbage);
+            right = setOperation(a_greater, b_greater, op, unique, workers, garbage);
+        }
+
+        std::size_t count_a = getSize(a_equal);
+        std::size_t count_b = getSize(b_equal);
+        Node* source = a_equal;
+        std::size_t count = 0;
+        switch (op) {
+            case SetOperation::Union:
+                source = count_a >= count_b ? a_equal : b_equal;
+                count = std::max(count_a, count_b);
+                break;
+            case SetOperation::Intersection:
+                source = count_a <= count_b ? a_equal : b_equal;
+                count = std::min(count_a, count_b);
+                break;
+            case SetOperation::Difference:
+                count = count_a > count_b ? count_a - count_b : 0;
+                break;
+            case SetOperation::SymmetricDifference:
+                source = count_a >= count_b ? a_equal : b_equal;
+                count = count_a >= count_b ? count_a - count_b : count_b - count_a;
+                break;
+        }
+        discardTree(source == a_equal ? b_equal : a_equal, garbage);
+
+        Node *middle, *rest;
+        splitAt(source, count, middle, rest);
+        discardTree(rest, garbage);
+
+        if (middle != nullptr && middle->size == 1) {
+            return join(left, middle, right);
+        }
+        return join2(join2(left, middle), right);
+    }
+
+    // Applies op to this tree and other in place. other is drained and its
+    // nodes are either moved into this tree or destroyed.
+    void applySetOperation(Tree& other, SetOperation op, bool unique) {
+        if (this == &other) {
+            if (op == SetOperation::Difference || op == SetOperation::SymmetricDifference) {
+                clearTree();
+            }
+            return;
+        }
+        Node* nodes = adoptNodes(other);
+        root = setOperation(root, nodes, op, unique);
+        syncHeader();
+    }
+
+    // Same as above with the work spread over the threads of workers
+    void applySetOperation(Tree& other, SetOperation op, bool unique, ThreadPool& workers) {
+        if (this == &other) {
+            applySetOperation(other, op, unique);
+            return;
+        }
+        Node* nodes = adoptNodes(other);
+        std::vector<Node*> garbage;
+        root = setOperation(root, nodes, op, unique, &workers, &garbage);
+        for (Node* node : garbage) {
+            deleteTree(node);
         }
-        updateHeight(root);
-        balance(root);
-        return root;
+        syncHeader();
     }
 };
 }
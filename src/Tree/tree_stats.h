@@ -0,0 +1,143 @@
+#ifndef __TREE_STATS_H__
+#define __TREE_STATS_H__
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace s21 {
+// Stats policies of Tree. With the default, TreeNoStats, nothing is
+// counted and the tree carries no counter at all; TreeCountStats counts
+// rotations and key comparisons for stats(). The counters use relaxed
+// loads and stores, not read-modify-write, so counting stays cheap and
+// free of data races, but parallel set operations may undercount.
+struct TreeNoStats {};
+
+struct TreeCountStats {};
+
+// What stats() reports. Depths count the root as 0, heights count levels,
+// so a lone root has height 1.
+struct TreeStats {
+    std::size_t nodes;
+    std::size_t height;
+    // Largest height of any AVL tree with this many nodes, about
+    // 1.44 log2(nodes); a taller tree is corrupt
+    std::size_t heightBound;
+    // leafDepths[d] is the number of leaves at depth d
+    std::vector<std::size_t> leafDepths;
+    // Whether the counters below are compiled in, they read 0 otherwise
+    bool counted;
+    std::uint64_t rotations;
+    std::uint64_t comparisons;
+    // Bytes taken by the node pool of this tree
+    std::size_t bytesAllocated;
+};
+
+inline std::size_t avlHeightBound(std::size_t nodes) {
+    // Fewest nodes of an AVL tree of height h: fewest(h - 1) + fewest(h - 2) + 1
+    std::size_t height = 0;
+    std::size_t shorter = 0, fewest = 1;
+    while (fewest <= nodes) {
+        ++height;
+        std::size_t next = fewest + shorter + 1;
+        shorter = fewest;
+        fewest = next;
+    }
+    return height;
+}
+
+inline void bumpCounter(std::atomic<std::uint64_t>& counter) {
+    counter.store(counter.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+}
+
+// Rotation counter, a base of Tree so that it takes no space without one
+template <typename Stats>
+class TreeCounters {
+protected:
+    static constexpr bool kCounted = false;
+
+    void countRotation() {}
+
+    std::uint64_t rotationCount() const {
+        return 0;
+    }
+
+    void resetRotations() {}
+};
+
+template <>
+class TreeCounters<TreeCountStats> {
+protected:
+    static constexpr bool kCounted = true;
+
+    // A copy of a tree starts counting from zero
+    TreeCounters() : rotations(0) {}
+
+    TreeCounters(const TreeCounters&) : rotations(0) {}
+
+    TreeCounters& operator=(const TreeCounters&) {
+        return *this;
+    }
+
+    void countRotation() {
+        bumpCounter(rotations);
+    }
+
+    std::uint64_t rotationCount() const {
+        return rotations.load(std::memory_order_relaxed);
+    }
+
+    void resetRotations() {
+        rotations.store(0, std::memory_order_relaxed);
+    }
+
+private:
+    std::atomic<std::uint64_t> rotations;
+};
+
+// Compare with a count of its calls, what Tree orders keys with under
+// TreeCountStats. Compare must then be a class.
+template <typename Compare>
+class CountingCompare : public Compare {
+public:
+    CountingCompare() : count(0) {}
+
+    CountingCompare(const CountingCompare& other) : Compare(other), count(other.comparisons()) {}
+
+    CountingCompare& operator=(const CountingCompare& other) {
+        Compare::operator=(other);
+        count.store(other.comparisons(), std::memory_order_relaxed);
+        return *this;
+    }
+
+    template <typename A, typename B>
+    bool operator()(const A& a, const B& b) const {
+        bumpCounter(count);
+        return Compare::operator()(a, b);
+    }
+
+    std::uint64_t comparisons() const {
+        return count.load(std::memory_order_relaxed);
+    }
+
+    void resetComparisons() {
+        count.store(0, std::memory_order_relaxed);
+    }
+
+private:
+    mutable std::atomic<std::uint64_t> count;
+};
+
+template <typename Compare, typename Stats>
+struct TreeCompare {
+    using type = Compare;
+};
+
+template <typename Compare>
+struct TreeCompare<Compare, TreeCountStats> {
+    using type = CountingCompare<Compare>;
+};
+}
+
+#endif
@@ -0,0 +1,91 @@
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+
+#include "../containers/s21_set.h"
+#include "../containersplus/s21_btree_set.h"
+
+// AVL set against the B+tree set at 10^4, 10^6 and, when asked for, 10^8
+// keys: random inserts, random lookups, a full scan and random erases. The
+// largest size needs several gigabytes for the AVL nodes, so it only runs
+// when the largest exponent is passed as the first argument.
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+template <typename F>
+double measure(F &&f) {
+  auto start = Clock::now();
+  f();
+  return std::chrono::duration<double, std::milli>(Clock::now() - start)
+      .count();
+}
+
+volatile long sink = 0;
+
+// Permutation of 0..n-1 scaled so that half the probes miss
+std::vector<long> shuffled_keys(std::size_t n) {
+  std::vector<long> keys(n);
+  unsigned long long state = 88172645463325252ULL;
+  for (std::size_t i = 0; i < n; ++i) {
+    keys[i] = static_cast<long>(i) * 2;
+  }
+  for (std::size_t i = n; i > 1; --i) {
+    state ^= state << 13;
+    state ^= state >> 7;
+    state ^= state << 17;
+    std::swap(keys[i - 1], keys[state % i]);
+  }
+  return keys;
+}
+
+template <typename Set>
+void run(const char *name, const std::vector<long> &keys) {
+  std::size_t n = keys.size();
+  Set set;
+  double insert_ms = measure([&] {
+    for (long key : keys) {
+      set.insert(key);
+    }
+  });
+  double find_ms = measure([&] {
+    for (std::size_t i = 0; i < n; ++i) {
+      sink += set.contains(keys[i] + static_cast<long>(i & 1));
+    }
+  });
+  double scan_ms = measure([&] {
+    for (auto it = set.begin(); it != set.end(); ++it) {
+      sink += *it;
+    }
+  });
+  double erase_ms = measure([&] {
+    for (long key : keys) {
+      set.erase(set.find(key));
+    }
+  });
+  auto per_op = [n](double ms) { return ms * 1e6 / n; };
+  std::cout << "  " << name << "\t" << per_op(insert_ms) << "\t"
+            << per_op(find_ms) << "\t" << per_op(scan_ms) << "\t"
+            << per_op(erase_ms) << '\n';
+}
+
+}  // namespace
+
+int main(int argc, char **argv) {
+  int max_exponent = argc > 1 ? std::atoi(argv[1]) : 6;
+
+  for (int exponent = 4; exponent <= max_exponent; exponent += 2) {
+    std::size_t n = 1;
+    for (int i = 0; i < exponent; ++i) {
+      n *= 10;
+    }
+    std::vector<long> keys = shuffled_keys(n);
+    std::cout << n << " keys, ns per element\n";
+    std::cout << "  container\tinsert\tfind\tscan\terase\n";
+    run<s21::set<long>>("s21::set", keys);
+    run<s21::btree_set<long>>("s21::btree_set", keys);
+  }
+  return 0;
+}
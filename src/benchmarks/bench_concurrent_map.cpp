@@ -0,0 +1,133 @@
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <mutex>
+#include <shared_mutex>
+#include <thread>
+#include <vector>
+
+#include "../containers/s21_map.h"
+#include "../containersplus/s21_concurrent_map.h"
+
+// Read throughput with one writer running next to a growing number of
+// readers: s21::map behind a std::shared_mutex against s21::concurrent_map.
+// Readers look up random keys, the writer keeps replacing values and
+// erasing and reinserting keys. Reported in million lookups per second
+// over all readers, plus the writes the writer managed meanwhile.
+
+namespace {
+
+volatile unsigned long long sink = 0;
+
+struct LockedMap {
+  mutable s21::map<long, long> map;
+  mutable std::shared_mutex lock;
+
+  long get(long key) const {
+    std::shared_lock<std::shared_mutex> guard(lock);
+    return map.contains(key) ? 1 : 0;
+  }
+
+  void put(long key, long value) {
+    std::unique_lock<std::shared_mutex> guard(lock);
+    map.insert_or_assign(key, value);
+  }
+
+  void remove(long key) {
+    std::unique_lock<std::shared_mutex> guard(lock);
+    map.erase(key);
+  }
+};
+
+struct LockFreeMap {
+  s21::concurrent_map<long, long> map;
+
+  long get(long key) const { return map.contains(key) ? 1 : 0; }
+
+  void put(long key, long value) { map.insert_or_assign(key, value); }
+
+  void remove(long key) { map.erase(key); }
+};
+
+unsigned long long next_random(unsigned long long &state) {
+  state ^= state << 13;
+  state ^= state >> 7;
+  state ^= state << 17;
+  return state;
+}
+
+template <typename Map>
+void run(const char *name, std::size_t n, std::size_t readers,
+         double seconds) {
+  Map map;
+  for (std::size_t i = 0; i < n; ++i) {
+    map.put(static_cast<long>(i), static_cast<long>(i));
+  }
+
+  std::atomic<bool> stop{false};
+  std::atomic<unsigned long long> lookups{0};
+  std::atomic<unsigned long long> found{0};
+  std::vector<std::thread> threads;
+  for (std::size_t t = 0; t < readers; ++t) {
+    threads.emplace_back([&, t] {
+      unsigned long long state = 88172645463325252ULL + t;
+      unsigned long long local = 0, hits = 0;
+      while (!stop.load(std::memory_order_relaxed)) {
+        for (int i = 0; i < 256; ++i) {
+          hits += map.get(static_cast<long>(next_random(state) % n));
+        }
+        local += 256;
+      }
+      lookups += local;
+      found += hits;
+    });
+  }
+  unsigned long long writes = 0;
+  std::thread writer([&] {
+    unsigned long long state = 2463534242ULL;
+    while (!stop.load(std::memory_order_relaxed)) {
+      long key = static_cast<long>(next_random(state) % n);
+      if (writes % 4 == 0) {
+        map.remove(key);
+      }
+      map.put(key, key);
+      ++writes;
+    }
+  });
+
+  std::this_thread::sleep_for(std::chrono::duration<double>(seconds));
+  stop.store(true);
+  for (std::thread &thread : threads) {
+    thread.join();
+  }
+  writer.join();
+  std::cout << name << '\t' << readers << '\t'
+            << lookups.load() / seconds / 1e6 << '\t' << writes << '\n';
+  sink += found.load();
+}
+
+}  // namespace
+
+int main(int argc, char **argv) {
+  std::size_t n = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 1000000;
+  std::size_t max_readers = argc > 2 ? std::strtoul(argv[2], nullptr, 10)
+                                     : std::thread::hardware_concurrency();
+  double seconds = argc > 3 ? std::strtod(argv[3], nullptr) : 1.0;
+  max_readers = std::max<std::size_t>(max_readers, 1);
+
+  std::cout << "one writer and N readers on " << n << " keys\n";
+  std::cout << "map\treaders\tMlookups/s\twrites\n";
+  std::vector<std::size_t> reader_counts;
+  for (std::size_t readers = 1; readers < max_readers; readers *= 2) {
+    reader_counts.push_back(readers);
+  }
+  reader_counts.push_back(max_readers);
+
+  for (std::size_t readers : reader_counts) {
+    run<LockedMap>("shared_mutex", n, readers, seconds);
+    run<LockFreeMap>("concurrent", n, readers, seconds);
+  }
+  return 0;
+}
@@ -0,0 +1,89 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <numeric>
+#include <vector>
+
+#include "../containers/s21_set.h"
+
+// Batched membership tests against a set larger than the caches: a loop of
+// find() against contains_many(), which interleaves the descents and
+// prefetches. Half of the probed keys are present. Reported in million
+// lookups per second.
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+template <typename F>
+double measure(F &&f) {
+  auto start = Clock::now();
+  f();
+  return std::chrono::duration<double>(Clock::now() - start).count();
+}
+
+unsigned long long next_random(unsigned long long &state) {
+  state ^= state << 13;
+  state ^= state >> 7;
+  state ^= state << 17;
+  return state;
+}
+
+volatile std::size_t sink = 0;
+
+}  // namespace
+
+int main(int argc, char **argv) {
+  std::size_t n = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 4000000;
+  std::size_t batch = argc > 2 ? std::strtoul(argv[2], nullptr, 10) : 4096;
+  std::size_t lookups = argc > 3 ? std::strtoul(argv[3], nullptr, 10)
+                                 : 4000000;
+
+  // Inserted in random order so that neighbouring keys sit in unrelated
+  // places in memory
+  std::vector<long> values(n);
+  std::iota(values.begin(), values.end(), 0L);
+  unsigned long long state = 88172645463325252ULL;
+  for (std::size_t i = n; i > 1; --i) {
+    std::swap(values[i - 1], values[next_random(state) % i]);
+  }
+  s21::set<long> numbers;
+  for (long value : values) {
+    numbers.insert(value * 2);
+  }
+
+  std::vector<long> keys(lookups);
+  for (long &key : keys) {
+    key = static_cast<long>(next_random(state) % (2 * n));
+  }
+
+  std::size_t loop_hits = 0, batch_hits = 0;
+  double loop = measure([&] {
+    for (long key : keys) {
+      loop_hits += numbers.find(key) != numbers.end() ? 1 : 0;
+    }
+  });
+  double batched = measure([&] {
+    std::vector<long> chunk;
+    std::vector<bool> present;
+    for (std::size_t i = 0; i < lookups; i += batch) {
+      chunk.assign(keys.begin() + i,
+                   keys.begin() + std::min(lookups, i + batch));
+      numbers.contains_many(chunk, present);
+      batch_hits += std::count(present.begin(), present.end(), true);
+    }
+  });
+  sink += loop_hits + batch_hits;
+
+  std::cout << n << " keys, " << lookups << " lookups in batches of "
+            << batch << "\n";
+  std::cout << "find loop\t" << lookups / loop / 1e6 << " Mlookups/s\n";
+  std::cout << "contains_many\t" << lookups / batched / 1e6
+            << " Mlookups/s\n";
+  if (loop_hits != batch_hits) {
+    std::cout << "hit counts differ\n";
+    return 1;
+  }
+  return 0;
+}
@@ -0,0 +1,106 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+
+#include "../containers/s21_set.h"
+#include "../containersplus/s21_frozen_set.h"
+
+// Membership tests on uint64_t keys: the AVL tree behind s21::set, one by
+// one and batched, std::lower_bound over a sorted std::vector, and
+// frozen_set, one by one and batched (AVX2 gathers where available). Half
+// of the probed keys are present. Reported in million lookups per second.
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+template <typename F>
+double measure(F &&f) {
+  auto start = Clock::now();
+  f();
+  return std::chrono::duration<double>(Clock::now() - start).count();
+}
+
+unsigned long long next_random(unsigned long long &state) {
+  state ^= state << 13;
+  state ^= state >> 7;
+  state ^= state << 17;
+  return state;
+}
+
+volatile std::size_t sink = 0;
+
+}  // namespace
+
+int main(int argc, char **argv) {
+  std::size_t n = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 4000000;
+  std::size_t lookups = argc > 2 ? std::strtoul(argv[2], nullptr, 10)
+                                 : 4000000;
+  std::size_t batch = 4096;
+
+  unsigned long long state = 88172645463325252ULL;
+  std::vector<uint64_t> stored(n);
+  for (uint64_t &key : stored) {
+    key = next_random(state);
+  }
+  s21::set<uint64_t> tree(stored.begin(), stored.end());
+  std::sort(stored.begin(), stored.end());
+  stored.erase(std::unique(stored.begin(), stored.end()), stored.end());
+  s21::frozen_set<uint64_t> frozen(tree.begin(), tree.end());
+
+  std::vector<uint64_t> keys(lookups);
+  for (uint64_t &key : keys) {
+    key = next_random(state) % 2 == 0 ? stored[next_random(state) % n]
+                                      : next_random(state);
+  }
+
+  auto batched = [&](auto &container, std::size_t &hits) {
+    std::vector<uint64_t> chunk;
+    std::vector<bool> present;
+    for (std::size_t i = 0; i < lookups; i += batch) {
+      chunk.assign(keys.begin() + i,
+                   keys.begin() + std::min(lookups, i + batch));
+      container.contains_many(chunk, present);
+      hits += std::count(present.begin(), present.end(), true);
+    }
+  };
+
+  std::size_t hits[5] = {0, 0, 0, 0, 0};
+  double times[5];
+  times[0] = measure([&] {
+    for (uint64_t key : keys) {
+      hits[0] += tree.find(key) != tree.end() ? 1 : 0;
+    }
+  });
+  times[1] = measure([&] { batched(tree, hits[1]); });
+  times[2] = measure([&] {
+    for (uint64_t key : keys) {
+      auto it = std::lower_bound(stored.begin(), stored.end(), key);
+      hits[2] += it != stored.end() && *it == key ? 1 : 0;
+    }
+  });
+  times[3] = measure([&] {
+    for (uint64_t key : keys) {
+      hits[3] += frozen.contains(key) ? 1 : 0;
+    }
+  });
+  times[4] = measure([&] { batched(frozen, hits[4]); });
+
+  const char *names[5] = {"set::find", "set::contains_many",
+                          "std::lower_bound", "frozen_set::contains",
+                          "frozen_set::contains_many"};
+  std::cout << stored.size() << " keys, " << lookups << " lookups\n";
+  for (int i = 0; i < 5; ++i) {
+    sink += hits[i];
+    std::cout << names[i] << "\t" << lookups / times[i] / 1e6
+              << " Mlookups/s\n";
+    if (hits[i] != hits[0]) {
+      std::cout << "hit counts differ\n";
+      return 1;
+    }
+  }
+  return 0;
+}
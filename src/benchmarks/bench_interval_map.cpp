@@ -0,0 +1,79 @@
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <utility>
+
+#include "../containersplus/s21_interval_map.h"
+#include "../containersplus/s21_multiset.h"
+
+// Stabbing queries ("which intervals contain t") over n validity
+// intervals: a scan of an s21::multiset of (start, end) pairs against
+// s21::interval_map. Reported in microseconds per query.
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+template <typename F>
+double measure(F &&f) {
+  auto start = Clock::now();
+  f();
+  return std::chrono::duration<double, std::micro>(Clock::now() - start)
+      .count();
+}
+
+unsigned long long next_random(unsigned long long &state) {
+  state ^= state << 13;
+  state ^= state >> 7;
+  state ^= state << 17;
+  return state;
+}
+
+volatile std::size_t sink = 0;
+
+}  // namespace
+
+int main(int argc, char **argv) {
+  std::size_t n = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 1000000;
+  std::size_t queries = argc > 2 ? std::strtoul(argv[2], nullptr, 10) : 100;
+  long horizon = 1000000000L;
+  long max_length = horizon / static_cast<long>(n) * 8;
+
+  s21::multiset<std::pair<long, long>> scanned;
+  s21::interval_map<std::pair<long, long>, std::size_t> tree;
+  unsigned long long state = 88172645463325252ULL;
+  for (std::size_t i = 0; i < n; ++i) {
+    long start = static_cast<long>(next_random(state) % horizon);
+    long length = 1 + static_cast<long>(next_random(state) % max_length);
+    scanned.insert({start, start + length});
+    tree.insert({start, start + length}, i);
+  }
+
+  std::size_t scan_hits = 0, tree_hits = 0;
+  unsigned long long scan_state = state, tree_state = state;
+  double scan = measure([&] {
+    for (std::size_t q = 0; q < queries; ++q) {
+      long t = static_cast<long>(next_random(scan_state) % horizon);
+      for (const auto &span : scanned) {
+        scan_hits += span.first <= t && t < span.second ? 1 : 0;
+      }
+    }
+  });
+  double indexed = measure([&] {
+    for (std::size_t q = 0; q < queries; ++q) {
+      long t = static_cast<long>(next_random(tree_state) % horizon);
+      tree_hits += tree.count_containing(t);
+    }
+  });
+  sink += scan_hits + tree_hits;
+
+  std::cout << n << " intervals, " << queries << " stabbing queries, "
+            << static_cast<double>(tree_hits) / queries << " hits each\n";
+  std::cout << "multiset scan\t" << scan / queries << " us/query\n";
+  std::cout << "interval_map\t" << indexed / queries << " us/query\n";
+  if (scan_hits != tree_hits) {
+    std::cout << "hit counts differ\n";
+    return 1;
+  }
+  return 0;
+}
@@ -0,0 +1,110 @@
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <map>
+#include <vector>
+
+#include "../Tree/node_pool.h"
+#include "../containers/s21_map.h"
+
+// Compares the slab node pool used by Tree with plain per-node new/delete:
+// first on raw node allocation, then on the build-query-drop pattern of
+// short-lived maps.
+
+namespace {
+
+struct BenchNode {
+  long key;
+  long value;
+  BenchNode *parent;
+  BenchNode *left;
+  BenchNode *right;
+  int height;
+  std::size_t size;
+
+  BenchNode(long k, long v)
+      : key(k),
+        value(v),
+        parent(nullptr),
+        left(nullptr),
+        right(nullptr),
+        height(0),
+        size(1) {}
+};
+
+using Clock = std::chrono::steady_clock;
+
+template <typename F>
+double measure(F &&f) {
+  auto start = Clock::now();
+  f();
+  return std::chrono::duration<double, std::milli>(Clock::now() - start)
+      .count();
+}
+
+volatile long sink = 0;
+
+}  // namespace
+
+int main(int argc, char **argv) {
+  std::size_t n = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 1000;
+  int rounds = argc > 2 ? std::atoi(argv[2]) : 2000;
+
+  std::vector<BenchNode *> nodes(n);
+
+  double new_delete = measure([&] {
+    for (int r = 0; r < rounds; ++r) {
+      for (std::size_t i = 0; i < n; ++i) {
+        nodes[i] = new BenchNode(i, r);
+      }
+      for (std::size_t i = 0; i < n; ++i) {
+        sink += nodes[i]->key;
+        delete nodes[i];
+      }
+    }
+  });
+
+  double pooled = measure([&] {
+    for (int r = 0; r < rounds; ++r) {
+      s21::NodePool<BenchNode> pool;
+      for (std::size_t i = 0; i < n; ++i) {
+        nodes[i] = pool.create(i, r);
+      }
+      for (std::size_t i = 0; i < n; ++i) {
+        sink += nodes[i]->key;
+      }
+      pool.release();
+    }
+  });
+
+  std::cout << "node allocation, " << n << " nodes x " << rounds
+            << " rounds\n";
+  std::cout << "  new/delete per node: " << new_delete << " ms\n";
+  std::cout << "  NodePool + release:  " << pooled << " ms\n";
+
+  double std_map = measure([&] {
+    for (int r = 0; r < rounds; ++r) {
+      std::map<long, long> m;
+      for (std::size_t i = 0; i < n; ++i) {
+        m.insert({static_cast<long>((i * 7919) % n), r});
+      }
+      sink += m.find(static_cast<long>(n / 2))->second;
+    }
+  });
+
+  double s21_map = measure([&] {
+    for (int r = 0; r < rounds; ++r) {
+      s21::map<long, long> m;
+      for (std::size_t i = 0; i < n; ++i) {
+        m.insert({static_cast<long>((i * 7919) % n), r});
+      }
+      sink += m.at(static_cast<long>(n / 2));
+    }
+  });
+
+  std::cout << "build, query and drop a map of " << n << " entries x "
+            << rounds << " rounds\n";
+  std::cout << "  std::map (new/delete per node): " << std_map << " ms\n";
+  std::cout << "  s21::map (NodePool):            " << s21_map << " ms\n";
+  return 0;
+}
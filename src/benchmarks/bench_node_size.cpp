@@ -0,0 +1,63 @@
+#include <cstdlib>
+#include <iostream>
+#include <string>
+
+#include "../containers/s21_map.h"
+#include "../containers/s21_set.h"
+#include "../containersplus/s21_multiset.h"
+
+// Memory per element of the Tree based containers: the node size and the
+// bytes the node pool actually holds divided by the number of elements.
+
+namespace {
+
+// Reaches the pool and node type that Tree keeps protected
+template <typename Container, typename Base>
+struct Probe : Container {
+  static constexpr std::size_t node_bytes = sizeof(typename Base::Node);
+
+  std::size_t pool_bytes() const {
+    return this->pool ? this->pool->allocatedBytes() : 0;
+  }
+};
+
+template <typename Probe, typename Fill>
+void report(const std::string &name, std::size_t n, Fill fill) {
+  Probe container;
+  fill(container, n);
+  std::cout << name << '\t' << Probe::node_bytes << '\t'
+            << static_cast<double>(container.pool_bytes()) / container.size()
+            << '\n';
+}
+
+}  // namespace
+
+int main(int argc, char **argv) {
+  std::size_t n = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 1000000;
+
+  std::cout << "container\tnode bytes\tbytes per element (" << n
+            << " elements)\n";
+  auto fill_keys = [](auto &container, std::size_t count) {
+    for (std::size_t i = 0; i < count; ++i) {
+      container.insert(static_cast<long>(i * 7 % count));
+    }
+  };
+  report<Probe<s21::set<long>, s21::Tree<long, s21::TreeNoValue>>>(
+      "set<long>", n, fill_keys);
+  report<Probe<s21::multiset<long>, s21::Tree<long, s21::TreeNoValue>>>(
+      "multiset<long>", n, fill_keys);
+  report<Probe<s21::set<int>, s21::Tree<int, s21::TreeNoValue>>>(
+      "set<int>", n, [](auto &container, std::size_t count) {
+        for (std::size_t i = 0; i < count; ++i) {
+          container.insert(static_cast<int>(i));
+        }
+      });
+  report<Probe<s21::map<long, long>, s21::Tree<long, long>>>(
+      "map<long, long>", n, [](auto &container, std::size_t count) {
+        for (std::size_t i = 0; i < count; ++i) {
+          long key = static_cast<long>(i * 7 % count);
+          container.insert({key, key});
+        }
+      });
+  return 0;
+}
@@ -0,0 +1,70 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+#include "../containers/s21_set.h"
+
+// Scaling of the fork-join set operations from one thread up to all
+// hardware threads. Inputs are rebuilt for every run because the
+// operations drain their argument.
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+volatile std::size_t sink = 0;
+
+template <typename Op>
+double run(const std::vector<long> &a, const std::vector<long> &b,
+           std::size_t threads, Op op) {
+  s21::set<long> left(a.begin(), a.end());
+  s21::set<long> right(b.begin(), b.end());
+  s21::ThreadPool workers(threads);
+  auto start = Clock::now();
+  op(left, right, workers);
+  double elapsed =
+      std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+  sink += left.size();
+  return elapsed;
+}
+
+}  // namespace
+
+int main(int argc, char **argv) {
+  std::size_t n = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 2000000;
+  std::size_t max_threads = argc > 2 ? std::strtoul(argv[2], nullptr, 10)
+                                     : std::thread::hardware_concurrency();
+  max_threads = std::max<std::size_t>(max_threads, 1);
+
+  std::vector<long> a(n), b(n);
+  for (std::size_t i = 0; i < n; ++i) {
+    a[i] = static_cast<long>(i) * 2;
+    b[i] = static_cast<long>(i) * 3;
+  }
+
+  std::cout << "set operations on two sets of " << n << " keys\n";
+  std::cout << "threads\tunion ms\tintersection ms\tdifference ms\n";
+  std::vector<std::size_t> thread_counts;
+  for (std::size_t threads = 1; threads < max_threads; threads *= 2) {
+    thread_counts.push_back(threads);
+  }
+  thread_counts.push_back(max_threads);
+
+  for (std::size_t threads : thread_counts) {
+    double union_ms = run(a, b, threads, [](auto &l, auto &r, auto &w) {
+      l.set_union(r, w);
+    });
+    double intersection_ms =
+        run(a, b, threads,
+            [](auto &l, auto &r, auto &w) { l.set_intersection(r, w); });
+    double difference_ms = run(a, b, threads, [](auto &l, auto &r, auto &w) {
+      l.set_difference(r, w);
+    });
+    std::cout << threads << '\t' << union_ms << '\t' << intersection_ms
+              << '\t' << difference_ms << '\n';
+  }
+  return 0;
+}
@@ -0,0 +1,96 @@
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "../containers/s21_map.h"
+#include "../containersplus/s21_frozen_map.h"
+
+// Start-up cost of a large map: parsing it from text and inserting every
+// pair, against mapping a snapshot written by save_snapshot(). The first
+// lookups after opening are timed too, since they pay the page faults the
+// open itself skips. The image stays in the page cache, so this is the
+// cost of a restart rather than of a first read from disk.
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+template <typename F>
+double measure(F &&f) {
+  auto start = Clock::now();
+  f();
+  return std::chrono::duration<double>(Clock::now() - start).count();
+}
+
+unsigned long long next_random(unsigned long long &state) {
+  state ^= state << 13;
+  state ^= state >> 7;
+  state ^= state << 17;
+  return state;
+}
+
+volatile long sink = 0;
+
+}  // namespace
+
+int main(int argc, char **argv) {
+  std::size_t n = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 4000000;
+  std::size_t lookups = argc > 2 ? std::strtoul(argv[2], nullptr, 10)
+                                 : 1000000;
+  std::string path = argc > 3 ? argv[3] : "bench_snapshot.bin";
+
+  unsigned long long state = 88172645463325252ULL;
+  std::string text;
+  for (std::size_t i = 0; i < n; ++i) {
+    text += std::to_string(next_random(state) % (4 * n)) + ' ' +
+            std::to_string(i) + '\n';
+  }
+  std::vector<long> keys(lookups);
+  for (long &key : keys) {
+    key = static_cast<long>(next_random(state) % (4 * n));
+  }
+
+  s21::map<long, long> parsed;
+  double rebuild = measure([&] {
+    const char *cursor = text.c_str();
+    char *end = nullptr;
+    for (std::size_t i = 0; i < n; ++i) {
+      long key = std::strtol(cursor, &end, 10);
+      long value = std::strtol(end, &end, 10);
+      parsed.insert(key, value);
+      cursor = end;
+    }
+  });
+  double save = measure([&] { save_snapshot(parsed, path); });
+
+  s21::frozen_map<long, long> frozen;
+  double open = measure([&] { frozen = s21::frozen_map<long, long>(path); });
+  long found = 0;
+  double first = measure([&] {
+    for (long key : keys) {
+      auto it = frozen.find(key);
+      found += it != frozen.end() ? (*it).second : 0;
+    }
+  });
+  long expected = 0;
+  for (long key : keys) {
+    auto it = parsed.find(key);
+    expected += it != parsed.end() ? it->second : 0;
+  }
+  sink += found;
+  std::remove(path.c_str());
+
+  std::cout << parsed.size() << " pairs, " << lookups << " lookups\n";
+  std::cout << "parse and insert\t" << rebuild * 1e3 << " ms\n";
+  std::cout << "save_snapshot\t" << save * 1e3 << " ms\n";
+  std::cout << "open frozen_map\t" << open * 1e3 << " ms\n";
+  std::cout << "first lookups\t" << first * 1e3 << " ms\n";
+  if (found != expected) {
+    std::cout << "lookups differ\n";
+    return 1;
+  }
+  return 0;
+}
@@ -0,0 +1,84 @@
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <unordered_map>
+#include <vector>
+
+#include "../containers/s21_map.h"
+#include "../containersplus/s21_unordered_map.h"
+
+// Key-value cache workload on s21::map, std::unordered_map and the Swiss
+// table s21::unordered_map: random inserts, lookups that hit, lookups that
+// miss and erases, reported in ns per operation.
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+template <typename F>
+double measure(F &&f) {
+  auto start = Clock::now();
+  f();
+  return std::chrono::duration<double, std::milli>(Clock::now() - start)
+      .count();
+}
+
+volatile long sink = 0;
+
+std::vector<long> random_keys(std::size_t n, unsigned long long seed) {
+  std::vector<long> keys(n);
+  for (std::size_t i = 0; i < n; ++i) {
+    seed ^= seed << 13;
+    seed ^= seed >> 7;
+    seed ^= seed << 17;
+    keys[i] = static_cast<long>(seed >> 1);
+  }
+  return keys;
+}
+
+template <typename Map>
+void run(const char *name, const std::vector<long> &keys,
+         const std::vector<long> &misses) {
+  Map map;
+  double insert_ms = measure([&] {
+    for (long key : keys) {
+      map.insert({key, key});
+    }
+  });
+  double hit_ms = measure([&] {
+    for (long key : keys) {
+      sink += map.at(key);
+    }
+  });
+  double miss_ms = measure([&] {
+    for (long key : misses) {
+      sink += map.count(key);
+    }
+  });
+  double erase_ms = measure([&] {
+    for (long key : keys) {
+      sink += map.erase(key);
+    }
+  });
+  double n = static_cast<double>(keys.size());
+  std::cout << "  " << name << "\t" << insert_ms * 1e6 / n << "\t"
+            << hit_ms * 1e6 / n << "\t" << miss_ms * 1e6 / n << "\t"
+            << erase_ms * 1e6 / n << '\n';
+}
+
+}  // namespace
+
+int main(int argc, char **argv) {
+  std::size_t n = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 1000000;
+
+  for (std::size_t size = 1000; size <= n; size *= 10) {
+    std::vector<long> keys = random_keys(size, 88172645463325252ULL);
+    std::vector<long> misses = random_keys(size, 1181783497276652981ULL);
+    std::cout << size << " keys, ns per operation\n";
+    std::cout << "  container\t\tinsert\thit\tmiss\terase\n";
+    run<s21::map<long, long>>("s21::map\t", keys, misses);
+    run<std::unordered_map<long, long>>("std::unordered_map", keys, misses);
+    run<s21::unordered_map<long, long>>("s21::unordered_map", keys, misses);
+  }
+  return 0;
+}
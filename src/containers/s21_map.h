@@ -2,25 +2,41 @@
 #define __S21_MAP_H__
 
 #include <iostream>
+#include <iterator>
 #include <limits>
+#include <type_traits>
+#include <vector>
 
 #include "../Tree/tree.h"
 
 namespace s21 {
 
-template <typename Key, typename T>
-class map : public Tree<Key, T> {
+template <typename Key, typename T, typename Compare = std::less<Key>,
+          typename Stats = TreeNoStats>
+class map : public Tree<Key, T, Compare, TreeNoAggregate, Stats> {
+  using Base = Tree<Key, T, Compare, TreeNoAggregate, Stats>;
+
  public:
-  using Tree<Key, T>::root;
-  using typename Tree<Key, T>::Node;
-  using Tree<Key, T>::insertTree;
-  using Tree<Key, T>::printTree;
-  using Tree<Key, T>::findInTree;
-  using Tree<Key, T>::getSize;
-  using Tree<Key, T>::deleteTree;
-  using Tree<Key, T>::erase;
-  using Tree<Key, T>::copyTree;
-  using Tree<Key, T>::assign;
+  using Base::root;
+  using typename Base::Node;
+  using typename Base::SetOperation;
+  using Base::applySetOperation;
+  using Base::printTree;
+  using Base::findInTree;
+  using Base::getSize;
+  using Base::nthNode;
+  using Base::countLess;
+  using Base::countLessOrEqual;
+  using Base::countRange;
+  using Base::deleteTree;
+  using Base::createNode;
+  using Base::clearTree;
+  using Base::moveTree;
+  using Base::nodeOrEnd;
+  using Base::eraseKey;
+  using Base::erase;
+  using Base::copyTree;
+  using Base::isSortedRange;
 
   // Map Member type
   using key_type = Key;
@@ -29,101 +45,91 @@ class map : public Tree<Key, T> {
   using reference = value_type &;
   using size_type = size_t;
   using const_reference = const value_type &;
+  using key_compare = Compare;
+  using stats_type = TreeStats;
+  using node_type = typename Base::NodeHandle;
 
-  // Map Member functions
-  map() : Tree<Key, T>() {}
+  // Overloads templated on K take any key type the comparator can order
+  // against Key, they exist only for transparent comparators
+  template <typename K>
+  using if_transparent =
+      std::enable_if_t<is_transparent<Compare>::value && sizeof(K) != 0>;
 
-  map(std::initializer_list<value_type> const &items) {
-    for (const value_type &value : items) {
-      insert(value);
-      // this->insert(value);
+  // Map Member functions
+  map() : Base() {}
+
+  map(std::initializer_list<value_type> const &items)
+      : map(items.begin(), items.end()) {}
+
+  // Sorted forward ranges are built in O(n), anything else goes through
+  // insert one by one
+  template <typename InputIt, typename = typename std::iterator_traits<
+                                  InputIt>::iterator_category>
+  map(InputIt first, InputIt last) {
+    using category = typename std::iterator_traits<InputIt>::iterator_category;
+    using item = typename std::iterator_traits<InputIt>::value_type;
+    using item_key = std::remove_const_t<typename item::first_type>;
+    if constexpr (std::is_base_of_v<std::forward_iterator_tag, category> &&
+                  std::is_same_v<item_key, Key>) {
+      auto key_of = [](const auto &v) -> const Key &{ return v.first; };
+      if (isSortedRange(first, last, true, key_of)) {
+        this->build_from_sorted(first, last);
+        return;
+      }
+    }
+    for (; first != last; ++first) {
+      insert(*first);
     }
   }
 
-  map(const map &other) : Tree<Key, T>(other){};
+  map(const map &other) : Base(other){};
 
-  map(map &&other) noexcept : Tree<Key, T>(std::move(other)){};
+  map(map &&other) noexcept : Base(std::move(other)){};
 
   ~map() {}
 
   map &operator=(map &&m) {
     if (this != &m) {
-      // this->clear();
-      deleteTree(root);
-      root = m.root;
-      m.root = nullptr;
+      moveTree(m);
     }
     return *this;
   }
 
   // Map Element access
 
-  T &at(const Key &key) {
-    Node *current = root;
+  T &at(const Key &key) { return valueAt(findInTree(root, key)); }
 
-    while (current != nullptr) {
-      if (key == current->key) {
-        return current->value;
-      }
-      if (key < current->key) {
-        current = current->left;
-      } else {
-        current = current->right;
-      }
-    }
-    throw std::out_of_range("Not found key");
+  template <typename K, typename = if_transparent<K>>
+  T &at(const K &key) {
+    return valueAt(findInTree(root, key));
   }
 
-  T &operator[](const Key &key) {
-    Node *node = findInTree(root, key);
-    if (node == nullptr) {
-      Node *newNode = new Node(std::make_pair(key, T()));
-      root = insertTree(root, newNode);
-      return newNode->value;
-    } else {
-      return node->value;
-    }
+  T &operator[](const Key &key) { return findOrInsert(key); }
+
+  template <typename K, typename = if_transparent<K>>
+  T &operator[](const K &key) {
+    return findOrInsert(key);
   }
 
   // Map Iterators
 
   class MapIterator {
    public:
+    using iterator_category = std::bidirectional_iterator_tag;
+    using value_type = std::pair<const Key, T>;
+    using difference_type = std::ptrdiff_t;
+    using pointer = value_type *;
+    using reference = value_type &;
+
     Node *current;
     MapIterator(Node *node) : current(node) {}
 
-    std::pair<const Key, T> operator*() {
-      return {current->key, current->value};
-    }
-
-    // reference operator*() {
-    //     return *reinterpret_cast<value_type*>(&current->key);
-    // }
-
-    std::pair<const Key, T> &operator->() {
-      return {current->key, current->value};
-    }
+    reference operator*() const { return current->data; }
 
-    // reference operator->() {
-    //     return *reinterpret_cast<value_type*>(&current->key);
-    // }
+    pointer operator->() const { return &current->data; }
 
     MapIterator &operator++() {
-      if (current != nullptr) {
-        if (current->right) {
-          current = current->right;
-          while (current->left) {
-            current = current->left;
-          }
-        } else {
-          Node *parent = current->parent;
-          while (parent && current == parent->right) {
-            current = parent;
-            parent = parent->parent;
-          }
-          current = parent;
-        }
-      }
+      current = Base::nextNode(current);
       return *this;
     }
 
@@ -135,21 +141,7 @@ class map : public Tree<Key, T> {
     }
 
     MapIterator &operator--() {
-      if (current != nullptr) {
-        if (current->left) {
-          current = current->left;
-          while (current->right) {
-            current = current->right;
-          }
-        } else {
-          Node *parent = current->parent;
-          while (parent && current == parent->left) {
-            current = parent;
-            parent = parent->parent;
-          }
-          current = parent;
-        }
-      }
+      current = Base::prevNode(current);
       return *this;
     }
 
@@ -169,28 +161,45 @@ class map : public Tree<Key, T> {
   };
 
   using iterator = MapIterator;
+  using reverse_iterator = std::reverse_iterator<iterator>;
 
-  iterator begin() {
-    Node *current = root;
-    while (current && current->left) {
-      current = current->left;
-    }
-    return iterator(current);
-  }
+  iterator begin() { return iterator(this->firstNode()); }
+
+  iterator end() { return iterator(this->endNode()); }
 
-  iterator end() { return iterator(nullptr); }
+  reverse_iterator rbegin() { return reverse_iterator(end()); }
+
+  reverse_iterator rend() { return reverse_iterator(begin()); }
 
   class MapConstIterator : public MapIterator {
    public:
     MapConstIterator(Node *node) : MapIterator(node) {}
 
-    const std::pair<const Key, T> operator*() {
-      return {this->current->key, this->current->value};
-    }
+    const_reference operator*() const { return this->current->data; }
+
+    const value_type *operator->() const { return &this->current->data; }
   };
 
   using const_iterator = MapConstIterator;
 
+  const_iterator begin() const { return const_iterator(this->firstNode()); }
+
+  const_iterator end() const { return const_iterator(this->endNode()); }
+
+  // erase(const K &) never takes the map's own iterators, like std::map,
+  // so erase(pos) with a const_iterator erases at pos
+  template <typename K>
+  using if_transparent_key =
+      std::enable_if_t<!std::is_convertible_v<const K &, iterator> &&
+                           !std::is_convertible_v<const K &, const_iterator>,
+                       if_transparent<K>>;
+
+  struct insert_return_type {
+    iterator position;
+    bool inserted;
+    node_type node;
+  };
+
   // Map Capacity
 
   bool empty() {
@@ -201,10 +210,7 @@ class map : public Tree<Key, T> {
     }
   }
 
-  size_type size() {
-    int count = 0;
-    return getSize(root, count);
-  }
+  size_type size() const { return getSize(root); }
 
   size_type max_size() {
     return std::numeric_limits<size_type>::max() / sizeof(Node);
@@ -212,101 +218,332 @@ class map : public Tree<Key, T> {
 
   // Map Modifiers
 
-  void clear() {
-    deleteTree(root);
-    root = nullptr;
-  }
+  void clear() { clearTree(); }
 
-  std::pair<iterator, bool> insert(const value_type &value) {
-    Node *pt = new Node(value);
+  // Inserts look the key up in one descent and build the node only when
+  // the key is absent, in place from the arguments
 
-    if (root == nullptr) {
-      root = pt;
-      return {iterator(pt), true};
-    }
-    Node *insertedNode = insertTree(root, pt);
+  std::pair<iterator, bool> insert(const value_type &value) {
+    return emplaceNode(value.first, value.first, value.second);
+  }
 
-    if (insertedNode == pt) {
-      return {iterator(pt), true};
-    } else {
-      return {iterator(insertedNode), false};
-    }
+  std::pair<iterator, bool> insert(value_type &&value) {
+    return emplaceNode(value.first, value.first, std::move(value.second));
   }
 
   std::pair<iterator, bool> insert(const Key &key, const T &obj) {
-    auto value = std::make_pair(key, obj);
-    Node *pt = new Node(value);
+    return emplaceNode(key, key, obj);
+  }
 
-    if (root == nullptr) {
-      root = pt;
-      return {iterator(pt), true};
-    }
-    Node *insertedNode = insertTree(root, pt);
+  // Inserts right before hint when that is where the key belongs, as when
+  // appending ascending keys with end() as hint, otherwise like insert.
+  // Returns the element with the key, new or already present.
+  iterator insert(iterator hint, const value_type &value) {
+    return emplaceNodeHint(hint, value.first, value.first, value.second);
+  }
 
-    if (insertedNode == pt) {
-      return {iterator(pt), true};
-    } else {
-      return {iterator(insertedNode), false};
-    }
+  iterator insert(iterator hint, value_type &&value) {
+    return emplaceNodeHint(hint, value.first, value.first,
+                           std::move(value.second));
   }
 
   std::pair<iterator, bool> insert_or_assign(const Key &key, const T &obj) {
-    auto value = std::make_pair(key, obj);
-    Node *pt = new Node(value);
-
-    if (root == nullptr) {
-      root = pt;
-      return {iterator(pt), true};
+    auto result = emplaceNode(key, key, obj);
+    if (!result.second) {
+      result.first.current->value() = obj;
     }
+    return result;
+  }
 
-    Node *exNode = findInTree(root, key);
-    if (exNode) {
-      // exNode->value = obj;
-      assign(root, obj);
-      return {iterator(exNode), false};
+  std::pair<iterator, bool> insert_or_assign(const Key &key, T &&obj) {
+    auto result = emplaceNode(key, key, std::move(obj));
+    if (!result.second) {
+      result.first.current->value() = std::move(obj);
     }
+    return result;
+  }
+
+  // The pair is built first to learn its key, then moved into the node
+  template <typename... Args>
+  std::pair<iterator, bool> emplace(Args &&...args) {
+    std::pair<Key, T> item(std::forward<Args>(args)...);
+    return emplaceNode(item.first, std::move(item.first),
+                       std::move(item.second));
+  }
 
-    Node *insertedNode = insertTree(root, pt);
-    return {iterator(pt), true};
+  template <typename... Args>
+  iterator emplace_hint(iterator hint, Args &&...args) {
+    std::pair<Key, T> item(std::forward<Args>(args)...);
+    return emplaceNodeHint(hint, item.first, std::move(item.first),
+                           std::move(item.second));
   }
 
-  void erase(iterator pos) {
-    if (pos.current != nullptr) {
-      root = erase(root, pos.current->key);
+  // Builds the value from args only when key is absent
+  template <typename... Args>
+  std::pair<iterator, bool> try_emplace(const Key &key, Args &&...args) {
+    return emplaceNode(key, key, std::forward<Args>(args)...);
+  }
+
+  template <typename... Args>
+  std::pair<iterator, bool> try_emplace(Key &&key, Args &&...args) {
+    return emplaceNode(key, std::move(key), std::forward<Args>(args)...);
+  }
+
+  // Unlinks the node of pos without searching for it again and returns
+  // the element after it
+  iterator erase(iterator pos) {
+    if (pos == end()) {
+      return end();
     }
+    return iterator(this->eraseNode(pos.current));
   }
 
-  void swap(map &other) {
-    Node *tmp = this->root;
-    this->root = copyTree(other.root);
-    other.root = copyTree(tmp);
+  // Erases [first, last) in O(log n + k) and returns last
+  iterator erase(iterator first, iterator last) {
+    this->eraseRange(first.current, last.current);
+    return last;
   }
 
-  void merge(map &other) {
-    for (auto iter{other.begin()}; iter != other.end(); ++iter) {
-      Node *pt = new Node(*iter);
-      root = insertTree(root, pt);
+  size_type erase(const Key &key) { return eraseAll(key); }
+
+  template <typename K, typename = if_transparent_key<K>>
+  size_type erase(const K &key) {
+    return eraseAll(key);
+  }
+
+  // Node handles move elements between maps. insert() relinks the node
+  // into any map without a copy, the map keeps the slabs of the pool it
+  // came from alive. extract() unlinks an element, an empty handle means
+  // key was absent.
+  node_type extract(iterator pos) { return this->extractNode(pos.current); }
+
+  node_type extract(const Key &key) {
+    Node *node = findInTree(root, key);
+    return node == nullptr ? node_type() : this->extractNode(node);
+  }
+
+  // Links the node of nh in. When its key is already present nh keeps the
+  // node and comes back in node, position points to the equal element.
+  insert_return_type insert(node_type &&nh) {
+    if (nh.empty()) {
+      return {end(), false, node_type()};
     }
+    auto result = this->insertHandle(nh, true);
+    return {iterator(result.first), result.second, std::move(nh)};
+  }
+
+  void swap(map &other) { this->swapTree(other); }
+
+  // Relinks the nodes whose keys are missing here out of other, the rest
+  // stays in other. No node is allocated or copied.
+  void merge(map &other) { this->spliceFrom(other, true); }
+
+  // Map Algebra on keys. On equal keys the values of this map are kept.
+  // other is drained: its nodes are moved into this map or destroyed. The
+  // overloads taking a ThreadPool process independent subtrees in parallel.
+
+  void set_union(map &other) {
+    applySetOperation(other, SetOperation::Union, true);
+  }
+
+  void set_union(map &other, ThreadPool &workers) {
+    applySetOperation(other, SetOperation::Union, true, workers);
+  }
+
+  void set_intersection(map &other) {
+    applySetOperation(other, SetOperation::Intersection, true);
+  }
+
+  void set_intersection(map &other, ThreadPool &workers) {
+    applySetOperation(other, SetOperation::Intersection, true, workers);
+  }
+
+  void set_difference(map &other) {
+    applySetOperation(other, SetOperation::Difference, true);
+  }
+
+  void set_difference(map &other, ThreadPool &workers) {
+    applySetOperation(other, SetOperation::Difference, true, workers);
+  }
+
+  void set_symmetric_difference(map &other) {
+    applySetOperation(other, SetOperation::SymmetricDifference, true);
+  }
+
+  void set_symmetric_difference(map &other, ThreadPool &workers) {
+    applySetOperation(other, SetOperation::SymmetricDifference, true, workers);
   }
 
   // Map Lookup
 
-  bool contains(const Key &key) {
-    Node *current = root;
-    while (current != nullptr) {
-      if (current->key == key) {
-        return true;
-      }
-      if (key < current->key) {
-        current = current->left;
-      } else {
-        current = current->right;
+  iterator find(const Key &key) {
+    return iterator(nodeOrEnd(findInTree(root, key)));
+  }
+
+  template <typename K, typename = if_transparent<K>>
+  iterator find(const K &key) {
+    return iterator(nodeOrEnd(findInTree(root, key)));
+  }
+
+  bool contains(const Key &key) { return findInTree(root, key) != nullptr; }
+
+  template <typename K, typename = if_transparent<K>>
+  bool contains(const K &key) {
+    return findInTree(root, key) != nullptr;
+  }
+
+  // Batched lookups, out[i] is find(keys[i]). keys is any indexable
+  // container of keys, such as a std::vector. Several descents run
+  // interleaved with the next node prefetched, so a large batch costs far
+  // less than a loop of find() on a tree that does not fit in cache.
+  template <typename Keys>
+  void find_many(const Keys &keys, std::vector<iterator> &out) {
+    out.assign(keys.size(), end());
+    this->findMany(keys, [&out](std::size_t i, Node *node) {
+      if (node != nullptr) {
+        out[i] = iterator(node);
       }
-    }
-    return false;
+    });
+  }
+
+  // out[i] tells whether the map holds keys[i]
+  template <typename Keys>
+  void contains_many(const Keys &keys, std::vector<bool> &out) {
+    out.assign(keys.size(), false);
+    this->findMany(keys, [&out](std::size_t i, Node *node) {
+      out[i] = node != nullptr;
+    });
+  }
+
+  size_type count(const Key &key) { return contains(key) ? 1 : 0; }
+
+  template <typename K, typename = if_transparent<K>>
+  size_type count(const K &key) {
+    return contains(key) ? 1 : 0;
+  }
+
+  std::pair<iterator, iterator> equal_range(const Key &key) {
+    return std::make_pair(lower_bound(key), upper_bound(key));
+  }
+
+  template <typename K, typename = if_transparent<K>>
+  std::pair<iterator, iterator> equal_range(const K &key) {
+    return std::make_pair(lower_bound(key), upper_bound(key));
+  }
+
+  // First element not less than key
+  iterator lower_bound(const Key &key) {
+    return iterator(nodeOrEnd(this->lowerBoundNode(root, key)));
+  }
+
+  template <typename K, typename = if_transparent<K>>
+  iterator lower_bound(const K &key) {
+    return iterator(nodeOrEnd(this->lowerBoundNode(root, key)));
   }
 
+  // First element greater than key
+  iterator upper_bound(const Key &key) {
+    return iterator(nodeOrEnd(this->upperBoundNode(root, key)));
+  }
+
+  template <typename K, typename = if_transparent<K>>
+  iterator upper_bound(const K &key) {
+    return iterator(nodeOrEnd(this->upperBoundNode(root, key)));
+  }
+
+  // Calls visit(key, value) for the elements with keys in [lo, hi) in key
+  // order, value may be changed. A visitor returning bool stops the walk
+  // by returning false. Costs one descent plus the elements visited.
+  template <typename Visit>
+  void for_each_in_range(const Key &lo, const Key &hi, Visit visit) {
+    this->visitRange(lo, hi, [&visit](Node *node) {
+      return Base::callVisitor(visit, node->key(), node->value());
+    });
+  }
+
+  template <typename K, typename Visit, typename = if_transparent<K>>
+  void for_each_in_range(const K &lo, const K &hi, Visit visit) {
+    this->visitRange(lo, hi, [&visit](Node *node) {
+      return Base::callVisitor(visit, node->key(), node->value());
+    });
+  }
+
+  key_compare key_comp() const { return this->comp; }
+
+  // Map Order statistics
+
+  iterator nth(size_type k) {
+    return iterator(nodeOrEnd(nthNode(root, k)));
+  }
+
+  size_type rank(const Key &key) { return countLess(root, key); }
+
+  template <typename K, typename = if_transparent<K>>
+  size_type rank(const K &key) {
+    return countLess(root, key);
+  }
+
+  size_type count_range(const Key &lo, const Key &hi) {
+    return countRange(root, lo, hi);
+  }
+
+  template <typename K, typename = if_transparent<K>>
+  size_type count_range(const K &lo, const K &hi) {
+    return countRange(root, lo, hi);
+  }
+
+  // Map Diagnostics
+
+  // Node count, height against the AVL bound, leaf depths and pool bytes,
+  // found by a walk over every node. Rotations and comparisons since the
+  // last reset_stats() are counted only when Stats is TreeCountStats.
+  stats_type stats() { return this->treeStats(); }
+
+  void reset_stats() { this->resetStats(); }
+
   void print() { printTree(root); }
+
+ private:
+  T &valueAt(Node *node) {
+    if (node == nullptr) {
+      throw std::out_of_range("Not found key");
+    }
+    return node->value();
+  }
+
+  // Single lookup, the key is only converted to Key when it is inserted
+  template <typename K>
+  T &findOrInsert(const K &key) {
+    return emplaceNode(key, key).first.current->value();
+  }
+
+  // key is read before the node is built from key_arg and value_args, so
+  // both may refer to the same object
+  template <typename K, typename KeyArg, typename... ValueArgs>
+  std::pair<iterator, bool> emplaceNode(const K &key, KeyArg &&key_arg,
+                                        ValueArgs &&...value_args) {
+    auto result = this->emplaceKey(key, true, std::piecewise_construct,
+                                   std::forward<KeyArg>(key_arg),
+                                   std::forward<ValueArgs>(value_args)...);
+    return {iterator(result.first), result.second};
+  }
+
+  template <typename K, typename KeyArg, typename... ValueArgs>
+  iterator emplaceNodeHint(iterator hint, const K &key, KeyArg &&key_arg,
+                           ValueArgs &&...value_args) {
+    return iterator(this->emplaceHint(hint.current, key, true,
+                                      std::piecewise_construct,
+                                      std::forward<KeyArg>(key_arg),
+                                      std::forward<ValueArgs>(value_args)...)
+                        .first);
+  }
+
+  template <typename K>
+  size_type eraseAll(const K &key) {
+    size_type before = size();
+    eraseKey(key);
+    return before - size();
+  }
 };
 }  // namespace s21
 
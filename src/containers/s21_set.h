@@ -2,50 +2,90 @@
 #define __S21_SET_H__
 
 #include <iostream>
+#include <iterator>
 #include <limits>
+#include <type_traits>
+#include <vector>
 
 #include "../Tree/tree.h"
 
 namespace s21 {
 
-template <typename Key>
-class set : public Tree<Key, Key> {
-  using Tree<Key, Key>::root;
-  using Tree<Key, Key>::insertTree;
-  using Tree<Key, Key>::printTree;
-  using Tree<Key, Key>::copyTree;
-  using Tree<Key, Key>::erase;
-  using Tree<Key, Key>::deleteTree;
-  using Tree<Key, Key>::getSize;
-  using typename Tree<Key, Key>::Node;
+template <typename Key, typename Compare = std::less<Key>,
+          typename Stats = TreeNoStats>
+class set : public Tree<Key, TreeNoValue, Compare, TreeNoAggregate, Stats> {
+  using Base = Tree<Key, TreeNoValue, Compare, TreeNoAggregate, Stats>;
+  using Base::root;
+  using Base::printTree;
+  using Base::copyTree;
+  using Base::isSortedRange;
+  using Base::erase;
+  using Base::deleteTree;
+  using Base::createNode;
+  using Base::clearTree;
+  using Base::moveTree;
+  using Base::nodeOrEnd;
+  using Base::eraseKey;
+  using Base::getSize;
+  using Base::nthNode;
+  using Base::countLess;
+  using Base::countRange;
+  using Base::findInTree;
+  using Base::lowerBoundNode;
+  using Base::upperBoundNode;
+  using typename Base::Node;
+  using typename Base::SetOperation;
+  using Base::applySetOperation;
 
   using key_type = Key;
   using value_type = Key;
   using reference = value_type &;
   using const_reference = const value_type &;
   using size_type = size_t;
+  using key_compare = Compare;
+  using stats_type = TreeStats;
 
- public:
-  set() : Tree<Key, Key>() {}
+  // Overloads templated on K take any key type the comparator can order
+  // against Key, they exist only for transparent comparators
+  template <typename K>
+  using if_transparent =
+      std::enable_if_t<is_transparent<Compare>::value && sizeof(K) != 0>;
 
-  set(std::initializer_list<value_type> const &items) {
-    for (const value_type &value : items) {
-      insert(value);
-      // this->insert(value);
+ public:
+  set() : Base() {}
+
+  set(std::initializer_list<value_type> const &items)
+      : set(items.begin(), items.end()) {}
+
+  // Sorted forward ranges are built in O(n), anything else goes through
+  // insert one by one
+  template <typename InputIt, typename = typename std::iterator_traits<
+                                  InputIt>::iterator_category>
+  set(InputIt first, InputIt last) {
+    using category = typename std::iterator_traits<InputIt>::iterator_category;
+    using item = typename std::iterator_traits<InputIt>::value_type;
+    if constexpr (std::is_base_of_v<std::forward_iterator_tag, category> &&
+                  std::is_same_v<item, Key>) {
+      auto key_of = [](const auto &v) -> const Key &{ return v; };
+      if (isSortedRange(first, last, true, key_of)) {
+        this->build_from_sorted(first, last);
+        return;
+      }
+    }
+    for (; first != last; ++first) {
+      insert(*first);
     }
   }
 
-  set(const set &s) : Tree<Key, Key>(s) {}
+  set(const set &s) : Base(s) {}
 
-  set(set &&s) noexcept : Tree<Key, Key>(std::move(s)) {}
+  set(set &&s) noexcept : Base(std::move(s)) {}
 
   ~set() {}
 
   set &operator=(set &&s) noexcept {
     if (this != &s) {
-      deleteTree(root);
-      root = s.root;
-      s.root = nullptr;
+      moveTree(s);
     }
     return *this;
   }
@@ -54,27 +94,19 @@ class set : public Tree<Key, Key> {
 
   class SetIterator {
    public:
+    using iterator_category = std::bidirectional_iterator_tag;
+    using value_type = Key;
+    using difference_type = std::ptrdiff_t;
+    using pointer = Key *;
+    using reference = Key &;
+
     Node *current;
     SetIterator(Node *node) : current(node) {}
 
-    reference operator*() { return current->key; }
+    reference operator*() { return current->data; }
 
     SetIterator &operator++() {
-      if (current != nullptr) {
-        if (current->right) {
-          current = current->right;
-          while (current->left) {
-            current = current->left;
-          }
-        } else {
-          Node *parent = current->parent;
-          while (parent && current == parent->right) {
-            current = parent;
-            parent = parent->parent;
-          }
-          current = parent;
-        }
-      }
+      current = Base::nextNode(current);
       return *this;
     }
 
@@ -86,21 +118,7 @@ class set : public Tree<Key, Key> {
     }
 
     SetIterator &operator--() {
-      if (current != nullptr) {
-        if (current->left) {
-          current = current->left;
-          while (current->right) {
-            current = current->right;
-          }
-        } else {
-          Node *parent = current->parent;
-          while (parent && current == parent->left) {
-            current = parent;
-            parent = parent->parent;
-          }
-          current = parent;
-        }
-      }
+      current = Base::prevNode(current);
       return *this;
     }
 
@@ -120,28 +138,45 @@ class set : public Tree<Key, Key> {
   };
 
   using iterator = SetIterator;
+  using reverse_iterator = std::reverse_iterator<iterator>;
 
-  iterator begin() {  // возвращает указатель на первый эл-нт контейнера, в
-                      // контексе set им является наименьший элемент
-    Node *current = root;
-    while (current && current->left) {
-      current =
-          current->left;  // наименьший эл-нт находится в самом низу левой ветви
-    }
-    return iterator(current);
-  }
+  iterator begin() { return iterator(this->firstNode()); }
+
+  iterator end() { return iterator(this->endNode()); }
+
+  reverse_iterator rbegin() { return reverse_iterator(end()); }
 
-  iterator end() { return iterator(nullptr); }
+  reverse_iterator rend() { return reverse_iterator(begin()); }
 
   class SetConstIterator : public SetIterator {
    public:
     SetConstIterator(Node *node) : SetIterator(node) {}
 
-    const_reference operator*() const { return this->current->key; }
+    const_reference operator*() const { return this->current->data; }
   };
 
   using const_iterator = SetConstIterator;
 
+  const_iterator begin() const { return const_iterator(this->firstNode()); }
+
+  const_iterator end() const { return const_iterator(this->endNode()); }
+
+  // erase(const K &) never takes the set's own iterators, like std::set,
+  // so erase(pos) with a const_iterator erases at pos
+  template <typename K>
+  using if_transparent_key =
+      std::enable_if_t<!std::is_convertible_v<const K &, iterator> &&
+                           !std::is_convertible_v<const K &, const_iterator>,
+                       if_transparent<K>>;
+
+  using node_type = typename Base::NodeHandle;
+
+  struct insert_return_type {
+    iterator position;
+    bool inserted;
+    node_type node;
+  };
+
   // Set Capacity
 
   bool empty() {
@@ -152,10 +187,7 @@ class set : public Tree<Key, Key> {
     }
   }
 
-  size_type size() {
-    int count = 0;
-    return getSize(root, count);
-  }
+  size_type size() const { return getSize(root); }
 
   size_type max_size() {
     return std::numeric_limits<size_type>::max() / sizeof(Key);
@@ -163,80 +195,264 @@ class set : public Tree<Key, Key> {
 
   // Set Modifiers
 
-  void clear() {
-    deleteTree(root);
-    root = nullptr;
-  }
+  void clear() { clearTree(); }
+
+  // Inserts look the value up in one descent and build the node only
+  // when it is absent
 
   std::pair<iterator, bool> insert(const value_type &value) {
-    Node *pt = new Node(value);
-    // root = BSTInsert(root, pt);
-    if (root == nullptr) {
-      root = pt;
-      return {iterator(pt), true};
-    }
-    Node *insertedNode = insertTree(root, pt);
+    auto result = this->emplaceKey(value, true, value);
+    return {iterator(result.first), result.second};
+  }
 
-    if (insertedNode == pt) {
-      return {iterator(pt), true};
-    } else {
-      return {iterator(insertedNode), false};
-    }
+  std::pair<iterator, bool> insert(value_type &&value) {
+    auto result = this->emplaceKey(value, true, std::move(value));
+    return {iterator(result.first), result.second};
+  }
+
+  // Inserts right before hint when that is where the value belongs, as
+  // when appending ascending values with end() as hint, otherwise like
+  // insert. Returns the element equal to value, new or already present.
+  iterator insert(iterator hint, const value_type &value) {
+    return iterator(this->emplaceHint(hint.current, value, true, value).first);
   }
 
-  void erase(iterator pos) {
-    if (pos.current != nullptr) {
-      root = erase(root, pos.current->key);
+  iterator insert(iterator hint, value_type &&value) {
+    return iterator(
+        this->emplaceHint(hint.current, value, true, std::move(value)).first);
+  }
+
+  template <typename... Args>
+  std::pair<iterator, bool> emplace(Args &&...args) {
+    return insert(value_type(std::forward<Args>(args)...));
+  }
+
+  template <typename... Args>
+  iterator emplace_hint(iterator hint, Args &&...args) {
+    return insert(hint, value_type(std::forward<Args>(args)...));
+  }
+
+  // Unlinks the node of pos without searching for it again and returns
+  // the element after it
+  iterator erase(iterator pos) {
+    if (pos == end()) {
+      return end();
     }
+    return iterator(this->eraseNode(pos.current));
   }
 
-  void swap(set &other) {
-    Node *tmp = this->root;
-    this->root = copyTree(other.root);
-    other.root = copyTree(tmp);
-    // std::swap(this->root, other.root);
+  // Erases [first, last) in O(log n + k) and returns last
+  iterator erase(iterator first, iterator last) {
+    this->eraseRange(first.current, last.current);
+    return last;
   }
 
-  void merge(set &other) {
-    for (auto iter{other.begin()}; iter != other.end(); ++iter) {
-      Node *pt = new Node(*iter);
-      root = insertTree(root, pt);
+  size_type erase(const Key &key) { return eraseAll(key); }
+
+  template <typename K, typename = if_transparent_key<K>>
+  size_type erase(const K &key) {
+    return eraseAll(key);
+  }
+
+  // Node handles move elements between sets. insert() relinks the node
+  // into any set without a copy, the set keeps the slabs of the pool it
+  // came from alive. extract() unlinks an element, an empty handle means
+  // key was absent.
+  node_type extract(iterator pos) { return this->extractNode(pos.current); }
+
+  node_type extract(const Key &key) {
+    Node *node = findInTree(root, key);
+    return node == nullptr ? node_type() : this->extractNode(node);
+  }
+
+  // Links the node of nh in. When an equal value is already present nh
+  // keeps the node and comes back in node, position points to that value.
+  insert_return_type insert(node_type &&nh) {
+    if (nh.empty()) {
+      return {end(), false, node_type()};
     }
+    auto result = this->insertHandle(nh, true);
+    return {iterator(result.first), result.second, std::move(nh)};
+  }
+
+  void swap(set &other) { this->swapTree(other); }
+
+  // Relinks the nodes of the values missing here out of other, the rest
+  // stays in other. No node is allocated or copied.
+  void merge(set &other) { this->spliceFrom(other, true); }
+
+  // Set Algebra. other is drained: its nodes are moved into this set or
+  // destroyed, no node is allocated. The overloads taking a ThreadPool
+  // process independent subtrees in parallel.
+
+  void set_union(set &other) {
+    applySetOperation(other, SetOperation::Union, true);
+  }
+
+  void set_union(set &other, ThreadPool &workers) {
+    applySetOperation(other, SetOperation::Union, true, workers);
+  }
+
+  void set_intersection(set &other) {
+    applySetOperation(other, SetOperation::Intersection, true);
+  }
+
+  void set_intersection(set &other, ThreadPool &workers) {
+    applySetOperation(other, SetOperation::Intersection, true, workers);
+  }
+
+  void set_difference(set &other) {
+    applySetOperation(other, SetOperation::Difference, true);
+  }
+
+  void set_difference(set &other, ThreadPool &workers) {
+    applySetOperation(other, SetOperation::Difference, true, workers);
+  }
+
+  void set_symmetric_difference(set &other) {
+    applySetOperation(other, SetOperation::SymmetricDifference, true);
+  }
+
+  void set_symmetric_difference(set &other, ThreadPool &workers) {
+    applySetOperation(other, SetOperation::SymmetricDifference, true, workers);
   }
 
   // Set Lookup
 
   iterator find(const Key &key) {
-    Node *current = root;
-    while (current != nullptr) {
-      if (current->key == key) {
-        return iterator(current);
-      }
-      if (key < current->key) {
-        current = current->left;
-      } else {
-        current = current->right;
-      }
-    }
-    return end();
+    return iterator(nodeOrEnd(findInTree(root, key)));
   }
 
-  bool contains(const Key &key) {
-    Node *current = root;
-    while (current != nullptr) {
-      if (current->key == key) {
-        return true;
-      }
-      if (key < current->key) {
-        current = current->left;
-      } else {
-        current = current->right;
+  template <typename K, typename = if_transparent<K>>
+  iterator find(const K &key) {
+    return iterator(nodeOrEnd(findInTree(root, key)));
+  }
+
+  bool contains(const Key &key) { return findInTree(root, key) != nullptr; }
+
+  template <typename K, typename = if_transparent<K>>
+  bool contains(const K &key) {
+    return findInTree(root, key) != nullptr;
+  }
+
+  // Batched lookups, out[i] is find(keys[i]). keys is any indexable
+  // container of keys, such as a std::vector. Several descents run
+  // interleaved with the next node prefetched, so a large batch costs far
+  // less than a loop of find() on a tree that does not fit in cache.
+  template <typename Keys>
+  void find_many(const Keys &keys, std::vector<iterator> &out) {
+    out.assign(keys.size(), end());
+    this->findMany(keys, [&out](std::size_t i, Node *node) {
+      if (node != nullptr) {
+        out[i] = iterator(node);
       }
-    }
-    return false;
+    });
+  }
+
+  // out[i] tells whether the set holds keys[i]
+  template <typename Keys>
+  void contains_many(const Keys &keys, std::vector<bool> &out) {
+    out.assign(keys.size(), false);
+    this->findMany(keys, [&out](std::size_t i, Node *node) {
+      out[i] = node != nullptr;
+    });
+  }
+
+  size_type count(const Key &key) { return contains(key) ? 1 : 0; }
+
+  template <typename K, typename = if_transparent<K>>
+  size_type count(const K &key) {
+    return contains(key) ? 1 : 0;
+  }
+
+  std::pair<iterator, iterator> equal_range(const Key &key) {
+    return std::make_pair(lower_bound(key), upper_bound(key));
+  }
+
+  template <typename K, typename = if_transparent<K>>
+  std::pair<iterator, iterator> equal_range(const K &key) {
+    return std::make_pair(lower_bound(key), upper_bound(key));
+  }
+
+  // First element not less than key
+  iterator lower_bound(const Key &key) {
+    return iterator(nodeOrEnd(this->lowerBoundNode(root, key)));
   }
 
+  template <typename K, typename = if_transparent<K>>
+  iterator lower_bound(const K &key) {
+    return iterator(nodeOrEnd(this->lowerBoundNode(root, key)));
+  }
+
+  // First element greater than key
+  iterator upper_bound(const Key &key) {
+    return iterator(nodeOrEnd(this->upperBoundNode(root, key)));
+  }
+
+  template <typename K, typename = if_transparent<K>>
+  iterator upper_bound(const K &key) {
+    return iterator(nodeOrEnd(this->upperBoundNode(root, key)));
+  }
+
+  // Calls visit(value) for the values in [lo, hi) in order. A visitor
+  // returning bool stops the walk by returning false. Costs one descent
+  // plus the elements visited.
+  template <typename Visit>
+  void for_each_in_range(const Key &lo, const Key &hi, Visit visit) {
+    this->visitRange(lo, hi, [&visit](Node *node) {
+      return Base::callVisitor(visit, node->key());
+    });
+  }
+
+  template <typename K, typename Visit, typename = if_transparent<K>>
+  void for_each_in_range(const K &lo, const K &hi, Visit visit) {
+    this->visitRange(lo, hi, [&visit](Node *node) {
+      return Base::callVisitor(visit, node->key());
+    });
+  }
+
+  key_compare key_comp() const { return this->comp; }
+
+  // Set Order statistics
+
+  iterator nth(size_type k) {
+    return iterator(nodeOrEnd(nthNode(root, k)));
+  }
+
+  size_type rank(const Key &key) { return countLess(root, key); }
+
+  template <typename K, typename = if_transparent<K>>
+  size_type rank(const K &key) {
+    return countLess(root, key);
+  }
+
+  size_type count_range(const Key &lo, const Key &hi) {
+    return countRange(root, lo, hi);
+  }
+
+  template <typename K, typename = if_transparent<K>>
+  size_type count_range(const K &lo, const K &hi) {
+    return countRange(root, lo, hi);
+  }
+
+  // Set Diagnostics
+
+  // Node count, height against the AVL bound, leaf depths and pool bytes,
+  // found by a walk over every node. Rotations and comparisons since the
+  // last reset_stats() are counted only when Stats is TreeCountStats.
+  stats_type stats() { return this->treeStats(); }
+
+  void reset_stats() { this->resetStats(); }
+
   void print() { printTree(root); }
+
+ private:
+  template <typename K>
+  size_type eraseAll(const K &key) {
+    size_type before = size();
+    eraseKey(key);
+    return before - size();
+  }
 };
 }  // namespace s21
 
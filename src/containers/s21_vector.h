@@ -39,9 +39,12 @@ class vector {
     std::copy(init.begin(), init.end(), buffer_);
   }
 
+  // A copy allocates only what it holds, so its capacity is the size of
+  // v. Taking v.capacity_ left an empty copy of a reserved vector with a
+  // capacity but no buffer.
   vector(const vector &v) {
     size_ = v.size_;
-    capacity_ = v.capacity_;
+    capacity_ = v.size_;
     buffer_ = nullptr;
     if (size_ > 0) {
       buffer_ = new value_type[capacity_];
@@ -59,6 +62,7 @@ class vector {
 
   constexpr vector &operator=(vector &&rhs) noexcept {
     if (this != &rhs) {
+      delete[] buffer_;
       size_ = std::exchange(rhs.size_, 0);
       capacity_ = std::exchange(rhs.capacity_, 0);
       buffer_ = std::exchange(rhs.buffer_, nullptr);
@@ -70,12 +74,13 @@ class vector {
   constexpr vector &operator=(const vector &rhs) {
     if (this != &rhs) {
       delete[] buffer_;
+      buffer_ = nullptr;
       if (rhs.size_ > 0) {
-        buffer_ = new value_type[rhs.capacity_];
+        buffer_ = new value_type[rhs.size_];
         std::copy(rhs.begin(), rhs.end(), buffer_);
       }
       size_ = rhs.size_;
-      capacity_ = rhs.capacity_;
+      capacity_ = rhs.size_;
     }
     return *this;
   }
@@ -167,7 +172,7 @@ class vector {
       throw std::out_of_range(
           "Cant do insert into a position out of range of begin() to end()");
     if (size_ == capacity_) ReallocVector(size_ ? size_ * 2 : 1);
-    std::copy(begin() + index, end(), begin() + index + 1);
+    std::move_backward(begin() + index, end(), end() + 1);
     *(buffer_ + index) = std::move(value);
     ++size_;
     return begin() + index;
@@ -179,7 +184,7 @@ class vector {
       throw std::out_of_range(
           "Cant do insert into a position out of range of begin() to end()");
     if (size_ == capacity_) ReallocVector(size_ ? size_ * 2 : 1);
-    std::copy(begin() + index, end(), begin() + index + 1);
+    std::move_backward(begin() + index, end(), end() + 1);
     *(buffer_ + index) = value;
     ++size_;
     return begin() + index;
@@ -190,8 +195,7 @@ class vector {
     if (index >= size_)
       throw std::out_of_range(
           "Cant do erase a position out of range of begin() to end()");
-    std::copy(begin(), const_cast<iterator>(pos), buffer_);
-    std::copy(const_cast<iterator>(pos) + 1, end(), buffer_ + index);
+    std::move(begin() + index + 1, end(), begin() + index);
     --size_;
     return begin() + index;
   }
@@ -1,6 +1,16 @@
 #ifndef CPP2_S21_CONTAINERS_S21_CONTAINERSPLUS_H_
 #define CPP2_S21_CONTAINERS_S21_CONTAINERSPLUS_H_
 #include "containersplus/s21_array.h"
+#include "containersplus/s21_btree_map.h"
+#include "containersplus/s21_btree_multiset.h"
+#include "containersplus/s21_btree_set.h"
+#include "containersplus/s21_concurrent_map.h"
+#include "containersplus/s21_flat_map.h"
+#include "containersplus/s21_flat_set.h"
 #include "containersplus/s21_multiset.h"
+#include "containersplus/s21_persistent_map.h"
+#include "containersplus/s21_persistent_set.h"
+#include "containersplus/s21_unordered_map.h"
+#include "containersplus/s21_unordered_set.h"
 
 #endif  // CPP2_S21_CONTAINERS_S21_CONTAINERSPLUS_H_
\ No newline at end of file
@@ -0,0 +1,266 @@
+#ifndef __S21_AGGREGATE_MAP_H__
+#define __S21_AGGREGATE_MAP_H__
+
+#include <initializer_list>
+#include <iterator>
+#include <limits>
+#include <stdexcept>
+
+#include "../Tree/aggregate.h"
+#include "../Tree/tree.h"
+
+namespace s21 {
+
+// Ordered map that keeps an aggregate of the mapped values, such as their
+// sum, minimum or maximum (see aggregate.h), in every subtree, so that
+// aggregate(lo, hi) over a range of keys costs O(log n) instead of a scan.
+// Values are read-only through lookups and iterators: they change through
+// insert_or_assign(), which refreshes the aggregates above the element.
+template <typename Key, typename T, typename Aggregate,
+          typename Compare = std::less<Key>, typename Stats = TreeNoStats>
+class aggregate_map : public Tree<Key, T, Compare, Aggregate, Stats> {
+  using Base = Tree<Key, T, Compare, Aggregate, Stats>;
+  using typename Base::Node;
+  using Base::root;
+
+ public:
+  // Aggregate_map Member type
+  using key_type = Key;
+  using mapped_type = T;
+  using value_type = std::pair<const key_type, mapped_type>;
+  using reference = value_type &;
+  using const_reference = const value_type &;
+  using size_type = size_t;
+  using key_compare = Compare;
+  using stats_type = TreeStats;
+  using aggregate_type = typename Aggregate::value_type;
+
+  // Overloads templated on K take any key type the comparator can order
+  // against Key, they exist only for transparent comparators
+  template <typename K>
+  using if_transparent =
+      std::enable_if_t<is_transparent<Compare>::value && sizeof(K) != 0>;
+
+  // Aggregate_map Member functions
+  aggregate_map() : Base() {}
+
+  aggregate_map(std::initializer_list<value_type> const &items) {
+    for (const value_type &item : items) {
+      insert(item);
+    }
+  }
+
+  aggregate_map(const aggregate_map &other) : Base(other) {}
+
+  aggregate_map(aggregate_map &&other) noexcept : Base(std::move(other)) {}
+
+  ~aggregate_map() {}
+
+  aggregate_map &operator=(aggregate_map &&other) {
+    if (this != &other) {
+      this->moveTree(other);
+    }
+    return *this;
+  }
+
+  // Aggregate_map Element access
+
+  const T &at(const Key &key) { return valueAt(this->findInTree(root, key)); }
+
+  template <typename K, typename = if_transparent<K>>
+  const T &at(const K &key) {
+    return valueAt(this->findInTree(root, key));
+  }
+
+  // Aggregate_map Iterators
+
+  class AggregateMapIterator {
+   public:
+    using iterator_category = std::bidirectional_iterator_tag;
+    using value_type = std::pair<const Key, T>;
+    using difference_type = std::ptrdiff_t;
+    using pointer = const value_type *;
+    using reference = const value_type &;
+
+    Node *current;
+    AggregateMapIterator(Node *node) : current(node) {}
+
+    reference operator*() const { return current->data; }
+
+    pointer operator->() const { return &current->data; }
+
+    AggregateMapIterator &operator++() {
+      current = Base::nextNode(current);
+      return *this;
+    }
+
+    AggregateMapIterator operator++(int) {
+      AggregateMapIterator tmp = *this;
+      ++(*this);
+      return tmp;
+    }
+
+    AggregateMapIterator &operator--() {
+      current = Base::prevNode(current);
+      return *this;
+    }
+
+    AggregateMapIterator operator--(int) {
+      AggregateMapIterator tmp = *this;
+      --(*this);
+      return tmp;
+    }
+
+    bool operator==(const AggregateMapIterator &other) const {
+      return current == other.current;
+    }
+
+    bool operator!=(const AggregateMapIterator &other) const {
+      return current != other.current;
+    }
+  };
+
+  using iterator = AggregateMapIterator;
+  using const_iterator = AggregateMapIterator;
+  using reverse_iterator = std::reverse_iterator<iterator>;
+
+  iterator begin() { return iterator(this->firstNode()); }
+
+  iterator end() { return iterator(this->endNode()); }
+
+  reverse_iterator rbegin() { return reverse_iterator(end()); }
+
+  reverse_iterator rend() { return reverse_iterator(begin()); }
+
+  // Aggregate_map Capacity
+
+  bool empty() { return root == nullptr; }
+
+  size_type size() { return this->getSize(root); }
+
+  size_type max_size() {
+    return std::numeric_limits<size_type>::max() / sizeof(Node);
+  }
+
+  // Aggregate_map Modifiers
+
+  void clear() { this->clearTree(); }
+
+  std::pair<iterator, bool> insert(const value_type &value) {
+    return insert(value.first, value.second);
+  }
+
+  std::pair<iterator, bool> insert(const Key &key, const T &obj) {
+    auto result = this->emplaceKey(key, true, std::piecewise_construct, key,
+                                   obj);
+    return {iterator(result.first), result.second};
+  }
+
+  // Replaces the value of a present key and refreshes the aggregates on
+  // its path to the root
+  std::pair<iterator, bool> insert_or_assign(const Key &key, const T &obj) {
+    auto result = this->emplaceKey(key, true, std::piecewise_construct, key,
+                                   obj);
+    if (!result.second) {
+      result.first->value() = obj;
+      this->refreshAggregates(result.first);
+    }
+    return {iterator(result.first), result.second};
+  }
+
+  // Unlinks the node of pos and returns the element after it
+  iterator erase(iterator pos) {
+    if (pos == end()) {
+      return end();
+    }
+    return iterator(this->eraseNode(pos.current));
+  }
+
+  iterator erase(iterator first, iterator last) {
+    this->eraseRange(first.current, last.current);
+    return last;
+  }
+
+  size_type erase(const Key &key) { return eraseAll(key); }
+
+  template <typename K, typename = if_transparent<K>>
+  size_type erase(const K &key) {
+    return eraseAll(key);
+  }
+
+  void swap(aggregate_map &other) { this->swapTree(other); }
+
+  // Aggregate_map Lookup
+
+  iterator find(const Key &key) {
+    return iterator(this->nodeOrEnd(this->findInTree(root, key)));
+  }
+
+  template <typename K, typename = if_transparent<K>>
+  iterator find(const K &key) {
+    return iterator(this->nodeOrEnd(this->findInTree(root, key)));
+  }
+
+  bool contains(const Key &key) {
+    return this->findInTree(root, key) != nullptr;
+  }
+
+  template <typename K, typename = if_transparent<K>>
+  bool contains(const K &key) {
+    return this->findInTree(root, key) != nullptr;
+  }
+
+  size_type count(const Key &key) { return contains(key) ? 1 : 0; }
+
+  iterator lower_bound(const Key &key) {
+    return iterator(this->nodeOrEnd(this->lowerBoundNode(root, key)));
+  }
+
+  iterator upper_bound(const Key &key) {
+    return iterator(this->nodeOrEnd(this->upperBoundNode(root, key)));
+  }
+
+  key_compare key_comp() const { return this->comp; }
+
+  // Aggregate_map Aggregates
+
+  // Aggregate of the values with keys in [lo, hi), Aggregate::identity()
+  // when the range is empty
+  aggregate_type aggregate(const Key &lo, const Key &hi) {
+    return this->aggregateRange(lo, hi);
+  }
+
+  template <typename K, typename = if_transparent<K>>
+  aggregate_type aggregate(const K &lo, const K &hi) {
+    return this->aggregateRange(lo, hi);
+  }
+
+  // Aggregate of all values, O(1)
+  aggregate_type aggregate() { return Base::aggregateOf(root); }
+
+  // Aggregate_map Diagnostics
+
+  // Shape of the tree as map::stats() reports it, counters included when
+  // Stats is TreeCountStats
+  stats_type stats() { return this->treeStats(); }
+
+  void reset_stats() { this->resetStats(); }
+
+ private:
+  const T &valueAt(Node *node) {
+    if (node == nullptr) {
+      throw std::out_of_range("Not found key");
+    }
+    return node->value();
+  }
+
+  template <typename K>
+  size_type eraseAll(const K &key) {
+    size_type before = size();
+    this->eraseKey(key);
+    return before - size();
+  }
+};
+}  // namespace s21
+
+#endif
@@ -0,0 +1,365 @@
+#ifndef __S21_BTREE_MAP_H__
+#define __S21_BTREE_MAP_H__
+
+#include <iterator>
+#include <limits>
+#include <stdexcept>
+#include <type_traits>
+
+#include "../Tree/btree.h"
+#include "../Tree/pair_reference.h"
+
+namespace s21 {
+
+// Ordered map on a B+tree. Same interface as s21::map, but iterators are
+// invalidated by every insert and erase since elements move between nodes.
+template <typename Key, typename T, typename Compare = std::less<Key>>
+class btree_map : public BTree<Key, T, Compare> {
+  using Base = BTree<Key, T, Compare>;
+  using typename Base::Leaf;
+  using typename Base::Position;
+
+ public:
+  // Btree_map Member type
+  using key_type = Key;
+  using mapped_type = T;
+  using value_type = std::pair<const key_type, mapped_type>;
+  using reference = value_type &;
+  using const_reference = const value_type &;
+  using size_type = size_t;
+  using key_compare = Compare;
+
+  // Overloads templated on K take any key type the comparator can order
+  // against Key, they exist only for transparent comparators
+  template <typename K>
+  using if_transparent =
+      std::enable_if_t<is_transparent<Compare>::value && sizeof(K) != 0>;
+
+  // Btree_map Member functions
+  btree_map() : Base() {}
+
+  btree_map(std::initializer_list<value_type> const &items)
+      : btree_map(items.begin(), items.end()) {}
+
+  template <typename InputIt, typename = typename std::iterator_traits<
+                                  InputIt>::iterator_category>
+  btree_map(InputIt first, InputIt last) {
+    for (; first != last; ++first) {
+      insert(*first);
+    }
+  }
+
+  btree_map(const btree_map &other) : Base(other) {}
+
+  btree_map(btree_map &&other) noexcept : Base(std::move(other)) {}
+
+  ~btree_map() {}
+
+  btree_map &operator=(const btree_map &other) = default;
+
+  btree_map &operator=(btree_map &&other) noexcept = default;
+
+  // Btree_map Element access
+
+  T &at(const Key &key) { return valueAt(this->findKey(key)); }
+
+  template <typename K, typename = if_transparent<K>>
+  T &at(const K &key) {
+    return valueAt(this->findKey(key));
+  }
+
+  T &operator[](const Key &key) { return findOrInsert(key); }
+
+  template <typename K, typename = if_transparent<K>>
+  T &operator[](const K &key) {
+    return findOrInsert(key);
+  }
+
+  // Btree_map Iterators
+
+  // Keys and values sit in separate arrays of the leaf, so elements are
+  // handed out as a PairReference to both. The const iterator refers to a
+  // const value, an iterator converts to it.
+  template <bool Const>
+  class BTreeMapIterator {
+    using Mapped = std::conditional_t<Const, const T, T>;
+
+   public:
+    using iterator_category = std::bidirectional_iterator_tag;
+    using value_type = std::pair<const Key, T>;
+    using difference_type = std::ptrdiff_t;
+    using pointer = PairPointer<Key, Mapped>;
+    using reference = PairReference<Key, Mapped>;
+
+    Leaf *leaf;
+    int index;
+    const btree_map *tree;
+
+    BTreeMapIterator(Position pos, const btree_map *owner)
+        : leaf(pos.leaf), index(pos.index), tree(owner) {}
+
+    template <bool WasConst, typename = std::enable_if_t<Const && !WasConst>>
+    BTreeMapIterator(const BTreeMapIterator<WasConst> &other)
+        : leaf(other.leaf), index(other.index), tree(other.tree) {}
+
+    reference operator*() const {
+      return {leaf->keys[index], leaf->values[index]};
+    }
+
+    pointer operator->() const { return {**this}; }
+
+    BTreeMapIterator &operator++() {
+      Base::stepForward(leaf, index);
+      return *this;
+    }
+
+    BTreeMapIterator operator++(int) {
+      BTreeMapIterator tmp = *this;
+      ++(*this);
+      return tmp;
+    }
+
+    BTreeMapIterator &operator--() {
+      tree->stepBackward(leaf, index);
+      return *this;
+    }
+
+    BTreeMapIterator operator--(int) {
+      BTreeMapIterator tmp = *this;
+      --(*this);
+      return tmp;
+    }
+
+    friend bool operator==(const BTreeMapIterator &lhs,
+                           const BTreeMapIterator &rhs) {
+      return lhs.leaf == rhs.leaf && lhs.index == rhs.index;
+    }
+
+    friend bool operator!=(const BTreeMapIterator &lhs,
+                           const BTreeMapIterator &rhs) {
+      return !(lhs == rhs);
+    }
+  };
+
+  using iterator = BTreeMapIterator<false>;
+  using const_iterator = BTreeMapIterator<true>;
+  using reverse_iterator = std::reverse_iterator<iterator>;
+  using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+  iterator begin() { return iterator(this->beginPosition(), this); }
+
+  const_iterator begin() const {
+    return const_iterator(this->beginPosition(), this);
+  }
+
+  const_iterator cbegin() const { return begin(); }
+
+  iterator end() { return iterator({nullptr, 0}, this); }
+
+  const_iterator end() const { return const_iterator({nullptr, 0}, this); }
+
+  const_iterator cend() const { return end(); }
+
+  reverse_iterator rbegin() { return reverse_iterator(end()); }
+
+  const_reverse_iterator rbegin() const {
+    return const_reverse_iterator(end());
+  }
+
+  reverse_iterator rend() { return reverse_iterator(begin()); }
+
+  const_reverse_iterator rend() const {
+    return const_reverse_iterator(begin());
+  }
+
+  // Btree_map Capacity
+
+  bool empty() const { return this->elements == 0; }
+
+  size_type size() const { return this->elements; }
+
+  size_type max_size() const {
+    return std::numeric_limits<size_type>::max() / sizeof(value_type);
+  }
+
+  // Btree_map Modifiers
+
+  void clear() { this->clearTree(); }
+
+  std::pair<iterator, bool> insert(const value_type &value) {
+    auto result = this->insertUnique(value.first, value.second);
+    return {iterator(result.first, this), result.second};
+  }
+
+  std::pair<iterator, bool> insert(const Key &key, const T &obj) {
+    auto result = this->insertUnique(key, obj);
+    return {iterator(result.first, this), result.second};
+  }
+
+  std::pair<iterator, bool> insert_or_assign(const Key &key, const T &obj) {
+    auto result = this->insertUnique(key, obj);
+    if (!result.second) {
+      result.first.leaf->values[result.first.index] = obj;
+    }
+    return {iterator(result.first, this), result.second};
+  }
+
+  // Returns the element that followed pos, which may have moved. The
+  // iterator overload keeps erase(const K &) from catching iterators.
+  iterator erase(iterator pos) { return erase(const_iterator(pos)); }
+
+  iterator erase(const_iterator pos) {
+    if (pos == cend()) {
+      return end();
+    }
+    return iterator(this->eraseAt(pos.leaf, pos.index), this);
+  }
+
+  size_type erase(const Key &key) { return eraseKey(key); }
+
+  template <typename K, typename = if_transparent<K>>
+  size_type erase(const K &key) {
+    return eraseKey(key);
+  }
+
+  void swap(btree_map &other) { this->swapTree(other); }
+
+  // Moves the elements whose keys are missing here out of other, the rest
+  // stays in other
+  void merge(btree_map &other) {
+    if (this == &other) {
+      return;
+    }
+    Position pos = other.beginPosition();
+    while (pos.leaf != nullptr) {
+      if (this->insertUnique(std::move(pos.leaf->keys[pos.index]),
+                             std::move(pos.leaf->values[pos.index]))
+              .second) {
+        pos = other.eraseAt(pos.leaf, pos.index);
+      } else {
+        Base::stepForward(pos.leaf, pos.index);
+      }
+    }
+  }
+
+  // Btree_map Lookup
+
+  iterator find(const Key &key) { return iterator(this->findKey(key), this); }
+
+  const_iterator find(const Key &key) const {
+    return const_iterator(this->findKey(key), this);
+  }
+
+  template <typename K, typename = if_transparent<K>>
+  iterator find(const K &key) {
+    return iterator(this->findKey(key), this);
+  }
+
+  template <typename K, typename = if_transparent<K>>
+  const_iterator find(const K &key) const {
+    return const_iterator(this->findKey(key), this);
+  }
+
+  bool contains(const Key &key) const {
+    return this->findKey(key).leaf != nullptr;
+  }
+
+  template <typename K, typename = if_transparent<K>>
+  bool contains(const K &key) const {
+    return this->findKey(key).leaf != nullptr;
+  }
+
+  size_type count(const Key &key) const { return contains(key) ? 1 : 0; }
+
+  template <typename K, typename = if_transparent<K>>
+  size_type count(const K &key) const {
+    return contains(key) ? 1 : 0;
+  }
+
+  iterator lower_bound(const Key &key) {
+    return iterator(this->lowerBound(key), this);
+  }
+
+  const_iterator lower_bound(const Key &key) const {
+    return const_iterator(this->lowerBound(key), this);
+  }
+
+  template <typename K, typename = if_transparent<K>>
+  iterator lower_bound(const K &key) {
+    return iterator(this->lowerBound(key), this);
+  }
+
+  template <typename K, typename = if_transparent<K>>
+  const_iterator lower_bound(const K &key) const {
+    return const_iterator(this->lowerBound(key), this);
+  }
+
+  iterator upper_bound(const Key &key) {
+    return iterator(this->upperBound(key), this);
+  }
+
+  const_iterator upper_bound(const Key &key) const {
+    return const_iterator(this->upperBound(key), this);
+  }
+
+  template <typename K, typename = if_transparent<K>>
+  iterator upper_bound(const K &key) {
+    return iterator(this->upperBound(key), this);
+  }
+
+  template <typename K, typename = if_transparent<K>>
+  const_iterator upper_bound(const K &key) const {
+    return const_iterator(this->upperBound(key), this);
+  }
+
+  std::pair<iterator, iterator> equal_range(const Key &key) {
+    return std::make_pair(lower_bound(key), upper_bound(key));
+  }
+
+  std::pair<const_iterator, const_iterator> equal_range(
+      const Key &key) const {
+    return std::make_pair(lower_bound(key), upper_bound(key));
+  }
+
+  template <typename K, typename = if_transparent<K>>
+  std::pair<iterator, iterator> equal_range(const K &key) {
+    return std::make_pair(lower_bound(key), upper_bound(key));
+  }
+
+  template <typename K, typename = if_transparent<K>>
+  std::pair<const_iterator, const_iterator> equal_range(const K &key) const {
+    return std::make_pair(lower_bound(key), upper_bound(key));
+  }
+
+  key_compare key_comp() const { return this->comp; }
+
+ private:
+  T &valueAt(Position pos) {
+    if (pos.leaf == nullptr) {
+      throw std::out_of_range("Not found key");
+    }
+    return pos.leaf->values[pos.index];
+  }
+
+  template <typename K>
+  T &findOrInsert(const K &key) {
+    Position pos = this->findKey(key);
+    if (pos.leaf == nullptr) {
+      pos = this->insertEqual(Key(key), T());
+    }
+    return pos.leaf->values[pos.index];
+  }
+
+  template <typename K>
+  size_type eraseKey(const K &key) {
+    Position pos = this->findKey(key);
+    if (pos.leaf == nullptr) {
+      return 0;
+    }
+    this->eraseAt(pos.leaf, pos.index);
+    return 1;
+  }
+};
+}  // namespace s21
+
+#endif
@@ -0,0 +1,251 @@
+#ifndef __S21_BTREE_MULTISET_H__
+#define __S21_BTREE_MULTISET_H__
+
+#include <iterator>
+#include <limits>
+
+#include "../Tree/btree.h"
+
+namespace s21 {
+
+// Ordered multiset on a B+tree. Same interface as s21::multiset, but
+// iterators are invalidated by every insert and erase since elements move
+// between nodes. Equal keys keep their insertion order.
+template <typename Key, typename Compare = std::less<Key>>
+class btree_multiset : public BTree<Key, BTreeNoValue, Compare> {
+  using Base = BTree<Key, BTreeNoValue, Compare>;
+  using typename Base::Leaf;
+  using typename Base::Position;
+
+ public:
+  // Btree_multiset Member type
+  using key_type = Key;
+  using value_type = Key;
+  using reference = value_type &;
+  using const_reference = const value_type &;
+  using size_type = size_t;
+  using key_compare = Compare;
+
+  // Overloads templated on K take any key type the comparator can order
+  // against Key, they exist only for transparent comparators
+  template <typename K>
+  using if_transparent =
+      std::enable_if_t<is_transparent<Compare>::value && sizeof(K) != 0>;
+
+  // Btree_multiset Member functions
+  btree_multiset() : Base() {}
+
+  btree_multiset(std::initializer_list<value_type> const &items)
+      : btree_multiset(items.begin(), items.end()) {}
+
+  template <typename InputIt, typename = typename std::iterator_traits<
+                                  InputIt>::iterator_category>
+  btree_multiset(InputIt first, InputIt last) {
+    for (; first != last; ++first) {
+      insert(*first);
+    }
+  }
+
+  btree_multiset(const btree_multiset &other) : Base(other) {}
+
+  btree_multiset(btree_multiset &&other) noexcept : Base(std::move(other)) {}
+
+  ~btree_multiset() {}
+
+  btree_multiset &operator=(const btree_multiset &other) = default;
+
+  btree_multiset &operator=(btree_multiset &&other) noexcept = default;
+
+  // Btree_multiset Iterators
+
+  class BTreeMultisetIterator {
+   public:
+    using iterator_category = std::bidirectional_iterator_tag;
+    using value_type = Key;
+    using difference_type = std::ptrdiff_t;
+    using pointer = const Key *;
+    using reference = const Key &;
+
+    Leaf *leaf;
+    int index;
+    const btree_multiset *tree;
+
+    BTreeMultisetIterator(Position pos, const btree_multiset *owner)
+        : leaf(pos.leaf), index(pos.index), tree(owner) {}
+
+    const Key &operator*() const { return leaf->keys[index]; }
+
+    const Key *operator->() const { return &leaf->keys[index]; }
+
+    BTreeMultisetIterator &operator++() {
+      Base::stepForward(leaf, index);
+      return *this;
+    }
+
+    BTreeMultisetIterator operator++(int) {
+      BTreeMultisetIterator tmp = *this;
+      ++(*this);
+      return tmp;
+    }
+
+    BTreeMultisetIterator &operator--() {
+      tree->stepBackward(leaf, index);
+      return *this;
+    }
+
+    BTreeMultisetIterator operator--(int) {
+      BTreeMultisetIterator tmp = *this;
+      --(*this);
+      return tmp;
+    }
+
+    bool operator==(const BTreeMultisetIterator &other) const {
+      return leaf == other.leaf && index == other.index;
+    }
+
+    bool operator!=(const BTreeMultisetIterator &other) const {
+      return !(*this == other);
+    }
+  };
+
+  using iterator = BTreeMultisetIterator;
+  using const_iterator = BTreeMultisetIterator;
+  using reverse_iterator = std::reverse_iterator<iterator>;
+
+  iterator begin() const { return iterator(this->beginPosition(), this); }
+
+  iterator end() const { return iterator({nullptr, 0}, this); }
+
+  reverse_iterator rbegin() const { return reverse_iterator(end()); }
+
+  reverse_iterator rend() const { return reverse_iterator(begin()); }
+
+  // Btree_multiset Capacity
+
+  bool empty() const { return this->elements == 0; }
+
+  size_type size() const { return this->elements; }
+
+  size_type max_size() const {
+    return std::numeric_limits<size_type>::max() / sizeof(Key);
+  }
+
+  // Btree_multiset Modifiers
+
+  void clear() { this->clearTree(); }
+
+  iterator insert(const value_type &value) {
+    return iterator(this->insertEqual(value, BTreeNoValue()), this);
+  }
+
+  // Returns the element that followed pos, which may have moved
+  iterator erase(iterator pos) {
+    if (pos == end()) {
+      return end();
+    }
+    return iterator(this->eraseAt(pos.leaf, pos.index), this);
+  }
+
+  size_type erase(const Key &key) { return eraseKey(key); }
+
+  template <typename K, typename = if_transparent<K>>
+  size_type erase(const K &key) {
+    return eraseKey(key);
+  }
+
+  void swap(btree_multiset &other) { this->swapTree(other); }
+
+  // Moves every element of other here, other is left empty
+  void merge(btree_multiset &other) {
+    if (this == &other) {
+      return;
+    }
+    for (Position pos = other.beginPosition(); pos.leaf != nullptr;
+         Base::stepForward(pos.leaf, pos.index)) {
+      this->insertEqual(std::move(pos.leaf->keys[pos.index]), BTreeNoValue());
+    }
+    other.clearTree();
+  }
+
+  // Btree_multiset Lookup
+
+  iterator find(const Key &key) const {
+    return iterator(this->findKey(key), this);
+  }
+
+  template <typename K, typename = if_transparent<K>>
+  iterator find(const K &key) const {
+    return iterator(this->findKey(key), this);
+  }
+
+  bool contains(const Key &key) const {
+    return this->findKey(key).leaf != nullptr;
+  }
+
+  template <typename K, typename = if_transparent<K>>
+  bool contains(const K &key) const {
+    return this->findKey(key).leaf != nullptr;
+  }
+
+  size_type count(const Key &key) const { return countKey(key); }
+
+  template <typename K, typename = if_transparent<K>>
+  size_type count(const K &key) const {
+    return countKey(key);
+  }
+
+  iterator lower_bound(const Key &key) const {
+    return iterator(this->lowerBound(key), this);
+  }
+
+  template <typename K, typename = if_transparent<K>>
+  iterator lower_bound(const K &key) const {
+    return iterator(this->lowerBound(key), this);
+  }
+
+  iterator upper_bound(const Key &key) const {
+    return iterator(this->upperBound(key), this);
+  }
+
+  template <typename K, typename = if_transparent<K>>
+  iterator upper_bound(const K &key) const {
+    return iterator(this->upperBound(key), this);
+  }
+
+  std::pair<iterator, iterator> equal_range(const Key &key) const {
+    return std::make_pair(lower_bound(key), upper_bound(key));
+  }
+
+  template <typename K, typename = if_transparent<K>>
+  std::pair<iterator, iterator> equal_range(const K &key) const {
+    return std::make_pair(lower_bound(key), upper_bound(key));
+  }
+
+  key_compare key_comp() const { return this->comp; }
+
+ private:
+  template <typename K>
+  size_type countKey(const K &key) const {
+    size_type found = 0;
+    for (auto pos = this->lowerBound(key);
+         pos.leaf != nullptr && !this->comp(key, pos.leaf->keys[pos.index]);
+         Base::stepForward(pos.leaf, pos.index)) {
+      ++found;
+    }
+    return found;
+  }
+
+  template <typename K>
+  size_type eraseKey(const K &key) {
+    size_type removed = 0;
+    Position pos = this->lowerBound(key);
+    while (pos.leaf != nullptr && !this->comp(key, pos.leaf->keys[pos.index])) {
+      pos = this->eraseAt(pos.leaf, pos.index);
+      ++removed;
+    }
+    return removed;
+  }
+};
+}  // namespace s21
+
+#endif
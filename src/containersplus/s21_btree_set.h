@@ -0,0 +1,244 @@
+#ifndef __S21_BTREE_SET_H__
+#define __S21_BTREE_SET_H__
+
+#include <iterator>
+#include <limits>
+
+#include "../Tree/btree.h"
+
+namespace s21 {
+
+// Ordered set on a B+tree. Same interface as s21::set, but iterators are
+// invalidated by every insert and erase since elements move between nodes.
+template <typename Key, typename Compare = std::less<Key>>
+class btree_set : public BTree<Key, BTreeNoValue, Compare> {
+  using Base = BTree<Key, BTreeNoValue, Compare>;
+  using typename Base::Leaf;
+  using typename Base::Position;
+
+ public:
+  // Btree_set Member type
+  using key_type = Key;
+  using value_type = Key;
+  using reference = value_type &;
+  using const_reference = const value_type &;
+  using size_type = size_t;
+  using key_compare = Compare;
+
+  // Overloads templated on K take any key type the comparator can order
+  // against Key, they exist only for transparent comparators
+  template <typename K>
+  using if_transparent =
+      std::enable_if_t<is_transparent<Compare>::value && sizeof(K) != 0>;
+
+  // Btree_set Member functions
+  btree_set() : Base() {}
+
+  btree_set(std::initializer_list<value_type> const &items)
+      : btree_set(items.begin(), items.end()) {}
+
+  template <typename InputIt, typename = typename std::iterator_traits<
+                                  InputIt>::iterator_category>
+  btree_set(InputIt first, InputIt last) {
+    for (; first != last; ++first) {
+      insert(*first);
+    }
+  }
+
+  btree_set(const btree_set &other) : Base(other) {}
+
+  btree_set(btree_set &&other) noexcept : Base(std::move(other)) {}
+
+  ~btree_set() {}
+
+  btree_set &operator=(const btree_set &other) = default;
+
+  btree_set &operator=(btree_set &&other) noexcept = default;
+
+  // Btree_set Iterators
+
+  class BTreeSetIterator {
+   public:
+    using iterator_category = std::bidirectional_iterator_tag;
+    using value_type = Key;
+    using difference_type = std::ptrdiff_t;
+    using pointer = const Key *;
+    using reference = const Key &;
+
+    Leaf *leaf;
+    int index;
+    const btree_set *tree;
+
+    BTreeSetIterator(Position pos, const btree_set *owner)
+        : leaf(pos.leaf), index(pos.index), tree(owner) {}
+
+    const Key &operator*() const { return leaf->keys[index]; }
+
+    const Key *operator->() const { return &leaf->keys[index]; }
+
+    BTreeSetIterator &operator++() {
+      Base::stepForward(leaf, index);
+      return *this;
+    }
+
+    BTreeSetIterator operator++(int) {
+      BTreeSetIterator tmp = *this;
+      ++(*this);
+      return tmp;
+    }
+
+    BTreeSetIterator &operator--() {
+      tree->stepBackward(leaf, index);
+      return *this;
+    }
+
+    BTreeSetIterator operator--(int) {
+      BTreeSetIterator tmp = *this;
+      --(*this);
+      return tmp;
+    }
+
+    bool operator==(const BTreeSetIterator &other) const {
+      return leaf == other.leaf && index == other.index;
+    }
+
+    bool operator!=(const BTreeSetIterator &other) const {
+      return !(*this == other);
+    }
+  };
+
+  using iterator = BTreeSetIterator;
+  using const_iterator = BTreeSetIterator;
+  using reverse_iterator = std::reverse_iterator<iterator>;
+
+  iterator begin() const { return iterator(this->beginPosition(), this); }
+
+  iterator end() const { return iterator({nullptr, 0}, this); }
+
+  reverse_iterator rbegin() const { return reverse_iterator(end()); }
+
+  reverse_iterator rend() const { return reverse_iterator(begin()); }
+
+  // Btree_set Capacity
+
+  bool empty() const { return this->elements == 0; }
+
+  size_type size() const { return this->elements; }
+
+  size_type max_size() const {
+    return std::numeric_limits<size_type>::max() / sizeof(Key);
+  }
+
+  // Btree_set Modifiers
+
+  void clear() { this->clearTree(); }
+
+  std::pair<iterator, bool> insert(const value_type &value) {
+    auto result = this->insertUnique(value, BTreeNoValue());
+    return {iterator(result.first, this), result.second};
+  }
+
+  // Returns the element that followed pos, which may have moved
+  iterator erase(iterator pos) {
+    if (pos == end()) {
+      return end();
+    }
+    return iterator(this->eraseAt(pos.leaf, pos.index), this);
+  }
+
+  size_type erase(const Key &key) { return eraseKey(key); }
+
+  template <typename K, typename = if_transparent<K>>
+  size_type erase(const K &key) {
+    return eraseKey(key);
+  }
+
+  void swap(btree_set &other) { this->swapTree(other); }
+
+  // Moves the keys missing here out of other, the rest stays in other
+  void merge(btree_set &other) {
+    if (this == &other) {
+      return;
+    }
+    Position pos = other.beginPosition();
+    while (pos.leaf != nullptr) {
+      if (this->insertUnique(std::move(pos.leaf->keys[pos.index]),
+                             BTreeNoValue())
+              .second) {
+        pos = other.eraseAt(pos.leaf, pos.index);
+      } else {
+        Base::stepForward(pos.leaf, pos.index);
+      }
+    }
+  }
+
+  // Btree_set Lookup
+
+  iterator find(const Key &key) const {
+    return iterator(this->findKey(key), this);
+  }
+
+  template <typename K, typename = if_transparent<K>>
+  iterator find(const K &key) const {
+    return iterator(this->findKey(key), this);
+  }
+
+  bool contains(const Key &key) const {
+    return this->findKey(key).leaf != nullptr;
+  }
+
+  template <typename K, typename = if_transparent<K>>
+  bool contains(const K &key) const {
+    return this->findKey(key).leaf != nullptr;
+  }
+
+  size_type count(const Key &key) const { return contains(key) ? 1 : 0; }
+
+  template <typename K, typename = if_transparent<K>>
+  size_type count(const K &key) const {
+    return contains(key) ? 1 : 0;
+  }
+
+  iterator lower_bound(const Key &key) const {
+    return iterator(this->lowerBound(key), this);
+  }
+
+  template <typename K, typename = if_transparent<K>>
+  iterator lower_bound(const K &key) const {
+    return iterator(this->lowerBound(key), this);
+  }
+
+  iterator upper_bound(const Key &key) const {
+    return iterator(this->upperBound(key), this);
+  }
+
+  template <typename K, typename = if_transparent<K>>
+  iterator upper_bound(const K &key) const {
+    return iterator(this->upperBound(key), this);
+  }
+
+  std::pair<iterator, iterator> equal_range(const Key &key) const {
+    return std::make_pair(lower_bound(key), upper_bound(key));
+  }
+
+  template <typename K, typename = if_transparent<K>>
+  std::pair<iterator, iterator> equal_range(const K &key) const {
+    return std::make_pair(lower_bound(key), upper_bound(key));
+  }
+
+  key_compare key_comp() const { return this->comp; }
+
+ private:
+  template <typename K>
+  size_type eraseKey(const K &key) {
+    Position pos = this->findKey(key);
+    if (pos.leaf == nullptr) {
+      return 0;
+    }
+    this->eraseAt(pos.leaf, pos.index);
+    return 1;
+  }
+};
+}  // namespace s21
+
+#endif
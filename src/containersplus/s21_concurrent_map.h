@@ -0,0 +1,218 @@
+#ifndef __S21_CONCURRENT_MAP_H__
+#define __S21_CONCURRENT_MAP_H__
+
+#include <initializer_list>
+#include <limits>
+#include <mutex>
+#include <optional>
+#include <stdexcept>
+#include <type_traits>
+
+#include "../Tree/concurrent_tree.h"
+#include "../Tree/transparent.h"
+
+namespace s21 {
+
+// Ordered map for many reader threads and few writers. Lookups and range
+// scans never block and see one consistent version of the map, writers
+// take turns on a mutex and publish each change atomically. Nodes may be
+// freed as soon as a read ends, so there are no iterators and lookups
+// return copies of the values.
+template <typename Key, typename T, typename Compare = std::less<Key>>
+class concurrent_map : public ConcurrentTree<Key, T, Compare> {
+  using Base = ConcurrentTree<Key, T, Compare>;
+  using typename Base::Node;
+
+ public:
+  // Concurrent_map Member type
+  using key_type = Key;
+  using mapped_type = T;
+  using value_type = std::pair<const key_type, mapped_type>;
+  using reference = value_type &;
+  using const_reference = const value_type &;
+  using size_type = size_t;
+  using key_compare = Compare;
+
+  // Overloads templated on K take any key type the comparator can order
+  // against Key, they exist only for transparent comparators
+  template <typename K>
+  using if_transparent =
+      std::enable_if_t<is_transparent<Compare>::value && sizeof(K) != 0>;
+
+  // Concurrent_map Member functions
+  concurrent_map() : Base() {}
+
+  concurrent_map(std::initializer_list<value_type> const &items) {
+    for (const value_type &item : items) {
+      insert(item);
+    }
+  }
+
+  ~concurrent_map() {}
+
+  // Concurrent_map Element access
+
+  T at(const Key &key) const { return valueAt(key); }
+
+  template <typename K, typename = if_transparent<K>>
+  T at(const K &key) const {
+    return valueAt(key);
+  }
+
+  // Copy of the value, empty when key is absent
+  std::optional<T> get(const Key &key) const { return getValue(key); }
+
+  template <typename K, typename = if_transparent<K>>
+  std::optional<T> get(const K &key) const {
+    return getValue(key);
+  }
+
+  // Concurrent_map Capacity
+
+  bool empty() const { return size() == 0; }
+
+  size_type size() const { return this->elements.load(); }
+
+  size_type max_size() const {
+    return std::numeric_limits<size_type>::max() / sizeof(Node);
+  }
+
+  // Concurrent_map Modifiers
+
+  void clear() {
+    std::lock_guard<std::mutex> lock(this->writer);
+    Node *old = this->loadRoot();
+    this->beginWrite();
+    this->retireTree(old);
+    this->elements.store(0);
+    this->publish(nullptr);
+  }
+
+  bool insert(const value_type &value) {
+    return insert(value.first, value.second);
+  }
+
+  bool insert(const Key &key, const T &obj) {
+    std::lock_guard<std::mutex> lock(this->writer);
+    if (this->findNode(this->loadRoot(), key)) {
+      return false;
+    }
+    write(key, obj, true);
+    return true;
+  }
+
+  // Returns true when key was added, false when its value was replaced
+  bool insert_or_assign(const Key &key, const T &obj) {
+    std::lock_guard<std::mutex> lock(this->writer);
+    bool added = this->findNode(this->loadRoot(), key) == nullptr;
+    write(key, obj, added);
+    return added;
+  }
+
+  size_type erase(const Key &key) { return eraseKey(key); }
+
+  template <typename K, typename = if_transparent<K>>
+  size_type erase(const K &key) {
+    return eraseKey(key);
+  }
+
+  // Concurrent_map Lookup
+
+  bool contains(const Key &key) const { return containsKey(key); }
+
+  template <typename K, typename = if_transparent<K>>
+  bool contains(const K &key) const {
+    return containsKey(key);
+  }
+
+  size_type count(const Key &key) const { return contains(key) ? 1 : 0; }
+
+  template <typename K, typename = if_transparent<K>>
+  size_type count(const K &key) const {
+    return contains(key) ? 1 : 0;
+  }
+
+  // Calls visit(key, value) for every element in key order. A visitor
+  // returning bool stops the scan by returning false. The scan sees one
+  // version and does not hold writers back.
+  template <typename Visit>
+  void for_each(Visit visit) const {
+    auto guard = this->pin();
+    auto step = stepper(visit);
+    Base::visitAll(this->loadRoot(), step);
+  }
+
+  // Same for the keys in [from, to)
+  template <typename Visit>
+  void for_each_in_range(const Key &from, const Key &to, Visit visit) const {
+    auto guard = this->pin();
+    auto step = stepper(visit);
+    this->visitRange(this->loadRoot(), from, to, step);
+  }
+
+  key_compare key_comp() const { return this->comp; }
+
+ private:
+  template <typename Visit>
+  static auto stepper(Visit &visit) {
+    return [&visit](const Key &key, const T &value) {
+      if constexpr (std::is_same_v<decltype(visit(key, value)), bool>) {
+        return visit(key, value);
+      } else {
+        visit(key, value);
+        return true;
+      }
+    };
+  }
+
+  template <typename K>
+  T valueAt(const K &key) const {
+    auto guard = this->pin();
+    const Node *node = this->findNode(this->loadRoot(), key);
+    if (node == nullptr) {
+      throw std::out_of_range("Not found key");
+    }
+    return node->value;
+  }
+
+  template <typename K>
+  std::optional<T> getValue(const K &key) const {
+    auto guard = this->pin();
+    const Node *node = this->findNode(this->loadRoot(), key);
+    if (node == nullptr) {
+      return std::nullopt;
+    }
+    return node->value;
+  }
+
+  template <typename K>
+  bool containsKey(const K &key) const {
+    auto guard = this->pin();
+    return this->findNode(this->loadRoot(), key) != nullptr;
+  }
+
+  // Called with writer locked
+  void write(const Key &key, const T &obj, bool added) {
+    this->beginWrite();
+    Node *updated = this->insertNode(this->loadRoot(), key, obj);
+    this->elements.store(size() + (added ? 1 : 0));
+    this->publish(updated);
+  }
+
+  template <typename K>
+  size_type eraseKey(const K &key) {
+    std::lock_guard<std::mutex> lock(this->writer);
+    Node *old = this->loadRoot();
+    if (!this->findNode(old, key)) {
+      return 0;
+    }
+    this->beginWrite();
+    Node *updated = this->eraseNode(old, key);
+    this->elements.store(size() - 1);
+    this->publish(updated);
+    return 1;
+  }
+};
+}  // namespace s21
+
+#endif
@@ -0,0 +1,485 @@
+#ifndef __S21_FLAT_MAP_H__
+#define __S21_FLAT_MAP_H__
+
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <stdexcept>
+#include <type_traits>
+
+#include "../Tree/pair_reference.h"
+#include "../Tree/sorted_array.h"
+#include "../Tree/transparent.h"
+#include "../containers/s21_vector.h"
+
+namespace s21 {
+
+// Ordered map kept as two parallel sorted s21::vector arrays, one of keys
+// and one of values, so searches only touch the keys. Inserts and erases
+// shift the tails, which suits tables that are built once and read often.
+// Iterators are invalidated by every modification.
+template <typename Key, typename T, typename Compare = std::less<Key>>
+class flat_map {
+ public:
+  // Flat_map Member type
+  using key_type = Key;
+  using mapped_type = T;
+  using value_type = std::pair<const key_type, mapped_type>;
+  using reference = value_type &;
+  using const_reference = const value_type &;
+  using size_type = size_t;
+  using key_compare = Compare;
+  using key_container_type = vector<Key>;
+  using mapped_container_type = vector<T>;
+
+  struct containers {
+    key_container_type keys;
+    mapped_container_type values;
+  };
+
+  // Overloads templated on K take any key type the comparator can order
+  // against Key, they exist only for transparent comparators
+  template <typename K>
+  using if_transparent =
+      std::enable_if_t<is_transparent<Compare>::value && sizeof(K) != 0>;
+
+  // Flat_map Member functions
+  flat_map() {}
+
+  flat_map(std::initializer_list<value_type> const &items)
+      : flat_map(items.begin(), items.end()) {}
+
+  template <typename InputIt, typename = typename std::iterator_traits<
+                                  InputIt>::iterator_category>
+  flat_map(InputIt first, InputIt last) {
+    insert(first, last);
+  }
+
+  // Adopts keys that are already sorted and unique with their values
+  flat_map(key_container_type &&keys, mapped_container_type &&values) {
+    replace(std::move(keys), std::move(values));
+  }
+
+  flat_map(const flat_map &other) = default;
+
+  flat_map(flat_map &&other) noexcept = default;
+
+  ~flat_map() {}
+
+  flat_map &operator=(const flat_map &other) = default;
+
+  flat_map &operator=(flat_map &&other) noexcept = default;
+
+  // Flat_map Element access
+
+  T &at(const Key &key) { return valueAt(findIndex(key)); }
+
+  template <typename K, typename = if_transparent<K>>
+  T &at(const K &key) {
+    return valueAt(findIndex(key));
+  }
+
+  T &operator[](const Key &key) { return findOrInsert(key); }
+
+  template <typename K, typename = if_transparent<K>>
+  T &operator[](const K &key) {
+    return findOrInsert(key);
+  }
+
+  // Flat_map Iterators
+
+  // Elements are handed out as a PairReference to the key and the value
+  // at the same index of the two arrays. The const iterator refers to a
+  // const value, an iterator converts to it.
+  template <bool Const>
+  class FlatMapIterator {
+    using Mapped = std::conditional_t<Const, const T, T>;
+
+   public:
+    using iterator_category = std::bidirectional_iterator_tag;
+    using value_type = std::pair<const Key, T>;
+    using difference_type = std::ptrdiff_t;
+    using pointer = PairPointer<Key, Mapped>;
+    using reference = PairReference<Key, Mapped>;
+
+    const Key *key;
+    Mapped *value;
+
+    FlatMapIterator(const Key *k, Mapped *v) : key(k), value(v) {}
+
+    template <bool WasConst, typename = std::enable_if_t<Const && !WasConst>>
+    FlatMapIterator(const FlatMapIterator<WasConst> &other)
+        : key(other.key), value(other.value) {}
+
+    reference operator*() const { return {*key, *value}; }
+
+    pointer operator->() const { return {**this}; }
+
+    FlatMapIterator &operator++() {
+      ++key;
+      ++value;
+      return *this;
+    }
+
+    FlatMapIterator operator++(int) {
+      FlatMapIterator tmp = *this;
+      ++(*this);
+      return tmp;
+    }
+
+    FlatMapIterator &operator--() {
+      --key;
+      --value;
+      return *this;
+    }
+
+    FlatMapIterator operator--(int) {
+      FlatMapIterator tmp = *this;
+      --(*this);
+      return tmp;
+    }
+
+    friend bool operator==(const FlatMapIterator &lhs,
+                           const FlatMapIterator &rhs) {
+      return lhs.key == rhs.key;
+    }
+
+    friend bool operator!=(const FlatMapIterator &lhs,
+                           const FlatMapIterator &rhs) {
+      return lhs.key != rhs.key;
+    }
+  };
+
+  using iterator = FlatMapIterator<false>;
+  using const_iterator = FlatMapIterator<true>;
+  using reverse_iterator = std::reverse_iterator<iterator>;
+  using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+  iterator begin() { return iteratorAt(0); }
+
+  const_iterator begin() const { return iteratorAt(0); }
+
+  const_iterator cbegin() const { return begin(); }
+
+  iterator end() { return iteratorAt(size()); }
+
+  const_iterator end() const { return iteratorAt(size()); }
+
+  const_iterator cend() const { return end(); }
+
+  reverse_iterator rbegin() { return reverse_iterator(end()); }
+
+  const_reverse_iterator rbegin() const {
+    return const_reverse_iterator(end());
+  }
+
+  reverse_iterator rend() { return reverse_iterator(begin()); }
+
+  const_reverse_iterator rend() const {
+    return const_reverse_iterator(begin());
+  }
+
+  // Flat_map Capacity
+
+  bool empty() const { return keys_.empty(); }
+
+  size_type size() const { return keys_.size(); }
+
+  size_type max_size() const { return keys_.max_size(); }
+
+  // Flat_map Modifiers
+
+  void clear() {
+    keys_.clear();
+    values_.clear();
+  }
+
+  std::pair<iterator, bool> insert(const value_type &value) {
+    return insert(value.first, value.second);
+  }
+
+  std::pair<iterator, bool> insert(const Key &key, const T &obj) {
+    size_type index = lowerBoundIndex(keys_.data(), size(), key, comp_);
+    if (index < size() && !comp_(key, keys_.data()[index])) {
+      return {iteratorAt(index), false};
+    }
+    insertAt(index, key, obj);
+    return {iteratorAt(index), true};
+  }
+
+  std::pair<iterator, bool> insert_or_assign(const Key &key, const T &obj) {
+    auto result = insert(key, obj);
+    if (!result.second) {
+      *result.first.value = obj;
+    }
+    return result;
+  }
+
+  // Sorts the new pairs by key and merges them with the stored ones in one
+  // pass. Keys already present, and repeats within the range, are skipped.
+  template <typename InputIt, typename = typename std::iterator_traits<
+                                  InputIt>::iterator_category>
+  void insert(InputIt first, InputIt last) {
+    vector<std::pair<Key, T>> incoming;
+    for (; first != last; ++first) {
+      incoming.push_back(std::pair<Key, T>((*first).first, (*first).second));
+    }
+    size_type count = sortUnique(
+        incoming.data(), incoming.size(),
+        [](const std::pair<Key, T> &item) -> const Key & {
+          return item.first;
+        },
+        comp_);
+
+    key_container_type keys;
+    mapped_container_type values;
+    keys.reserve(size() + count);
+    values.reserve(size() + count);
+    size_type old = 0, add = 0;
+    while (old < size() || add < count) {
+      bool take_old = add == count ||
+                      (old < size() && !comp_(incoming.data()[add].first,
+                                              keys_.data()[old]));
+      if (take_old) {
+        if (add < count &&
+            !comp_(keys_.data()[old], incoming.data()[add].first)) {
+          ++add;
+        }
+        keys.push_back(std::move(keys_.data()[old]));
+        values.push_back(std::move(values_.data()[old]));
+        ++old;
+      } else {
+        keys.push_back(std::move(incoming.data()[add].first));
+        values.push_back(std::move(incoming.data()[add].second));
+        ++add;
+      }
+    }
+    keys_ = std::move(keys);
+    values_ = std::move(values);
+  }
+
+  // The iterator overload keeps erase(const K &) from catching iterators
+  iterator erase(iterator pos) { return erase(const_iterator(pos)); }
+
+  iterator erase(const_iterator pos) {
+    size_type index = pos.key - keys_.data();
+    keys_.erase(keys_.begin() + index);
+    values_.erase(values_.begin() + index);
+    return iteratorAt(index);
+  }
+
+  size_type erase(const Key &key) { return eraseKey(key); }
+
+  template <typename K, typename = if_transparent<K>>
+  size_type erase(const K &key) {
+    return eraseKey(key);
+  }
+
+  void swap(flat_map &other) {
+    keys_.swap(other.keys_);
+    values_.swap(other.values_);
+    std::swap(comp_, other.comp_);
+  }
+
+  // Moves the elements whose keys are missing here out of other, the rest
+  // stays in other. Both sides are sorted, so it is one pass over each.
+  void merge(flat_map &other) {
+    if (this == &other) {
+      return;
+    }
+    key_container_type keys, kept_keys;
+    mapped_container_type values, kept_values;
+    keys.reserve(size() + other.size());
+    values.reserve(size() + other.size());
+    size_type old = 0, add = 0;
+    while (old < size() || add < other.size()) {
+      bool take_add = old == size() ||
+                      (add < other.size() &&
+                       comp_(other.keys_.data()[add], keys_.data()[old]));
+      if (take_add) {
+        keys.push_back(std::move(other.keys_.data()[add]));
+        values.push_back(std::move(other.values_.data()[add]));
+        ++add;
+        continue;
+      }
+      if (add < other.size() &&
+          !comp_(keys_.data()[old], other.keys_.data()[add])) {
+        kept_keys.push_back(std::move(other.keys_.data()[add]));
+        kept_values.push_back(std::move(other.values_.data()[add]));
+        ++add;
+      }
+      keys.push_back(std::move(keys_.data()[old]));
+      values.push_back(std::move(values_.data()[old]));
+      ++old;
+    }
+    keys_ = std::move(keys);
+    values_ = std::move(values);
+    other.keys_ = std::move(kept_keys);
+    other.values_ = std::move(kept_values);
+  }
+
+  // Hands both arrays over without copying, the map is left empty
+  containers extract_sequence() {
+    return containers{std::move(keys_), std::move(values_)};
+  }
+
+  // Takes keys that must be sorted and unique and one value per key,
+  // throws otherwise
+  void replace(key_container_type &&keys, mapped_container_type &&values) {
+    if (keys.size() != values.size()) {
+      throw std::invalid_argument("keys and values differ in size");
+    }
+    if (!isStrictlySorted(keys.data(), keys.size(), comp_)) {
+      throw std::invalid_argument("keys are not sorted and unique");
+    }
+    keys_ = std::move(keys);
+    values_ = std::move(values);
+  }
+
+  // Flat_map Lookup
+
+  iterator find(const Key &key) { return iteratorAt(findIndex(key)); }
+
+  const_iterator find(const Key &key) const {
+    return iteratorAt(findIndex(key));
+  }
+
+  template <typename K, typename = if_transparent<K>>
+  iterator find(const K &key) {
+    return iteratorAt(findIndex(key));
+  }
+
+  template <typename K, typename = if_transparent<K>>
+  const_iterator find(const K &key) const {
+    return iteratorAt(findIndex(key));
+  }
+
+  bool contains(const Key &key) const { return findIndex(key) != size(); }
+
+  template <typename K, typename = if_transparent<K>>
+  bool contains(const K &key) const {
+    return findIndex(key) != size();
+  }
+
+  size_type count(const Key &key) const { return contains(key) ? 1 : 0; }
+
+  template <typename K, typename = if_transparent<K>>
+  size_type count(const K &key) const {
+    return contains(key) ? 1 : 0;
+  }
+
+  iterator lower_bound(const Key &key) {
+    return iteratorAt(lowerBoundIndex(keys_.data(), size(), key, comp_));
+  }
+
+  const_iterator lower_bound(const Key &key) const {
+    return iteratorAt(lowerBoundIndex(keys_.data(), size(), key, comp_));
+  }
+
+  template <typename K, typename = if_transparent<K>>
+  iterator lower_bound(const K &key) {
+    return iteratorAt(lowerBoundIndex(keys_.data(), size(), key, comp_));
+  }
+
+  template <typename K, typename = if_transparent<K>>
+  const_iterator lower_bound(const K &key) const {
+    return iteratorAt(lowerBoundIndex(keys_.data(), size(), key, comp_));
+  }
+
+  iterator upper_bound(const Key &key) {
+    return iteratorAt(upperBoundIndex(keys_.data(), size(), key, comp_));
+  }
+
+  const_iterator upper_bound(const Key &key) const {
+    return iteratorAt(upperBoundIndex(keys_.data(), size(), key, comp_));
+  }
+
+  template <typename K, typename = if_transparent<K>>
+  iterator upper_bound(const K &key) {
+    return iteratorAt(upperBoundIndex(keys_.data(), size(), key, comp_));
+  }
+
+  template <typename K, typename = if_transparent<K>>
+  const_iterator upper_bound(const K &key) const {
+    return iteratorAt(upperBoundIndex(keys_.data(), size(), key, comp_));
+  }
+
+  std::pair<iterator, iterator> equal_range(const Key &key) {
+    return std::make_pair(lower_bound(key), upper_bound(key));
+  }
+
+  std::pair<const_iterator, const_iterator> equal_range(
+      const Key &key) const {
+    return std::make_pair(lower_bound(key), upper_bound(key));
+  }
+
+  template <typename K, typename = if_transparent<K>>
+  std::pair<iterator, iterator> equal_range(const K &key) {
+    return std::make_pair(lower_bound(key), upper_bound(key));
+  }
+
+  template <typename K, typename = if_transparent<K>>
+  std::pair<const_iterator, const_iterator> equal_range(const K &key) const {
+    return std::make_pair(lower_bound(key), upper_bound(key));
+  }
+
+  key_compare key_comp() const { return comp_; }
+
+ private:
+  key_container_type keys_;
+  mapped_container_type values_;
+  Compare comp_;
+
+  iterator iteratorAt(size_type index) {
+    return iterator(keys_.data() + index, values_.data() + index);
+  }
+
+  const_iterator iteratorAt(size_type index) const {
+    return const_iterator(keys_.data() + index, values_.data() + index);
+  }
+
+  // Index of the key, size() when it is absent
+  template <typename K>
+  size_type findIndex(const K &key) const {
+    size_type index = lowerBoundIndex(keys_.data(), size(), key, comp_);
+    if (index == size() || comp_(key, keys_.data()[index])) {
+      return size();
+    }
+    return index;
+  }
+
+  T &valueAt(size_type index) {
+    if (index == size()) {
+      throw std::out_of_range("Not found key");
+    }
+    return values_.data()[index];
+  }
+
+  template <typename K, typename V>
+  void insertAt(size_type index, K &&key, V &&value) {
+    keys_.insert(keys_.begin() + index, Key(std::forward<K>(key)));
+    values_.insert(values_.begin() + index, T(std::forward<V>(value)));
+  }
+
+  template <typename K>
+  T &findOrInsert(const K &key) {
+    size_type index = lowerBoundIndex(keys_.data(), size(), key, comp_);
+    if (index == size() || comp_(key, keys_.data()[index])) {
+      insertAt(index, key, T());
+    }
+    return values_.data()[index];
+  }
+
+  template <typename K>
+  size_type eraseKey(const K &key) {
+    size_type index = findIndex(key);
+    if (index == size()) {
+      return 0;
+    }
+    erase(iteratorAt(index));
+    return 1;
+  }
+};
+}  // namespace s21
+
+#endif
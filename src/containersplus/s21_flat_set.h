@@ -0,0 +1,264 @@
+#ifndef __S21_FLAT_SET_H__
+#define __S21_FLAT_SET_H__
+
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <stdexcept>
+
+#include "../Tree/sorted_array.h"
+#include "../Tree/transparent.h"
+#include "../containers/s21_vector.h"
+
+namespace s21 {
+
+// Ordered set kept as a sorted s21::vector. Lookups are binary searches
+// over contiguous keys, inserts and erases shift the tail, so it suits
+// tables that are built once and read often. Iterators are plain pointers
+// and are invalidated by every modification.
+template <typename Key, typename Compare = std::less<Key>>
+class flat_set {
+ public:
+  // Flat_set Member type
+  using key_type = Key;
+  using value_type = Key;
+  using reference = value_type &;
+  using const_reference = const value_type &;
+  using iterator = const Key *;
+  using const_iterator = const Key *;
+  using reverse_iterator = std::reverse_iterator<iterator>;
+  using size_type = size_t;
+  using key_compare = Compare;
+  using container_type = vector<Key>;
+
+  // Overloads templated on K take any key type the comparator can order
+  // against Key, they exist only for transparent comparators
+  template <typename K>
+  using if_transparent =
+      std::enable_if_t<is_transparent<Compare>::value && sizeof(K) != 0>;
+
+  // Flat_set Member functions
+  flat_set() {}
+
+  flat_set(std::initializer_list<value_type> const &items)
+      : flat_set(items.begin(), items.end()) {}
+
+  template <typename InputIt, typename = typename std::iterator_traits<
+                                  InputIt>::iterator_category>
+  flat_set(InputIt first, InputIt last) {
+    insert(first, last);
+  }
+
+  // Adopts keys that are already sorted and unique
+  explicit flat_set(container_type &&keys) { replace(std::move(keys)); }
+
+  flat_set(const flat_set &other) = default;
+
+  flat_set(flat_set &&other) noexcept = default;
+
+  ~flat_set() {}
+
+  flat_set &operator=(const flat_set &other) = default;
+
+  flat_set &operator=(flat_set &&other) noexcept = default;
+
+  // Flat_set Iterators
+
+  iterator begin() const { return keys_.data(); }
+
+  iterator end() const { return keys_.data() + keys_.size(); }
+
+  reverse_iterator rbegin() const { return reverse_iterator(end()); }
+
+  reverse_iterator rend() const { return reverse_iterator(begin()); }
+
+  // Flat_set Capacity
+
+  bool empty() const { return keys_.empty(); }
+
+  size_type size() const { return keys_.size(); }
+
+  size_type max_size() const { return keys_.max_size(); }
+
+  // Flat_set Modifiers
+
+  void clear() { keys_.clear(); }
+
+  std::pair<iterator, bool> insert(const value_type &value) {
+    size_type index = lowerBoundIndex(begin(), size(), value, comp_);
+    if (index < size() && !comp_(value, begin()[index])) {
+      return {begin() + index, false};
+    }
+    keys_.insert(keys_.begin() + index, value);
+    return {begin() + index, true};
+  }
+
+  // Sorts the new keys and merges them with the stored ones in one pass.
+  // Keys already present, and repeats within the range, are skipped.
+  template <typename InputIt>
+  void insert(InputIt first, InputIt last) {
+    container_type incoming;
+    for (; first != last; ++first) {
+      incoming.push_back(*first);
+    }
+    size_type count = sortUnique(
+        incoming.data(), incoming.size(),
+        [](const Key &key) -> const Key & { return key; }, comp_);
+
+    container_type merged;
+    merged.reserve(size() + count);
+    Key *old = keys_.data(), *old_end = old + size();
+    Key *add = incoming.data(), *add_end = add + count;
+    while (old != old_end && add != add_end) {
+      if (comp_(*add, *old)) {
+        merged.push_back(std::move(*add++));
+      } else {
+        if (!comp_(*old, *add)) {
+          ++add;
+        }
+        merged.push_back(std::move(*old++));
+      }
+    }
+    for (; old != old_end; ++old) {
+      merged.push_back(std::move(*old));
+    }
+    for (; add != add_end; ++add) {
+      merged.push_back(std::move(*add));
+    }
+    keys_ = std::move(merged);
+  }
+
+  iterator erase(iterator pos) {
+    size_type index = pos - begin();
+    keys_.erase(keys_.begin() + index);
+    return begin() + index;
+  }
+
+  size_type erase(const Key &key) { return eraseKey(key); }
+
+  template <typename K, typename = if_transparent<K>>
+  size_type erase(const K &key) {
+    return eraseKey(key);
+  }
+
+  void swap(flat_set &other) {
+    keys_.swap(other.keys_);
+    std::swap(comp_, other.comp_);
+  }
+
+  // Moves the keys missing here out of other, the rest stays in other.
+  // Both sides are sorted, so it is one pass over each.
+  void merge(flat_set &other) {
+    if (this == &other) {
+      return;
+    }
+    container_type merged, kept;
+    merged.reserve(size() + other.size());
+    size_type old = 0, add = 0;
+    while (old < size() || add < other.size()) {
+      bool take_add = old == size() ||
+                      (add < other.size() &&
+                       comp_(other.keys_.data()[add], keys_.data()[old]));
+      if (take_add) {
+        merged.push_back(std::move(other.keys_.data()[add++]));
+        continue;
+      }
+      if (add < other.size() &&
+          !comp_(keys_.data()[old], other.keys_.data()[add])) {
+        kept.push_back(std::move(other.keys_.data()[add++]));
+      }
+      merged.push_back(std::move(keys_.data()[old++]));
+    }
+    keys_ = std::move(merged);
+    other.keys_ = std::move(kept);
+  }
+
+  // Hands the sorted keys over without copying, the set is left empty
+  container_type extract_sequence() { return std::move(keys_); }
+
+  // Takes keys that must be sorted and unique, throws otherwise
+  void replace(container_type &&keys) {
+    if (!isStrictlySorted(keys.data(), keys.size(), comp_)) {
+      throw std::invalid_argument("keys are not sorted and unique");
+    }
+    keys_ = std::move(keys);
+  }
+
+  // Flat_set Lookup
+
+  iterator find(const Key &key) const { return findKey(key); }
+
+  template <typename K, typename = if_transparent<K>>
+  iterator find(const K &key) const {
+    return findKey(key);
+  }
+
+  bool contains(const Key &key) const { return findKey(key) != end(); }
+
+  template <typename K, typename = if_transparent<K>>
+  bool contains(const K &key) const {
+    return findKey(key) != end();
+  }
+
+  size_type count(const Key &key) const { return contains(key) ? 1 : 0; }
+
+  template <typename K, typename = if_transparent<K>>
+  size_type count(const K &key) const {
+    return contains(key) ? 1 : 0;
+  }
+
+  iterator lower_bound(const Key &key) const {
+    return begin() + lowerBoundIndex(begin(), size(), key, comp_);
+  }
+
+  template <typename K, typename = if_transparent<K>>
+  iterator lower_bound(const K &key) const {
+    return begin() + lowerBoundIndex(begin(), size(), key, comp_);
+  }
+
+  iterator upper_bound(const Key &key) const {
+    return begin() + upperBoundIndex(begin(), size(), key, comp_);
+  }
+
+  template <typename K, typename = if_transparent<K>>
+  iterator upper_bound(const K &key) const {
+    return begin() + upperBoundIndex(begin(), size(), key, comp_);
+  }
+
+  std::pair<iterator, iterator> equal_range(const Key &key) const {
+    return std::make_pair(lower_bound(key), upper_bound(key));
+  }
+
+  template <typename K, typename = if_transparent<K>>
+  std::pair<iterator, iterator> equal_range(const K &key) const {
+    return std::make_pair(lower_bound(key), upper_bound(key));
+  }
+
+  key_compare key_comp() const { return comp_; }
+
+ private:
+  container_type keys_;
+  Compare comp_;
+
+  template <typename K>
+  iterator findKey(const K &key) const {
+    iterator pos = begin() + lowerBoundIndex(begin(), size(), key, comp_);
+    if (pos == end() || comp_(key, *pos)) {
+      return end();
+    }
+    return pos;
+  }
+
+  template <typename K>
+  size_type eraseKey(const K &key) {
+    iterator pos = findKey(key);
+    if (pos == end()) {
+      return 0;
+    }
+    erase(pos);
+    return 1;
+  }
+};
+}  // namespace s21
+
+#endif
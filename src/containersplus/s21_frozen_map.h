@@ -0,0 +1,348 @@
+#ifndef __S21_FROZEN_MAP_H__
+#define __S21_FROZEN_MAP_H__
+
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "../Tree/eytzinger.h"
+#include "../Tree/snapshot.h"
+#include "../Tree/sorted_array.h"
+#include "../Tree/transparent.h"
+#include "../containers/s21_map.h"
+
+namespace s21 {
+
+// Read-only map for tables that are built once and searched many times.
+// Keys and values sit in two arrays in the same Eytzinger order (see
+// eytzinger.h): lookups are branch-free descents over the keys alone, and
+// batches go through find_many() and contains_many(), which use AVX2 for
+// integral keys. The arrays are built from any range of pairs, such as a
+// map, or mapped from a file written by save_snapshot(), which costs
+// only page faults. Nothing is modified after construction, so one
+// frozen_map may be searched by any number of threads without locks.
+// Compare must order the keys as the map that wrote a mapped image did.
+// Iterators stay valid until the frozen_map is destroyed.
+template <typename Key, typename T, typename Compare = std::less<Key>>
+class frozen_map {
+  static_assert(std::is_trivially_copyable<Key>::value &&
+                    std::is_trivially_copyable<T>::value,
+                "frozen elements are raw bytes of trivially copyable types");
+
+ public:
+  // Frozen_map Member type
+  using key_type = Key;
+  using mapped_type = T;
+  using value_type = std::pair<const key_type, mapped_type>;
+  using reference = value_type;
+  using const_reference = value_type;
+  using size_type = size_t;
+  using key_compare = Compare;
+
+  // Overloads templated on K take any key type the comparator can order
+  // against Key, they exist only for transparent comparators
+  template <typename K>
+  using if_transparent =
+      std::enable_if_t<is_transparent<Compare>::value && sizeof(K) != 0>;
+
+  // Frozen_map Member functions
+  frozen_map() : keys_(nullptr), values_(nullptr), size_(0) {}
+
+  frozen_map(std::initializer_list<value_type> const &items)
+      : frozen_map(items.begin(), items.end()) {}
+
+  // Ranges sorted by unique keys, such as the elements of a map, are laid
+  // out in one pass, anything else is sorted first and keeps the first
+  // pair of every key
+  template <typename InputIt, typename = typename std::iterator_traits<
+                                  InputIt>::iterator_category>
+  frozen_map(InputIt first, InputIt last) : frozen_map() {
+    std::vector<std::pair<Key, T>> items;
+    for (; first != last; ++first) {
+      items.emplace_back(first->first, first->second);
+    }
+    auto key_of = [](const std::pair<Key, T> &item) -> const Key & {
+      return item.first;
+    };
+    size_type count = items.size();
+    for (size_type i = 1; i < count; ++i) {
+      if (!comp_(items[i - 1].first, items[i].first)) {
+        count = sortUnique(items.data(), count, key_of, comp_);
+        break;
+      }
+    }
+    adopt(SnapshotMapping::build<SnapshotType<Key, T>>(
+        count, [&items, count](SnapshotFiller &filler) {
+          for (size_type i = 0; i < count; ++i) {
+            filler.append(items[i].first, items[i].second);
+          }
+        }));
+  }
+
+  // Maps the image at path, throws std::runtime_error when it is missing,
+  // damaged or written for other element types
+  explicit frozen_map(const std::string &path) : frozen_map() {
+    adopt(SnapshotMapping::open<SnapshotType<Key, T>>(path));
+  }
+
+  frozen_map(const frozen_map &other) = delete;
+
+  frozen_map(frozen_map &&other) noexcept
+      : mapping_(std::move(other.mapping_)),
+        keys_(other.keys_),
+        values_(other.values_),
+        size_(other.size_),
+        comp_(std::move(other.comp_)) {
+    other.keys_ = nullptr;
+    other.values_ = nullptr;
+    other.size_ = 0;
+  }
+
+  ~frozen_map() {}
+
+  frozen_map &operator=(const frozen_map &other) = delete;
+
+  frozen_map &operator=(frozen_map &&other) noexcept {
+    if (this != &other) {
+      mapping_ = std::move(other.mapping_);
+      keys_ = other.keys_;
+      values_ = other.values_;
+      size_ = other.size_;
+      comp_ = std::move(other.comp_);
+      other.keys_ = nullptr;
+      other.values_ = nullptr;
+      other.size_ = 0;
+    }
+    return *this;
+  }
+
+  // Frozen_map Element access
+
+  const T &at(const Key &key) const { return valueAt(findSlot(key)); }
+
+  template <typename K, typename = if_transparent<K>>
+  const T &at(const K &key) const {
+    return valueAt(findSlot(key));
+  }
+
+  // Frozen_map Iterators
+
+  // Walks the slots in key order, O(1) amortized per step
+  class FrozenMapIterator {
+   public:
+    using iterator_category = std::bidirectional_iterator_tag;
+    using value_type = std::pair<const Key, T>;
+    using difference_type = std::ptrdiff_t;
+    using pointer = const value_type *;
+    using reference = value_type;
+
+    const Key *keys;
+    const T *values;
+    size_type slot;
+    size_type count;
+
+    FrozenMapIterator(const Key *k, const T *v, size_type s, size_type n)
+        : keys(k), values(v), slot(s), count(n) {}
+
+    std::pair<const Key, T> operator*() const {
+      return {keys[slot], values[slot]};
+    }
+
+    const Key &key() const { return keys[slot]; }
+
+    const T &value() const { return values[slot]; }
+
+    FrozenMapIterator &operator++() {
+      slot = eytzingerNext(slot, count);
+      return *this;
+    }
+
+    FrozenMapIterator operator++(int) {
+      FrozenMapIterator tmp = *this;
+      ++(*this);
+      return tmp;
+    }
+
+    FrozenMapIterator &operator--() {
+      slot = eytzingerPrev(slot, count);
+      return *this;
+    }
+
+    FrozenMapIterator operator--(int) {
+      FrozenMapIterator tmp = *this;
+      --(*this);
+      return tmp;
+    }
+
+    bool operator==(const FrozenMapIterator &other) const {
+      return slot == other.slot;
+    }
+
+    bool operator!=(const FrozenMapIterator &other) const {
+      return slot != other.slot;
+    }
+  };
+
+  using iterator = FrozenMapIterator;
+  using const_iterator = FrozenMapIterator;
+  using reverse_iterator = std::reverse_iterator<iterator>;
+
+  iterator begin() const { return iteratorAt(eytzingerFirst(size_)); }
+
+  iterator end() const { return iteratorAt(0); }
+
+  reverse_iterator rbegin() const { return reverse_iterator(end()); }
+
+  reverse_iterator rend() const { return reverse_iterator(begin()); }
+
+  // Frozen_map Capacity
+
+  bool empty() const { return size_ == 0; }
+
+  size_type size() const { return size_; }
+
+  // Frozen_map Lookup
+
+  iterator find(const Key &key) const { return iteratorAt(findSlot(key)); }
+
+  template <typename K, typename = if_transparent<K>>
+  iterator find(const K &key) const {
+    return iteratorAt(findSlot(key));
+  }
+
+  bool contains(const Key &key) const { return findSlot(key) != 0; }
+
+  template <typename K, typename = if_transparent<K>>
+  bool contains(const K &key) const {
+    return findSlot(key) != 0;
+  }
+
+  size_type count(const Key &key) const { return contains(key) ? 1 : 0; }
+
+  template <typename K, typename = if_transparent<K>>
+  size_type count(const K &key) const {
+    return contains(key) ? 1 : 0;
+  }
+
+  // Batched lookups, out[i] is find(keys[i]). keys is any indexable
+  // container of keys, such as a std::vector. The descents run in
+  // lockstep, gathered with AVX2 for integral keys when the processor
+  // has it, so a large batch costs far less than a loop of find().
+  template <typename Keys>
+  void find_many(const Keys &keys, std::vector<iterator> &out) const {
+    std::vector<size_type> slots = findSlots(keys);
+    out.clear();
+    out.reserve(slots.size());
+    for (size_type slot : slots) {
+      out.push_back(iteratorAt(slot));
+    }
+  }
+
+  // out[i] tells whether the map holds keys[i]
+  template <typename Keys>
+  void contains_many(const Keys &keys, std::vector<bool> &out) const {
+    std::vector<size_type> slots = findSlots(keys);
+    out.assign(slots.size(), false);
+    for (size_type i = 0; i < slots.size(); ++i) {
+      out[i] = slots[i] != 0;
+    }
+  }
+
+  iterator lower_bound(const Key &key) const {
+    return iteratorAt(eytzingerLowerBound(keys_, size_, key, comp_));
+  }
+
+  template <typename K, typename = if_transparent<K>>
+  iterator lower_bound(const K &key) const {
+    return iteratorAt(eytzingerLowerBound(keys_, size_, key, comp_));
+  }
+
+  iterator upper_bound(const Key &key) const {
+    return iteratorAt(eytzingerUpperBound(keys_, size_, key, comp_));
+  }
+
+  template <typename K, typename = if_transparent<K>>
+  iterator upper_bound(const K &key) const {
+    return iteratorAt(eytzingerUpperBound(keys_, size_, key, comp_));
+  }
+
+  std::pair<iterator, iterator> equal_range(const Key &key) const {
+    return std::make_pair(lower_bound(key), upper_bound(key));
+  }
+
+  template <typename K, typename = if_transparent<K>>
+  std::pair<iterator, iterator> equal_range(const K &key) const {
+    return std::make_pair(lower_bound(key), upper_bound(key));
+  }
+
+  key_compare key_comp() const { return comp_; }
+
+ private:
+  SnapshotMapping mapping_;
+  const Key *keys_;
+  const T *values_;
+  size_type size_;
+  Compare comp_;
+
+  void adopt(SnapshotMapping &&mapping) {
+    mapping_ = std::move(mapping);
+    keys_ = mapping_.keys<Key>();
+    values_ = mapping_.values<T>();
+    size_ = mapping_.count();
+  }
+
+  iterator iteratorAt(size_type slot) const {
+    return iterator(keys_, values_, slot, size_);
+  }
+
+  // Slot of the key, 0 when it is absent
+  template <typename K>
+  size_type findSlot(const K &key) const {
+    size_type slot = eytzingerLowerBound(keys_, size_, key, comp_);
+    return slot != 0 && comp_(key, keys_[slot]) ? 0 : slot;
+  }
+
+  template <typename Keys>
+  std::vector<size_type> findSlots(const Keys &keys) const {
+    std::vector<size_type> slots(keys.size());
+    eytzingerLowerBoundMany(keys_, size_, keys, comp_, slots.data());
+    for (size_type i = 0; i < slots.size(); ++i) {
+      if (slots[i] != 0 && comp_(keys[i], keys_[slots[i]])) {
+        slots[i] = 0;
+      }
+    }
+    return slots;
+  }
+
+  const T &valueAt(size_type slot) const {
+    if (slot == 0) {
+      throw std::out_of_range("Not found key");
+    }
+    return values_[slot];
+  }
+};
+
+// Writes the elements of items as a page-aligned binary image that
+// frozen_map maps back without parsing. The file is replaced atomically;
+// throws std::runtime_error when it cannot be written.
+template <typename Key, typename T, typename Compare, typename Stats>
+void save_snapshot(const map<Key, T, Compare, Stats> &items,
+                   const std::string &path) {
+  static_assert(std::is_trivially_copyable<Key>::value &&
+                    std::is_trivially_copyable<T>::value,
+                "snapshots hold raw bytes of trivially copyable elements");
+  SnapshotWriter writer(path,
+                        snapshotLayout<SnapshotType<Key, T>>(items.size()));
+  for (const auto &item : items) {
+    writer.append(item.first, item.second);
+  }
+  writer.commit();
+}
+}  // namespace s21
+
+#endif
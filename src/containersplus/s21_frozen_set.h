@@ -0,0 +1,309 @@
+#ifndef __S21_FROZEN_SET_H__
+#define __S21_FROZEN_SET_H__
+
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "../Tree/eytzinger.h"
+#include "../Tree/snapshot.h"
+#include "../Tree/sorted_array.h"
+#include "../Tree/transparent.h"
+#include "../containers/s21_set.h"
+
+namespace s21 {
+
+// Read-only set for keys that are built once and searched many times. The
+// keys sit in one array in Eytzinger order (see eytzinger.h), so a lookup
+// is a branch-free descent whose next cache lines are prefetched, and
+// batches go through find_many() and contains_many(), which use AVX2 for
+// integral keys. The array is built from any range, such as a set, or
+// mapped from a file written by save_snapshot(), which costs only
+// page faults. Nothing is modified after construction, so one frozen_set
+// may be searched by any number of threads without locks. Compare must
+// order the keys as the set that wrote a mapped image did. Iterators stay
+// valid until the frozen_set is destroyed.
+template <typename Key, typename Compare = std::less<Key>>
+class frozen_set {
+  static_assert(std::is_trivially_copyable<Key>::value,
+                "frozen keys are raw bytes of trivially copyable keys");
+
+ public:
+  // Frozen_set Member type
+  using key_type = Key;
+  using value_type = Key;
+  using reference = const value_type &;
+  using const_reference = const value_type &;
+  using size_type = size_t;
+  using key_compare = Compare;
+
+  // Overloads templated on K take any key type the comparator can order
+  // against Key, they exist only for transparent comparators
+  template <typename K>
+  using if_transparent =
+      std::enable_if_t<is_transparent<Compare>::value && sizeof(K) != 0>;
+
+  // Frozen_set Member functions
+  frozen_set() : keys_(nullptr), size_(0) {}
+
+  frozen_set(std::initializer_list<value_type> const &items)
+      : frozen_set(items.begin(), items.end()) {}
+
+  // Sorted unique ranges, such as the elements of a set, are laid out in
+  // one pass, anything else is sorted first and keeps one of equal keys
+  template <typename InputIt, typename = typename std::iterator_traits<
+                                  InputIt>::iterator_category>
+  frozen_set(InputIt first, InputIt last) : frozen_set() {
+    std::vector<Key> keys(first, last);
+    size_type count = keys.size();
+    if (!isStrictlySorted(keys.data(), count, comp_)) {
+      count = sortUnique(
+          keys.data(), count, [](const Key &key) -> const Key & { return key; },
+          comp_);
+    }
+    adopt(SnapshotMapping::build<SnapshotType<Key, void>>(
+        count, [&keys, count](SnapshotFiller &filler) {
+          for (size_type i = 0; i < count; ++i) {
+            filler.append(keys[i]);
+          }
+        }));
+  }
+
+  // Maps the image at path, throws std::runtime_error when it is missing,
+  // damaged or written for other key types
+  explicit frozen_set(const std::string &path) : frozen_set() {
+    adopt(SnapshotMapping::open<SnapshotType<Key, void>>(path));
+  }
+
+  frozen_set(const frozen_set &other) = delete;
+
+  frozen_set(frozen_set &&other) noexcept
+      : mapping_(std::move(other.mapping_)),
+        keys_(other.keys_),
+        size_(other.size_),
+        comp_(std::move(other.comp_)) {
+    other.keys_ = nullptr;
+    other.size_ = 0;
+  }
+
+  ~frozen_set() {}
+
+  frozen_set &operator=(const frozen_set &other) = delete;
+
+  frozen_set &operator=(frozen_set &&other) noexcept {
+    if (this != &other) {
+      mapping_ = std::move(other.mapping_);
+      keys_ = other.keys_;
+      size_ = other.size_;
+      comp_ = std::move(other.comp_);
+      other.keys_ = nullptr;
+      other.size_ = 0;
+    }
+    return *this;
+  }
+
+  // Frozen_set Iterators
+
+  // Walks the slots in key order, O(1) amortized per step
+  class FrozenSetIterator {
+   public:
+    using iterator_category = std::bidirectional_iterator_tag;
+    using value_type = Key;
+    using difference_type = std::ptrdiff_t;
+    using pointer = const Key *;
+    using reference = const Key &;
+
+    const Key *keys;
+    size_type slot;
+    size_type count;
+
+    FrozenSetIterator(const Key *k, size_type s, size_type n)
+        : keys(k), slot(s), count(n) {}
+
+    reference operator*() const { return keys[slot]; }
+
+    pointer operator->() const { return keys + slot; }
+
+    FrozenSetIterator &operator++() {
+      slot = eytzingerNext(slot, count);
+      return *this;
+    }
+
+    FrozenSetIterator operator++(int) {
+      FrozenSetIterator tmp = *this;
+      ++(*this);
+      return tmp;
+    }
+
+    FrozenSetIterator &operator--() {
+      slot = eytzingerPrev(slot, count);
+      return *this;
+    }
+
+    FrozenSetIterator operator--(int) {
+      FrozenSetIterator tmp = *this;
+      --(*this);
+      return tmp;
+    }
+
+    bool operator==(const FrozenSetIterator &other) const {
+      return slot == other.slot;
+    }
+
+    bool operator!=(const FrozenSetIterator &other) const {
+      return slot != other.slot;
+    }
+  };
+
+  using iterator = FrozenSetIterator;
+  using const_iterator = FrozenSetIterator;
+  using reverse_iterator = std::reverse_iterator<iterator>;
+
+  iterator begin() const { return iteratorAt(eytzingerFirst(size_)); }
+
+  iterator end() const { return iteratorAt(0); }
+
+  reverse_iterator rbegin() const { return reverse_iterator(end()); }
+
+  reverse_iterator rend() const { return reverse_iterator(begin()); }
+
+  // Frozen_set Capacity
+
+  bool empty() const { return size_ == 0; }
+
+  size_type size() const { return size_; }
+
+  // Frozen_set Lookup
+
+  iterator find(const Key &key) const { return iteratorAt(findSlot(key)); }
+
+  template <typename K, typename = if_transparent<K>>
+  iterator find(const K &key) const {
+    return iteratorAt(findSlot(key));
+  }
+
+  bool contains(const Key &key) const { return findSlot(key) != 0; }
+
+  template <typename K, typename = if_transparent<K>>
+  bool contains(const K &key) const {
+    return findSlot(key) != 0;
+  }
+
+  size_type count(const Key &key) const { return contains(key) ? 1 : 0; }
+
+  template <typename K, typename = if_transparent<K>>
+  size_type count(const K &key) const {
+    return contains(key) ? 1 : 0;
+  }
+
+  // Batched lookups, out[i] is find(keys[i]). keys is any indexable
+  // container of keys, such as a std::vector. The descents run in
+  // lockstep, gathered with AVX2 for integral keys when the processor
+  // has it, so a large batch costs far less than a loop of find().
+  template <typename Keys>
+  void find_many(const Keys &keys, std::vector<iterator> &out) const {
+    std::vector<size_type> slots = findSlots(keys);
+    out.clear();
+    out.reserve(slots.size());
+    for (size_type slot : slots) {
+      out.push_back(iteratorAt(slot));
+    }
+  }
+
+  // out[i] tells whether the set holds keys[i]
+  template <typename Keys>
+  void contains_many(const Keys &keys, std::vector<bool> &out) const {
+    std::vector<size_type> slots = findSlots(keys);
+    out.assign(slots.size(), false);
+    for (size_type i = 0; i < slots.size(); ++i) {
+      out[i] = slots[i] != 0;
+    }
+  }
+
+  iterator lower_bound(const Key &key) const {
+    return iteratorAt(eytzingerLowerBound(keys_, size_, key, comp_));
+  }
+
+  template <typename K, typename = if_transparent<K>>
+  iterator lower_bound(const K &key) const {
+    return iteratorAt(eytzingerLowerBound(keys_, size_, key, comp_));
+  }
+
+  iterator upper_bound(const Key &key) const {
+    return iteratorAt(eytzingerUpperBound(keys_, size_, key, comp_));
+  }
+
+  template <typename K, typename = if_transparent<K>>
+  iterator upper_bound(const K &key) const {
+    return iteratorAt(eytzingerUpperBound(keys_, size_, key, comp_));
+  }
+
+  std::pair<iterator, iterator> equal_range(const Key &key) const {
+    return std::make_pair(lower_bound(key), upper_bound(key));
+  }
+
+  template <typename K, typename = if_transparent<K>>
+  std::pair<iterator, iterator> equal_range(const K &key) const {
+    return std::make_pair(lower_bound(key), upper_bound(key));
+  }
+
+  key_compare key_comp() const { return comp_; }
+
+ private:
+  SnapshotMapping mapping_;
+  const Key *keys_;
+  size_type size_;
+  Compare comp_;
+
+  void adopt(SnapshotMapping &&mapping) {
+    mapping_ = std::move(mapping);
+    keys_ = mapping_.keys<Key>();
+    size_ = mapping_.count();
+  }
+
+  iterator iteratorAt(size_type slot) const {
+    return iterator(keys_, slot, size_);
+  }
+
+  // Slot of the key, 0 when it is absent
+  template <typename K>
+  size_type findSlot(const K &key) const {
+    size_type slot = eytzingerLowerBound(keys_, size_, key, comp_);
+    return slot != 0 && comp_(key, keys_[slot]) ? 0 : slot;
+  }
+
+  template <typename Keys>
+  std::vector<size_type> findSlots(const Keys &keys) const {
+    std::vector<size_type> slots(keys.size());
+    eytzingerLowerBoundMany(keys_, size_, keys, comp_, slots.data());
+    for (size_type i = 0; i < slots.size(); ++i) {
+      if (slots[i] != 0 && comp_(keys[i], keys_[slots[i]])) {
+        slots[i] = 0;
+      }
+    }
+    return slots;
+  }
+};
+
+// Writes the values of items as a page-aligned binary image that
+// frozen_set maps back without parsing. The file is replaced atomically;
+// throws std::runtime_error when it cannot be written.
+template <typename Key, typename Compare, typename Stats>
+void save_snapshot(const set<Key, Compare, Stats> &items,
+                   const std::string &path) {
+  static_assert(std::is_trivially_copyable<Key>::value,
+                "snapshots hold raw bytes of trivially copyable keys");
+  SnapshotWriter writer(path,
+                        snapshotLayout<SnapshotType<Key, void>>(items.size()));
+  for (const Key &key : items) {
+    writer.append(key);
+  }
+  writer.commit();
+}
+}  // namespace s21
+
+#endif
@@ -0,0 +1,330 @@
+#ifndef __S21_INTERVAL_MAP_H__
+#define __S21_INTERVAL_MAP_H__
+
+#include <algorithm>
+#include <limits>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "../Tree/aggregate.h"
+#include "../Tree/tree.h"
+
+namespace s21 {
+
+// Half-open interval [start, end)
+template <typename Point>
+struct interval {
+  Point start;
+  Point end;
+};
+
+// How interval_map reads the endpoints of its intervals: start and end
+// members, or first and second for std::pair
+template <typename Interval>
+struct interval_traits {
+  using point_type = std::remove_cv_t<decltype(std::declval<Interval>().start)>;
+
+  static const point_type &start(const Interval &i) { return i.start; }
+  static const point_type &end(const Interval &i) { return i.end; }
+};
+
+template <typename Point>
+struct interval_traits<std::pair<Point, Point>> {
+  using point_type = Point;
+
+  static const point_type &start(const std::pair<Point, Point> &i) {
+    return i.first;
+  }
+  static const point_type &end(const std::pair<Point, Point> &i) {
+    return i.second;
+  }
+};
+
+// Orders intervals by start, then by end
+template <typename Interval, typename Traits = interval_traits<Interval>>
+struct interval_less {
+  bool operator()(const Interval &a, const Interval &b) const {
+    if (Traits::start(a) < Traits::start(b)) {
+      return true;
+    }
+    if (Traits::start(b) < Traits::start(a)) {
+      return false;
+    }
+    return Traits::end(a) < Traits::end(b);
+  }
+};
+
+// Largest end point of a subtree, the augmentation of an interval tree
+template <typename Interval, typename Traits = interval_traits<Interval>>
+struct interval_end_aggregate {
+  using value_type = typename Traits::point_type;
+
+  static value_type identity() { return MaxAggregate<value_type>::identity(); }
+
+  template <typename T>
+  static value_type lift(const Interval &key, const T &) {
+    return Traits::end(key);
+  }
+
+  static value_type combine(const value_type &a, const value_type &b) {
+    return std::max(a, b);
+  }
+};
+
+// Interval tree: a multimap from half-open intervals to values, ordered by
+// start and kept on Tree with the largest end point of every subtree as
+// its aggregate. Stabbing and overlap queries skip every subtree that ends
+// too early or starts too late and cost O(log n) per interval reported.
+// Points need operator< and std::numeric_limits.
+template <typename Interval, typename T,
+          typename Traits = interval_traits<Interval>,
+          typename Stats = TreeNoStats>
+class interval_map
+    : public Tree<Interval, T, interval_less<Interval, Traits>,
+                  interval_end_aggregate<Interval, Traits>, Stats> {
+  using Base = Tree<Interval, T, interval_less<Interval, Traits>,
+                    interval_end_aggregate<Interval, Traits>, Stats>;
+  using typename Base::Node;
+  using Base::root;
+
+ public:
+  // Interval_map Member type
+  using key_type = Interval;
+  using mapped_type = T;
+  using value_type = std::pair<const key_type, mapped_type>;
+  using reference = value_type &;
+  using const_reference = const value_type &;
+  using size_type = size_t;
+  using point_type = typename Traits::point_type;
+  using key_compare = interval_less<Interval, Traits>;
+  using stats_type = TreeStats;
+
+  // Interval_map Member functions
+  interval_map() : Base() {}
+
+  interval_map(std::initializer_list<value_type> const &items) {
+    for (const value_type &item : items) {
+      insert(item);
+    }
+  }
+
+  interval_map(const interval_map &other) : Base(other) {}
+
+  interval_map(interval_map &&other) noexcept : Base(std::move(other)) {}
+
+  ~interval_map() {}
+
+  interval_map &operator=(interval_map &&other) {
+    if (this != &other) {
+      this->moveTree(other);
+    }
+    return *this;
+  }
+
+  // Interval_map Iterators
+
+  // Iterates in interval order. Values may be changed, intervals may not.
+  class IntervalMapIterator {
+   public:
+    using iterator_category = std::bidirectional_iterator_tag;
+    using value_type = std::pair<const Interval, T>;
+    using difference_type = std::ptrdiff_t;
+    using pointer = value_type *;
+    using reference = value_type &;
+
+    Node *current;
+    IntervalMapIterator(Node *node) : current(node) {}
+
+    reference operator*() const { return current->data; }
+
+    pointer operator->() const { return &current->data; }
+
+    IntervalMapIterator &operator++() {
+      current = Base::nextNode(current);
+      return *this;
+    }
+
+    IntervalMapIterator operator++(int) {
+      IntervalMapIterator tmp = *this;
+      ++(*this);
+      return tmp;
+    }
+
+    IntervalMapIterator &operator--() {
+      current = Base::prevNode(current);
+      return *this;
+    }
+
+    IntervalMapIterator operator--(int) {
+      IntervalMapIterator tmp = *this;
+      --(*this);
+      return tmp;
+    }
+
+    bool operator==(const IntervalMapIterator &other) const {
+      return current == other.current;
+    }
+
+    bool operator!=(const IntervalMapIterator &other) const {
+      return current != other.current;
+    }
+  };
+
+  using iterator = IntervalMapIterator;
+  using reverse_iterator = std::reverse_iterator<iterator>;
+
+  iterator begin() { return iterator(this->firstNode()); }
+
+  iterator end() { return iterator(this->endNode()); }
+
+  reverse_iterator rbegin() { return reverse_iterator(end()); }
+
+  reverse_iterator rend() { return reverse_iterator(begin()); }
+
+  // Interval_map Capacity
+
+  bool empty() { return root == nullptr; }
+
+  size_type size() { return this->getSize(root); }
+
+  size_type max_size() {
+    return std::numeric_limits<size_type>::max() / sizeof(Node);
+  }
+
+  // Interval_map Modifiers
+
+  void clear() { this->clearTree(); }
+
+  // Equal intervals are kept side by side, the new one last
+  iterator insert(const value_type &value) {
+    return insert(value.first, value.second);
+  }
+
+  iterator insert(const Interval &key, const T &obj) {
+    return iterator(this->emplaceKey(key, false, std::piecewise_construct,
+                                     key, obj)
+                        .first);
+  }
+
+  iterator erase(iterator pos) {
+    if (pos == end()) {
+      return end();
+    }
+    return iterator(this->eraseNode(pos.current));
+  }
+
+  // Erases every entry with exactly this interval
+  size_type erase(const Interval &key) {
+    Node *first = this->lowerBoundNode(root, key);
+    Node *last = this->nodeOrEnd(this->upperBoundNode(root, key));
+    size_type before = size();
+    if (first != nullptr) {
+      this->eraseRange(first, last);
+    }
+    return before - size();
+  }
+
+  void swap(interval_map &other) { this->swapTree(other); }
+
+  // Interval_map Lookup
+
+  // First entry with exactly this interval
+  iterator find(const Interval &key) {
+    Node *node = this->lowerBoundNode(root, key);
+    if (node == nullptr || this->comp(key, node->key())) {
+      return end();
+    }
+    return iterator(node);
+  }
+
+  bool contains(const Interval &key) { return find(key) != end(); }
+
+  // Calls visit(interval, value) for every interval containing point, in
+  // interval order. A visitor returning bool stops by returning false.
+  template <typename Visit>
+  void for_each_containing(const point_type &point, Visit visit) {
+    auto step = [&visit](Node *node) {
+      return Base::callVisitor(visit, node->key(), node->value());
+    };
+    visitNodes(root, point, point, true, step);
+  }
+
+  // Same for every interval sharing a point with [lo, hi)
+  template <typename Visit>
+  void for_each_overlapping(const point_type &lo, const point_type &hi,
+                            Visit visit) {
+    auto step = [&visit](Node *node) {
+      return Base::callVisitor(visit, node->key(), node->value());
+    };
+    if (lo < hi) {
+      visitNodes(root, lo, hi, false, step);
+    }
+  }
+
+  std::vector<iterator> containing(const point_type &point) {
+    std::vector<iterator> found;
+    auto push = [&found](Node *node) {
+      found.push_back(iterator(node));
+      return true;
+    };
+    visitNodes(root, point, point, true, push);
+    return found;
+  }
+
+  std::vector<iterator> overlapping(const point_type &lo,
+                                    const point_type &hi) {
+    std::vector<iterator> found;
+    auto push = [&found](Node *node) {
+      found.push_back(iterator(node));
+      return true;
+    };
+    if (lo < hi) {
+      visitNodes(root, lo, hi, false, push);
+    }
+    return found;
+  }
+
+  size_type count_containing(const point_type &point) {
+    size_type count = 0;
+    for_each_containing(point, [&count](const Interval &, T &) { ++count; });
+    return count;
+  }
+
+  key_compare key_comp() const { return this->comp; }
+
+  // Interval_map Diagnostics
+
+  // Shape of the tree as map::stats() reports it, counters included when
+  // Stats is TreeCountStats
+  stats_type stats() { return this->treeStats(); }
+
+  void reset_stats() { this->resetStats(); }
+
+ private:
+  // In-order walk of the subtree over the intervals that end after lo and
+  // start before hi, or at hi when closed is set, until visit(node)
+  // returns false. A subtree whose largest end is not after lo holds no
+  // match, and neither does anything right of a node starting too late.
+  template <typename Visit>
+  bool visitNodes(Node *node, const point_type &lo, const point_type &hi,
+                  bool closed, Visit &visit) {
+    if (node == nullptr || !(lo < node->aggregate)) {
+      return true;
+    }
+    if (!visitNodes(node->left, lo, hi, closed, visit)) {
+      return false;
+    }
+    const point_type &start = Traits::start(node->key());
+    if (closed ? hi < start : !(start < hi)) {
+      return true;
+    }
+    if (lo < Traits::end(node->key()) && !visit(node)) {
+      return false;
+    }
+    return visitNodes(node->right, lo, hi, closed, visit);
+  }
+};
+}  // namespace s21
+
+#endif
@@ -2,6 +2,7 @@
 #define __S21_MULTISET_H__
 
 #include <iostream>
+#include <iterator>
 #include <limits>
 #include <stack>
 
@@ -9,71 +10,103 @@
 
 namespace s21 {
 
-template <typename Key>
-class multiset : public Tree<Key, Key> {
-  using Tree<Key, Key>::root;
-  using Tree<Key, Key>::insertTree;
-  using Tree<Key, Key>::printTree;
-  using Tree<Key, Key>::copyTree;
-  using Tree<Key, Key>::erase;
-  using Tree<Key, Key>::deleteTree;
-  using Tree<Key, Key>::getSize;
-  using Tree<Key, Key>::insertWithDuplicates; 
-  using typename Tree<Key, Key>::Node;
+template <typename Key, typename Compare = std::less<Key>,
+          typename Stats = TreeNoStats>
+class multiset
+    : public Tree<Key, TreeNoValue, Compare, TreeNoAggregate, Stats> {
+  using Base = Tree<Key, TreeNoValue, Compare, TreeNoAggregate, Stats>;
+  using Base::root;
+  using Base::printTree;
+  using Base::copyTree;
+  using Base::isSortedRange;
+  using Base::erase;
+  using Base::deleteTree;
+  using Base::createNode;
+  using Base::clearTree;
+  using Base::moveTree;
+  using Base::nodeOrEnd;
+  using Base::eraseKey;
+  using Base::getSize;
+  using Base::nthNode;
+  using Base::countLess;
+  using Base::countRange;
+  using Base::findInTree;
+  using Base::lowerBoundNode;
+  using Base::upperBoundNode;
+  using Base::countLessOrEqual;
+  using typename Base::Node;
+  using typename Base::SetOperation;
+  using Base::applySetOperation;
 
   using key_type = Key;
   using value_type = Key;
   using reference = value_type&;
   using const_reference = const value_type&;
   using size_type = size_t;
+  using key_compare = Compare;
+  using stats_type = TreeStats;
 
- public:
-  multiset() : Tree<Key, Key>() {}
+  // Overloads templated on K take any key type the comparator can order
+  // against Key, they exist only for transparent comparators
+  template <typename K>
+  using if_transparent =
+      std::enable_if_t<is_transparent<Compare>::value && sizeof(K) != 0>;
 
-  multiset(std::initializer_list<value_type> const& items) {
-    for (const value_type& value : items) {
-      insert(value);
+ public:
+  multiset() : Base() {}
+
+  multiset(std::initializer_list<value_type> const& items)
+      : multiset(items.begin(), items.end()) {}
+
+  // Sorted forward ranges are built in O(n), anything else goes through
+  // insert one by one
+  template <typename InputIt, typename = typename std::iterator_traits<
+                                  InputIt>::iterator_category>
+  multiset(InputIt first, InputIt last) {
+    using category = typename std::iterator_traits<InputIt>::iterator_category;
+    using item = typename std::iterator_traits<InputIt>::value_type;
+    if constexpr (std::is_base_of_v<std::forward_iterator_tag, category> &&
+                  std::is_same_v<item, Key>) {
+      auto key_of = [](const auto& v) -> const Key& { return v; };
+      if (isSortedRange(first, last, false, key_of)) {
+        this->build_from_sorted(first, last);
+        return;
+      }
+    }
+    for (; first != last; ++first) {
+      insert(*first);
     }
   }
 
-  multiset(const multiset& s) : Tree<Key, Key>(s) {}
+  multiset(const multiset& s) : Base(s) {}
 
-  multiset(multiset&& s) noexcept : Tree<Key, Key>(std::move(s)) {}
+  multiset(multiset&& s) noexcept
+      : Base(std::move(s)) {}
 
   ~multiset() {}
 
   multiset& operator=(multiset&& s) noexcept {
     if (this != &s) {
-      deleteTree(root);
-      root = s.root;
-      s.root = nullptr;
+      moveTree(s);
     }
     return *this;
   }
 
   class MultisetIterator {
    public:
+    using iterator_category = std::bidirectional_iterator_tag;
+    using value_type = Key;
+    using difference_type = std::ptrdiff_t;
+    using pointer = Key*;
+    using reference = Key&;
+
     Node* current;
     MultisetIterator(Node* node) : current(node) {}
 
-    reference operator*() { return current->key; }
+    reference operator*() { return current->data; }
 
     MultisetIterator& operator++() {
-      if (current != nullptr) {
-        if (current->right) {
-          current = current->right;
-          while (current->left) {
-            current = current->left;
-          }
-        } else {
-          Node* parent = current->parent;
-          while (parent && current == parent->right) {
-            current = parent;
-            parent = parent->parent;
-          }
-          current = parent;
-        }
-      }
+      current = Base::nextNode(current);
       return *this;
     }
 
@@ -85,21 +118,7 @@ class multiset : public Tree<Key, Key> {
     }
 
     MultisetIterator& operator--() {
-      if (current != nullptr) {
-        if (current->left) {
-          current = current->left;
-          while (current->right) {
-            current = current->right;
-          }
-        } else {
-          Node* parent = current->parent;
-          while (parent && current == parent->left) {
-            current = parent;
-            parent = parent->parent;
-          }
-          current = parent;
-        }
-      }
+      current = Base::prevNode(current);
       return *this;
     }
 
@@ -119,26 +138,35 @@ class multiset : public Tree<Key, Key> {
   };
 
   using iterator = MultisetIterator;
+  using reverse_iterator = std::reverse_iterator<iterator>;
 
-  iterator begin() {
-    Node* current = root;
-    while (current && current->left) {
-      current = current->left;
-    }
-    return iterator(current);
-  }
+  iterator begin() { return iterator(this->firstNode()); }
+
+  iterator end() { return iterator(this->endNode()); }
 
-  iterator end() { return iterator(nullptr); }
+  reverse_iterator rbegin() { return reverse_iterator(end()); }
+
+  reverse_iterator rend() { return reverse_iterator(begin()); }
 
   class MultisetConstIterator : public MultisetIterator {
    public:
     MultisetConstIterator(Node* node) : MultisetIterator(node) {}
 
-    const_reference operator*() const { return this->current->key; }
+    const_reference operator*() const { return this->current->data; }
   };
 
   using const_iterator = MultisetConstIterator;
 
+  // erase(const K&) never takes the multiset's own iterators, like
+  // std::multiset, so erase(pos) with a const_iterator erases at pos
+  template <typename K>
+  using if_transparent_key =
+      std::enable_if_t<!std::is_convertible_v<const K&, iterator> &&
+                           !std::is_convertible_v<const K&, const_iterator>,
+                       if_transparent<K>>;
+
+  using node_type = typename Base::NodeHandle;
+
   bool empty() {
     if (root == nullptr) {
       return true;
@@ -147,153 +175,245 @@ class multiset : public Tree<Key, Key> {
     }
   }
 
-  size_type size() {
-    int count = 0;
-    return getSize(root, count);
-  }
+  size_type size() { return getSize(root); }
 
   size_type max_size() {
     return std::numeric_limits<size_type>::max() / sizeof(Key);
   }
 
-  void clear() {
-    deleteTree(root);
-    root = nullptr;
-  }
+  void clear() { clearTree(); }
 
   iterator insert(const value_type& value) {
-    Node* pt = new Node(value);
+    return iterator(this->emplaceKey(value, false, value).first);
+  }
 
-    if (root == nullptr) {
-      root = pt;
-      return iterator(pt);
+  iterator insert(value_type&& value) {
+    return iterator(this->emplaceKey(value, false, std::move(value)).first);
+  }
+
+  // Inserts as close as possible before hint, in O(1) plus rebalancing
+  // when the hint is right, as when appending ascending values with end()
+  iterator insert(iterator hint, const value_type& value) {
+    return iterator(this->emplaceHint(hint.current, value, false, value).first);
+  }
+
+  iterator insert(iterator hint, value_type&& value) {
+    return iterator(
+        this->emplaceHint(hint.current, value, false, std::move(value)).first);
+  }
+
+  template <typename... Args>
+  iterator emplace(Args&&... args) {
+    return insert(value_type(std::forward<Args>(args)...));
+  }
+
+  template <typename... Args>
+  iterator emplace_hint(iterator hint, Args&&... args) {
+    return insert(hint, value_type(std::forward<Args>(args)...));
+  }
+
+  // Unlinks the node of pos, which need not be the first of its equal
+  // elements, and returns the element after it
+  iterator erase(iterator pos) {
+    if (pos == end()) {
+      return end();
     }
-    Node* insertedNode = insertWithDuplicates(root, pt);
+    return iterator(this->eraseNode(pos.current));
+  }
 
-    if (insertedNode == pt) {
-      return iterator(pt);
-    } else {
-      return iterator(insertedNode);
+  // Erases [first, last) in O(log n + k) and returns last
+  iterator erase(iterator first, iterator last) {
+    this->eraseRange(first.current, last.current);
+    return last;
+  }
+
+  size_type erase(const Key& key) { return eraseAll(key); }
+
+  template <typename K, typename = if_transparent_key<K>>
+  size_type erase(const K& key) {
+    return eraseAll(key);
+  }
+
+  // Node handles move elements between multisets. insert() relinks the
+  // node into any multiset without a copy, the multiset keeps the slabs of
+  // the pool it came from alive. extract(key) unlinks the first element
+  // equal to key, an empty handle means there was none.
+  node_type extract(iterator pos) { return this->extractNode(pos.current); }
+
+  node_type extract(const Key& key) {
+    Node* node = lowerBoundNode(root, key);
+    if (node == nullptr || this->comp(key, node->key())) {
+      return node_type();
     }
+    return this->extractNode(node);
   }
 
-  void erase(iterator pos) {
-    if (pos.current != nullptr) {
-      root = erase(root, pos.current->key);
+  // Links the node of nh in after the elements equal to it
+  iterator insert(node_type&& nh) {
+    if (nh.empty()) {
+      return end();
     }
+    return iterator(this->insertHandle(nh, false).first);
   }
 
-  void swap(multiset& other) {
-    Node* tmp = this->root;
-    this->root = copyTree(other.root);
-    other.root = copyTree(tmp);
+  void swap(multiset& other) { this->swapTree(other); }
+
+  // Relinks every node of other into this multiset, equal elements go
+  // after the ones already here. other ends up empty. No node is
+  // allocated or copied.
+  void merge(multiset& other) { this->spliceFrom(other, false); }
+
+  // Multiset Algebra. other is drained: its nodes are moved into this
+  // multiset or destroyed, no node is allocated. The overloads taking a
+  // ThreadPool process independent subtrees in parallel.
+
+  void set_union(multiset& other) {
+    applySetOperation(other, SetOperation::Union, false);
   }
 
-  void merge(multiset& other) {
-    for (auto iter{other.begin()}; iter != other.end(); ++iter) {
-      Node* pt = new Node(*iter);
-      root = insertTree(root, pt);
-    }
+  void set_union(multiset& other, ThreadPool& workers) {
+    applySetOperation(other, SetOperation::Union, false, workers);
+  }
+
+  void set_intersection(multiset& other) {
+    applySetOperation(other, SetOperation::Intersection, false);
+  }
+
+  void set_intersection(multiset& other, ThreadPool& workers) {
+    applySetOperation(other, SetOperation::Intersection, false, workers);
+  }
+
+  void set_difference(multiset& other) {
+    applySetOperation(other, SetOperation::Difference, false);
+  }
+
+  void set_difference(multiset& other, ThreadPool& workers) {
+    applySetOperation(other, SetOperation::Difference, false, workers);
+  }
+
+  void set_symmetric_difference(multiset& other) {
+    applySetOperation(other, SetOperation::SymmetricDifference, false);
+  }
+
+  void set_symmetric_difference(multiset& other, ThreadPool& workers) {
+    applySetOperation(other, SetOperation::SymmetricDifference, false, workers);
   }
 
   // Multiset Lookup
 
-  size_type count(const Key& key) { return countElement(root, key); }
+  size_type count(const Key& key) {
+    return countLessOrEqual(root, key) - countLess(root, key);
+  }
 
-  size_type countElement(Node* node, const Key& key) {
-    size_type count = 0;
-    if (node == nullptr) {
-      return 0;
-    }
-    if (node->key == key) {
-      count = 1;
-    } else {
-      count = 0;
-    }
-    count += countElement(node->left, key);
-    count += countElement(node->right, key);
-    return count;
+  template <typename K, typename = if_transparent<K>>
+  size_type count(const K& key) {
+    return countLessOrEqual(root, key) - countLess(root, key);
   }
 
   iterator find(const Key& key) {
-    Node* current = root;
-    while (current != nullptr) {
-      if (current->key == key) {
-        return iterator(current);
-      }
-      if (key < current->key) {
-        current = current->left;
-      } else {
-        current = current->right;
-      }
-    }
-    return end();
+    return iterator(nodeOrEnd(findInTree(root, key)));
   }
 
-  bool contains(const Key& key) {
-    Node* current = root;
-    while (current != nullptr) {
-      if (current->key == key) {
-        return true;
-      }
-      if (key < current->key) {
-        current = current->left;
-      } else {
-        current = current->right;
-      }
-    }
-    return false;
+  template <typename K, typename = if_transparent<K>>
+  iterator find(const K& key) {
+    return iterator(nodeOrEnd(findInTree(root, key)));
+  }
+
+  bool contains(const Key& key) { return findInTree(root, key) != nullptr; }
+
+  template <typename K, typename = if_transparent<K>>
+  bool contains(const K& key) {
+    return findInTree(root, key) != nullptr;
   }
 
   std::pair<iterator, iterator> equal_range(const Key& key) {
-    iterator first_iter = lower_bound(key);
-    iterator second_iter = upper_bound(key);
-    return std::make_pair(first_iter, second_iter);
+    return std::make_pair(lower_bound(key), upper_bound(key));
   }
 
+  template <typename K, typename = if_transparent<K>>
+  std::pair<iterator, iterator> equal_range(const K& key) {
+    return std::make_pair(lower_bound(key), upper_bound(key));
+  }
+
+  // First element not less than key
   iterator lower_bound(const Key& key) {
-    // возвращает итератор на первый элемент, который больше или равен (не
-    // меньше)заданному ключу
-    Node* current = root;
-    Node* result = nullptr;
-
-    while (current != nullptr) {
-      if (current->key >= key) {
-        result = current;
-        current = current->left;
-      } else {
-        current = current->right;
-      }
-    }
+    return iterator(nodeOrEnd(lowerBoundNode(root, key)));
+  }
 
-    if (result != nullptr) {
-      return iterator(result);
-    } else {
-      return end();
-    }
+  template <typename K, typename = if_transparent<K>>
+  iterator lower_bound(const K& key) {
+    return iterator(nodeOrEnd(lowerBoundNode(root, key)));
   }
 
+  // First element greater than key
   iterator upper_bound(const Key& key) {
-    Node* current = root;
-    Node* result = nullptr;
-
-    while (current != nullptr) {
-      if (current->key > key) {
-        result = current;
-        current = current->left;
-      } else {
-        current = current->right;
-      }
-    }
+    return iterator(nodeOrEnd(upperBoundNode(root, key)));
+  }
 
-    if (result != nullptr) {
-      return iterator(result);
-    } else {
-      return end();
-    }
+  template <typename K, typename = if_transparent<K>>
+  iterator upper_bound(const K& key) {
+    return iterator(nodeOrEnd(upperBoundNode(root, key)));
+  }
+
+  // Calls visit(value) for the values in [lo, hi) in order. A visitor
+  // returning bool stops the walk by returning false. Costs one descent
+  // plus the elements visited.
+  template <typename Visit>
+  void for_each_in_range(const Key& lo, const Key& hi, Visit visit) {
+    this->visitRange(lo, hi, [&visit](Node* node) {
+      return Base::callVisitor(visit, node->key());
+    });
+  }
+
+  template <typename K, typename Visit, typename = if_transparent<K>>
+  void for_each_in_range(const K& lo, const K& hi, Visit visit) {
+    this->visitRange(lo, hi, [&visit](Node* node) {
+      return Base::callVisitor(visit, node->key());
+    });
+  }
+
+  key_compare key_comp() const { return this->comp; }
+
+  // Multiset Order statistics
+
+  iterator nth(size_type k) {
+    return iterator(nodeOrEnd(nthNode(root, k)));
   }
 
+  size_type rank(const Key& key) { return countLess(root, key); }
+
+  template <typename K, typename = if_transparent<K>>
+  size_type rank(const K& key) {
+    return countLess(root, key);
+  }
+
+  size_type count_range(const Key& lo, const Key& hi) {
+    return countRange(root, lo, hi);
+  }
+
+  template <typename K, typename = if_transparent<K>>
+  size_type count_range(const K& lo, const K& hi) {
+    return countRange(root, lo, hi);
+  }
+
+  // Multiset Diagnostics
+
+  // Node count, height against the AVL bound, leaf depths and pool bytes,
+  // found by a walk over every node. Rotations and comparisons since the
+  // last reset_stats() are counted only when Stats is TreeCountStats.
+  stats_type stats() { return this->treeStats(); }
+
+  void reset_stats() { this->resetStats(); }
+
   void print() { printTree(root); }
+
+ private:
+  template <typename K>
+  size_type eraseAll(const K& key) {
+    size_type removed = count(key);
+    erase(lower_bound(key), upper_bound(key));
+    return removed;
+  }
 };
 }  // namespace s21
 
@@ -0,0 +1,244 @@
+#ifndef __S21_PERSISTENT_MAP_H__
+#define __S21_PERSISTENT_MAP_H__
+
+#include <initializer_list>
+#include <iterator>
+#include <limits>
+#include <stdexcept>
+#include <vector>
+
+#include "../Tree/persistent_tree.h"
+
+namespace s21 {
+
+// Immutable ordered map. Copying is O(1) and yields a snapshot, insert and
+// erase leave the map alone and return a new version that shares every
+// untouched node with it, so old versions stay cheap to hold and to read.
+template <typename Key, typename T, typename Compare = std::less<Key>>
+class persistent_map : public PersistentTree<Key, T, Compare> {
+  using Base = PersistentTree<Key, T, Compare>;
+  using typename Base::Node;
+  using typename Base::Path;
+
+ public:
+  // Persistent_map Member type
+  using key_type = Key;
+  using mapped_type = T;
+  using value_type = std::pair<const key_type, mapped_type>;
+  using reference = value_type &;
+  using const_reference = const value_type &;
+  using size_type = size_t;
+  using key_compare = Compare;
+
+  // Overloads templated on K take any key type the comparator can order
+  // against Key, they exist only for transparent comparators
+  template <typename K>
+  using if_transparent =
+      std::enable_if_t<is_transparent<Compare>::value && sizeof(K) != 0>;
+
+  // Persistent_map Member functions
+  persistent_map() : Base() {}
+
+  persistent_map(std::initializer_list<value_type> const &items)
+      : persistent_map(items.begin(), items.end()) {}
+
+  // Builds a balanced tree in one pass after sorting, the first of equal
+  // keys wins
+  template <typename InputIt, typename = typename std::iterator_traits<
+                                  InputIt>::iterator_category>
+  persistent_map(InputIt first, InputIt last) {
+    std::vector<std::pair<Key, T>> items;
+    for (; first != last; ++first) {
+      items.emplace_back((*first).first, (*first).second);
+    }
+    this->assignItems(
+        items,
+        [](const std::pair<Key, T> &item) -> const Key & {
+          return item.first;
+        },
+        [](const std::pair<Key, T> &item) -> const T & {
+          return item.second;
+        });
+  }
+
+  persistent_map(const persistent_map &other) : Base(other) {}
+
+  persistent_map(persistent_map &&other) noexcept : Base(std::move(other)) {}
+
+  ~persistent_map() {}
+
+  persistent_map &operator=(const persistent_map &other) = default;
+
+  persistent_map &operator=(persistent_map &&other) noexcept = default;
+
+  // Persistent_map Element access
+
+  const T &at(const Key &key) const { return valueAt(this->findNode(key)); }
+
+  template <typename K, typename = if_transparent<K>>
+  const T &at(const K &key) const {
+    return valueAt(this->findNode(key));
+  }
+
+  // Persistent_map Iterators
+
+  // Keeps the path from the root, so it stays valid for as long as the
+  // version it came from, whatever other versions do. Nodes never change,
+  // elements are read in place.
+  class PersistentMapIterator {
+   public:
+    using iterator_category = std::bidirectional_iterator_tag;
+    using value_type = std::pair<const Key, T>;
+    using difference_type = std::ptrdiff_t;
+    using pointer = const value_type *;
+    using reference = const value_type &;
+
+    const Node *top;
+    Path path;
+
+    PersistentMapIterator(const Node *root, const Path &nodes)
+        : top(root), path(nodes) {}
+
+    reference operator*() const { return path.back()->data; }
+
+    pointer operator->() const { return &path.back()->data; }
+
+    PersistentMapIterator &operator++() {
+      Base::stepForward(path);
+      return *this;
+    }
+
+    PersistentMapIterator operator++(int) {
+      PersistentMapIterator tmp = *this;
+      ++(*this);
+      return tmp;
+    }
+
+    PersistentMapIterator &operator--() {
+      Base::stepBackward(top, path);
+      return *this;
+    }
+
+    PersistentMapIterator operator--(int) {
+      PersistentMapIterator tmp = *this;
+      --(*this);
+      return tmp;
+    }
+
+    bool operator==(const PersistentMapIterator &other) const {
+      return path.empty() ? other.path.empty()
+                          : !other.path.empty() &&
+                                path.back() == other.path.back();
+    }
+
+    bool operator!=(const PersistentMapIterator &other) const {
+      return !(*this == other);
+    }
+  };
+
+  using iterator = PersistentMapIterator;
+  using const_iterator = PersistentMapIterator;
+  using reverse_iterator = std::reverse_iterator<iterator>;
+
+  iterator begin() const { return iterator(this->root, this->beginPath()); }
+
+  iterator end() const { return iterator(this->root, Path()); }
+
+  reverse_iterator rbegin() const { return reverse_iterator(end()); }
+
+  reverse_iterator rend() const { return reverse_iterator(begin()); }
+
+  // Persistent_map Capacity
+
+  bool empty() const { return this->root == nullptr; }
+
+  size_type size() const { return Base::sizeOf(this->root); }
+
+  size_type max_size() const {
+    return std::numeric_limits<size_type>::max() / sizeof(Node);
+  }
+
+  // Persistent_map Versions
+
+  // O(1), shares every node with this map
+  persistent_map snapshot() const { return *this; }
+
+  // This map with key added, or this map itself when key is present
+  persistent_map insert(const value_type &value) const {
+    return insert(value.first, value.second);
+  }
+
+  persistent_map insert(const Key &key, const T &obj) const {
+    if (this->findNode(key)) {
+      return *this;
+    }
+    return persistent_map(this->insertNode(this->root, key, obj), this->comp);
+  }
+
+  persistent_map insert_or_assign(const Key &key, const T &obj) const {
+    return persistent_map(this->insertNode(this->root, key, obj), this->comp);
+  }
+
+  // This map without key, or this map itself when key is absent
+  persistent_map erase(const Key &key) const { return eraseKey(key); }
+
+  template <typename K, typename = if_transparent<K>>
+  persistent_map erase(const K &key) const {
+    return eraseKey(key);
+  }
+
+  void swap(persistent_map &other) {
+    std::swap(this->root, other.root);
+    std::swap(this->comp, other.comp);
+  }
+
+  // Persistent_map Lookup
+
+  iterator find(const Key &key) const {
+    return iterator(this->root, this->findPath(key));
+  }
+
+  template <typename K, typename = if_transparent<K>>
+  iterator find(const K &key) const {
+    return iterator(this->root, this->findPath(key));
+  }
+
+  bool contains(const Key &key) const {
+    return this->findNode(key) != nullptr;
+  }
+
+  template <typename K, typename = if_transparent<K>>
+  bool contains(const K &key) const {
+    return this->findNode(key) != nullptr;
+  }
+
+  size_type count(const Key &key) const { return contains(key) ? 1 : 0; }
+
+  template <typename K, typename = if_transparent<K>>
+  size_type count(const K &key) const {
+    return contains(key) ? 1 : 0;
+  }
+
+  key_compare key_comp() const { return this->comp; }
+
+ private:
+  persistent_map(const Node *root, const Compare &comp) : Base(root, comp) {}
+
+  static const T &valueAt(const Node *node) {
+    if (node == nullptr) {
+      throw std::out_of_range("Not found key");
+    }
+    return node->value();
+  }
+
+  template <typename K>
+  persistent_map eraseKey(const K &key) const {
+    if (!this->findNode(key)) {
+      return *this;
+    }
+    return persistent_map(this->eraseNode(this->root, key), this->comp);
+  }
+};
+}  // namespace s21
+
+#endif
@@ -0,0 +1,206 @@
+#ifndef __S21_PERSISTENT_SET_H__
+#define __S21_PERSISTENT_SET_H__
+
+#include <initializer_list>
+#include <iterator>
+#include <limits>
+#include <vector>
+
+#include "../Tree/persistent_tree.h"
+
+namespace s21 {
+
+// Immutable ordered set, the key-only counterpart of s21::persistent_map.
+// Copying is O(1), insert and erase return a new version.
+template <typename Key, typename Compare = std::less<Key>>
+class persistent_set : public PersistentTree<Key, PersistentNoValue, Compare> {
+  using Base = PersistentTree<Key, PersistentNoValue, Compare>;
+  using typename Base::Node;
+  using typename Base::Path;
+
+ public:
+  // Persistent_set Member type
+  using key_type = Key;
+  using value_type = Key;
+  using reference = value_type &;
+  using const_reference = const value_type &;
+  using size_type = size_t;
+  using key_compare = Compare;
+
+  // Overloads templated on K take any key type the comparator can order
+  // against Key, they exist only for transparent comparators
+  template <typename K>
+  using if_transparent =
+      std::enable_if_t<is_transparent<Compare>::value && sizeof(K) != 0>;
+
+  // Persistent_set Member functions
+  persistent_set() : Base() {}
+
+  persistent_set(std::initializer_list<value_type> const &items)
+      : persistent_set(items.begin(), items.end()) {}
+
+  // Builds a balanced tree in one pass after sorting
+  template <typename InputIt, typename = typename std::iterator_traits<
+                                  InputIt>::iterator_category>
+  persistent_set(InputIt first, InputIt last) {
+    std::vector<Key> items(first, last);
+    this->assignItems(
+        items, [](const Key &key) -> const Key & { return key; },
+        [](const Key &) { return PersistentNoValue(); });
+  }
+
+  persistent_set(const persistent_set &other) : Base(other) {}
+
+  persistent_set(persistent_set &&other) noexcept : Base(std::move(other)) {}
+
+  ~persistent_set() {}
+
+  persistent_set &operator=(const persistent_set &other) = default;
+
+  persistent_set &operator=(persistent_set &&other) noexcept = default;
+
+  // Persistent_set Iterators
+
+  // Keeps the path from the root, so it stays valid for as long as the
+  // version it came from, whatever other versions do
+  class PersistentSetIterator {
+   public:
+    using iterator_category = std::bidirectional_iterator_tag;
+    using value_type = Key;
+    using difference_type = std::ptrdiff_t;
+    using pointer = const value_type *;
+    using reference = const value_type &;
+
+    const Node *top;
+    Path path;
+
+    PersistentSetIterator(const Node *root, const Path &nodes)
+        : top(root), path(nodes) {}
+
+    const Key &operator*() const { return path.back()->key(); }
+
+    PersistentSetIterator &operator++() {
+      Base::stepForward(path);
+      return *this;
+    }
+
+    PersistentSetIterator operator++(int) {
+      PersistentSetIterator tmp = *this;
+      ++(*this);
+      return tmp;
+    }
+
+    PersistentSetIterator &operator--() {
+      Base::stepBackward(top, path);
+      return *this;
+    }
+
+    PersistentSetIterator operator--(int) {
+      PersistentSetIterator tmp = *this;
+      --(*this);
+      return tmp;
+    }
+
+    bool operator==(const PersistentSetIterator &other) const {
+      return path.empty() ? other.path.empty()
+                          : !other.path.empty() &&
+                                path.back() == other.path.back();
+    }
+
+    bool operator!=(const PersistentSetIterator &other) const {
+      return !(*this == other);
+    }
+  };
+
+  using iterator = PersistentSetIterator;
+  using const_iterator = PersistentSetIterator;
+  using reverse_iterator = std::reverse_iterator<iterator>;
+
+  iterator begin() const { return iterator(this->root, this->beginPath()); }
+
+  iterator end() const { return iterator(this->root, Path()); }
+
+  reverse_iterator rbegin() const { return reverse_iterator(end()); }
+
+  reverse_iterator rend() const { return reverse_iterator(begin()); }
+
+  // Persistent_set Capacity
+
+  bool empty() const { return this->root == nullptr; }
+
+  size_type size() const { return Base::sizeOf(this->root); }
+
+  size_type max_size() const {
+    return std::numeric_limits<size_type>::max() / sizeof(Node);
+  }
+
+  // Persistent_set Versions
+
+  // O(1), shares every node with this set
+  persistent_set snapshot() const { return *this; }
+
+  // This set with value added, or this set itself when it is present
+  persistent_set insert(const value_type &value) const {
+    if (this->findNode(value)) {
+      return *this;
+    }
+    return persistent_set(
+        this->insertNode(this->root, value, PersistentNoValue()), this->comp);
+  }
+
+  // This set without key, or this set itself when key is absent
+  persistent_set erase(const Key &key) const { return eraseKey(key); }
+
+  template <typename K, typename = if_transparent<K>>
+  persistent_set erase(const K &key) const {
+    return eraseKey(key);
+  }
+
+  void swap(persistent_set &other) {
+    std::swap(this->root, other.root);
+    std::swap(this->comp, other.comp);
+  }
+
+  // Persistent_set Lookup
+
+  iterator find(const Key &key) const {
+    return iterator(this->root, this->findPath(key));
+  }
+
+  template <typename K, typename = if_transparent<K>>
+  iterator find(const K &key) const {
+    return iterator(this->root, this->findPath(key));
+  }
+
+  bool contains(const Key &key) const {
+    return this->findNode(key) != nullptr;
+  }
+
+  template <typename K, typename = if_transparent<K>>
+  bool contains(const K &key) const {
+    return this->findNode(key) != nullptr;
+  }
+
+  size_type count(const Key &key) const { return contains(key) ? 1 : 0; }
+
+  template <typename K, typename = if_transparent<K>>
+  size_type count(const K &key) const {
+    return contains(key) ? 1 : 0;
+  }
+
+  key_compare key_comp() const { return this->comp; }
+
+ private:
+  persistent_set(const Node *root, const Compare &comp) : Base(root, comp) {}
+
+  template <typename K>
+  persistent_set eraseKey(const K &key) const {
+    if (!this->findNode(key)) {
+      return *this;
+    }
+    return persistent_set(this->eraseNode(this->root, key), this->comp);
+  }
+};
+}  // namespace s21
+
+#endif
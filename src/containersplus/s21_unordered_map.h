@@ -0,0 +1,224 @@
+#ifndef __S21_UNORDERED_MAP_H__
+#define __S21_UNORDERED_MAP_H__
+
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <limits>
+#include <stdexcept>
+#include <tuple>
+
+#include "../Tree/swiss_table.h"
+
+namespace s21 {
+
+// Unordered map on an open addressing Swiss table. Mirrors the s21::map
+// API without the ordering. Elements live in one flat slot array, so
+// iterators and references are invalidated when the table grows.
+template <typename Key, typename T, typename Hash = std::hash<Key>,
+          typename KeyEqual = std::equal_to<Key>>
+class unordered_map : public SwissTable<std::pair<const Key, T>, Key,
+                                        SwissPairKey, Hash, KeyEqual> {
+  using Base =
+      SwissTable<std::pair<const Key, T>, Key, SwissPairKey, Hash, KeyEqual>;
+
+ public:
+  // Unordered_map Member type
+  using key_type = Key;
+  using mapped_type = T;
+  using value_type = std::pair<const key_type, mapped_type>;
+  using reference = value_type &;
+  using const_reference = const value_type &;
+  using size_type = size_t;
+  using hasher = Hash;
+  using key_equal = KeyEqual;
+
+  // Unordered_map Member functions
+  unordered_map() : Base() {}
+
+  unordered_map(std::initializer_list<value_type> const &items)
+      : unordered_map(items.begin(), items.end()) {}
+
+  template <typename InputIt, typename = typename std::iterator_traits<
+                                  InputIt>::iterator_category>
+  unordered_map(InputIt first, InputIt last) {
+    for (; first != last; ++first) {
+      insert(*first);
+    }
+  }
+
+  unordered_map(const unordered_map &other) : Base(other) {}
+
+  unordered_map(unordered_map &&other) noexcept : Base(std::move(other)) {}
+
+  ~unordered_map() {}
+
+  unordered_map &operator=(const unordered_map &other) = default;
+
+  unordered_map &operator=(unordered_map &&other) noexcept = default;
+
+  // Unordered_map Element access
+
+  T &at(const Key &key) {
+    size_type index = this->findIndex(key);
+    if (index == this->capacity) {
+      throw std::out_of_range("Not found key");
+    }
+    return this->slots[index].second;
+  }
+
+  T &operator[](const Key &key) {
+    size_type index =
+        this->emplaceUnique(key, std::piecewise_construct,
+                            std::forward_as_tuple(key), std::tuple<>())
+            .first;
+    return this->slots[index].second;
+  }
+
+  // Unordered_map Iterators
+
+  class UnorderedMapIterator {
+   public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = std::pair<const Key, T>;
+    using difference_type = std::ptrdiff_t;
+    using pointer = value_type *;
+    using reference = value_type &;
+
+    CtrlByte *ctrl;
+    value_type *slot;
+
+    UnorderedMapIterator(CtrlByte *byte, value_type *s) : ctrl(byte), slot(s) {
+      Base::skipFree(ctrl, slot);
+    }
+
+    reference operator*() const { return *slot; }
+
+    pointer operator->() const { return slot; }
+
+    UnorderedMapIterator &operator++() {
+      ++ctrl;
+      ++slot;
+      Base::skipFree(ctrl, slot);
+      return *this;
+    }
+
+    UnorderedMapIterator operator++(int) {
+      UnorderedMapIterator tmp = *this;
+      ++(*this);
+      return tmp;
+    }
+
+    bool operator==(const UnorderedMapIterator &other) const {
+      return ctrl == other.ctrl;
+    }
+
+    bool operator!=(const UnorderedMapIterator &other) const {
+      return ctrl != other.ctrl;
+    }
+  };
+
+  using iterator = UnorderedMapIterator;
+  using const_iterator = UnorderedMapIterator;
+
+  iterator begin() { return iterator(this->ctrl, this->slots); }
+
+  iterator end() { return iteratorAt(this->capacity); }
+
+  // Unordered_map Capacity
+
+  bool empty() const { return this->elements == 0; }
+
+  size_type size() const { return this->elements; }
+
+  size_type max_size() const {
+    return std::numeric_limits<size_type>::max() / (sizeof(value_type) + 1);
+  }
+
+  size_type bucket_count() const { return this->capacity; }
+
+  float load_factor() const {
+    return this->capacity == 0
+               ? 0.0f
+               : static_cast<float>(this->elements) / this->capacity;
+  }
+
+  // Grows the table so that count elements fit without a rehash
+  void reserve(size_type count) { this->reserveFor(count); }
+
+  // Unordered_map Modifiers
+
+  void clear() { this->clearTable(); }
+
+  std::pair<iterator, bool> insert(const value_type &value) {
+    auto result = this->emplaceUnique(value.first, value);
+    return {iteratorAt(result.first), result.second};
+  }
+
+  std::pair<iterator, bool> insert(const Key &key, const T &obj) {
+    auto result = this->emplaceUnique(key, key, obj);
+    return {iteratorAt(result.first), result.second};
+  }
+
+  std::pair<iterator, bool> insert_or_assign(const Key &key, const T &obj) {
+    auto result = this->emplaceUnique(key, key, obj);
+    if (!result.second) {
+      this->slots[result.first].second = obj;
+    }
+    return {iteratorAt(result.first), result.second};
+  }
+
+  // Returns the iterator following pos
+  iterator erase(iterator pos) {
+    this->eraseAt(pos.slot - this->slots);
+    return ++pos;
+  }
+
+  size_type erase(const Key &key) {
+    size_type index = this->findIndex(key);
+    if (index == this->capacity) {
+      return 0;
+    }
+    this->eraseAt(index);
+    return 1;
+  }
+
+  void swap(unordered_map &other) { this->swapTable(other); }
+
+  // Moves the elements whose keys are missing here out of other, the rest
+  // stays in other
+  void merge(unordered_map &other) {
+    if (this == &other) {
+      return;
+    }
+    for (auto iter{other.begin()}; iter != other.end();) {
+      if (this->emplaceUnique(iter->first, std::move(*iter.slot)).second) {
+        iter = other.erase(iter);
+      } else {
+        ++iter;
+      }
+    }
+  }
+
+  // Unordered_map Lookup
+
+  iterator find(const Key &key) { return iteratorAt(this->findIndex(key)); }
+
+  bool contains(const Key &key) const {
+    return this->findIndex(key) != this->capacity;
+  }
+
+  size_type count(const Key &key) const { return contains(key) ? 1 : 0; }
+
+  hasher hash_function() const { return this->hashFunction; }
+
+  key_equal key_eq() const { return this->keyEqual; }
+
+ private:
+  iterator iteratorAt(size_type index) {
+    return iterator(this->ctrl + index, this->slots + index);
+  }
+};
+}  // namespace s21
+
+#endif
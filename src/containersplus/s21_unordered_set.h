@@ -0,0 +1,188 @@
+#ifndef __S21_UNORDERED_SET_H__
+#define __S21_UNORDERED_SET_H__
+
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <limits>
+
+#include "../Tree/swiss_table.h"
+
+namespace s21 {
+
+// Unordered set on an open addressing Swiss table. Mirrors the s21::set
+// API without the ordering. Keys live in one flat slot array, so iterators
+// and references are invalidated when the table grows.
+template <typename Key, typename Hash = std::hash<Key>,
+          typename KeyEqual = std::equal_to<Key>>
+class unordered_set
+    : public SwissTable<Key, Key, SwissSelfKey, Hash, KeyEqual> {
+  using Base = SwissTable<Key, Key, SwissSelfKey, Hash, KeyEqual>;
+
+ public:
+  // Unordered_set Member type
+  using key_type = Key;
+  using value_type = Key;
+  using reference = value_type &;
+  using const_reference = const value_type &;
+  using size_type = size_t;
+  using hasher = Hash;
+  using key_equal = KeyEqual;
+
+  // Unordered_set Member functions
+  unordered_set() : Base() {}
+
+  unordered_set(std::initializer_list<value_type> const &items)
+      : unordered_set(items.begin(), items.end()) {}
+
+  template <typename InputIt, typename = typename std::iterator_traits<
+                                  InputIt>::iterator_category>
+  unordered_set(InputIt first, InputIt last) {
+    for (; first != last; ++first) {
+      insert(*first);
+    }
+  }
+
+  unordered_set(const unordered_set &other) : Base(other) {}
+
+  unordered_set(unordered_set &&other) noexcept : Base(std::move(other)) {}
+
+  ~unordered_set() {}
+
+  unordered_set &operator=(const unordered_set &other) = default;
+
+  unordered_set &operator=(unordered_set &&other) noexcept = default;
+
+  // Unordered_set Iterators
+
+  class UnorderedSetIterator {
+   public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = Key;
+    using difference_type = std::ptrdiff_t;
+    using pointer = const Key *;
+    using reference = const Key &;
+
+    CtrlByte *ctrl;
+    Key *slot;
+
+    UnorderedSetIterator(CtrlByte *byte, Key *s) : ctrl(byte), slot(s) {
+      Base::skipFree(ctrl, slot);
+    }
+
+    reference operator*() const { return *slot; }
+
+    pointer operator->() const { return slot; }
+
+    UnorderedSetIterator &operator++() {
+      ++ctrl;
+      ++slot;
+      Base::skipFree(ctrl, slot);
+      return *this;
+    }
+
+    UnorderedSetIterator operator++(int) {
+      UnorderedSetIterator tmp = *this;
+      ++(*this);
+      return tmp;
+    }
+
+    bool operator==(const UnorderedSetIterator &other) const {
+      return ctrl == other.ctrl;
+    }
+
+    bool operator!=(const UnorderedSetIterator &other) const {
+      return ctrl != other.ctrl;
+    }
+  };
+
+  using iterator = UnorderedSetIterator;
+  using const_iterator = UnorderedSetIterator;
+
+  iterator begin() { return iterator(this->ctrl, this->slots); }
+
+  iterator end() { return iteratorAt(this->capacity); }
+
+  // Unordered_set Capacity
+
+  bool empty() const { return this->elements == 0; }
+
+  size_type size() const { return this->elements; }
+
+  size_type max_size() const {
+    return std::numeric_limits<size_type>::max() / (sizeof(Key) + 1);
+  }
+
+  size_type bucket_count() const { return this->capacity; }
+
+  float load_factor() const {
+    return this->capacity == 0
+               ? 0.0f
+               : static_cast<float>(this->elements) / this->capacity;
+  }
+
+  // Grows the table so that count keys fit without a rehash
+  void reserve(size_type count) { this->reserveFor(count); }
+
+  // Unordered_set Modifiers
+
+  void clear() { this->clearTable(); }
+
+  std::pair<iterator, bool> insert(const value_type &value) {
+    auto result = this->emplaceUnique(value, value);
+    return {iteratorAt(result.first), result.second};
+  }
+
+  // Returns the iterator following pos
+  iterator erase(iterator pos) {
+    this->eraseAt(pos.slot - this->slots);
+    return ++pos;
+  }
+
+  size_type erase(const Key &key) {
+    size_type index = this->findIndex(key);
+    if (index == this->capacity) {
+      return 0;
+    }
+    this->eraseAt(index);
+    return 1;
+  }
+
+  void swap(unordered_set &other) { this->swapTable(other); }
+
+  // Moves the keys missing here out of other, the rest stays in other
+  void merge(unordered_set &other) {
+    if (this == &other) {
+      return;
+    }
+    for (auto iter{other.begin()}; iter != other.end();) {
+      if (this->emplaceUnique(*iter, std::move(*iter.slot)).second) {
+        iter = other.erase(iter);
+      } else {
+        ++iter;
+      }
+    }
+  }
+
+  // Unordered_set Lookup
+
+  iterator find(const Key &key) { return iteratorAt(this->findIndex(key)); }
+
+  bool contains(const Key &key) const {
+    return this->findIndex(key) != this->capacity;
+  }
+
+  size_type count(const Key &key) const { return contains(key) ? 1 : 0; }
+
+  hasher hash_function() const { return this->hashFunction; }
+
+  key_equal key_eq() const { return this->keyEqual; }
+
+ private:
+  iterator iteratorAt(size_type index) {
+    return iterator(this->ctrl + index, this->slots + index);
+  }
+};
+}  // namespace s21
+
+#endif
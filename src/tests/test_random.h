@@ -0,0 +1,28 @@
+#ifndef __TEST_RANDOM_H__
+#define __TEST_RANDOM_H__
+
+namespace s21 {
+
+// Generator of the model tests, which replay the same random operations on
+// a container and on its std counterpart. A 32-bit linear congruential
+// generator gives the same sequence on every platform, so a failing step
+// can be reproduced from the seed. Its low bits cycle quickly, keys and
+// values are taken from the higher ones.
+class TestRandom {
+ public:
+  explicit TestRandom(unsigned seed) : state_(seed) {}
+
+  unsigned next() {
+    state_ = state_ * 1103515245 + 12345;
+    return state_;
+  }
+
+  // Next value in [0, bound)
+  unsigned below(unsigned bound) { return (next() >> 8) % bound; }
+
+ private:
+  unsigned state_;
+};
+}  // namespace s21
+
+#endif
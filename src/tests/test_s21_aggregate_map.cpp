@@ -0,0 +1,240 @@
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "../containersplus/s21_aggregate_map.h"
+#include "test_random.h"
+
+using namespace s21;
+
+TEST(S21AggregateMapTest, AGGREGATE_1) {
+  aggregate_map<int64_t, double, SumAggregate<double>> metrics{
+      {10, 1.5}, {20, 2.5}, {30, 4.0}, {40, 8.0}};
+  ASSERT_DOUBLE_EQ(metrics.aggregate(), 16.0);
+  ASSERT_DOUBLE_EQ(metrics.aggregate(20, 40), 6.5);
+  ASSERT_DOUBLE_EQ(metrics.aggregate(15, 41), 14.5);
+  ASSERT_DOUBLE_EQ(metrics.aggregate(41, 50), 0.0);
+  ASSERT_DOUBLE_EQ(metrics.aggregate(30, 30), 0.0);
+
+  metrics.insert_or_assign(20, 10.0);
+  ASSERT_DOUBLE_EQ(metrics.aggregate(0, 25), 11.5);
+  metrics.erase(10);
+  ASSERT_DOUBLE_EQ(metrics.aggregate(0, 25), 10.0);
+  ASSERT_EQ(metrics.at(20), 10.0);
+  ASSERT_THROW(metrics.at(10), std::out_of_range);
+}
+
+TEST(S21AggregateMapTest, AGGREGATE_2) {
+  using SumMax = PairAggregate<SumAggregate<long>, MaxAggregate<long>>;
+  aggregate_map<int, long, SumMax> window;
+  aggregate_map<int, long, CountAggregate> counts;
+  std::map<int, long> expected;
+  TestRandom random(7);
+  for (int step = 0; step < 3000; ++step) {
+    unsigned state = random.next();
+    int key = static_cast<int>((state >> 8) % 500);
+    long value = static_cast<long>((state >> 4) % 1000) - 500;
+    if (step % 5 == 4) {
+      window.erase(key);
+      counts.erase(key);
+      expected.erase(key);
+    } else {
+      window.insert_or_assign(key, value);
+      counts.insert(key, value);
+      expected[key] = value;
+    }
+    int lo = static_cast<int>((state >> 12) % 500);
+    int hi = lo + static_cast<int>((state >> 20) % 100);
+    long sum = 0, max = MaxAggregate<long>::identity();
+    size_t count = 0;
+    for (auto it = expected.lower_bound(lo);
+         it != expected.end() && it->first < hi; ++it) {
+      ++count;
+      sum += it->second;
+      max = std::max(max, it->second);
+    }
+    auto result = window.aggregate(lo, hi);
+    ASSERT_EQ(result.first, sum);
+    ASSERT_EQ(result.second, max);
+    ASSERT_EQ(counts.aggregate(lo, hi), count);
+  }
+
+  aggregate_map<int, long, SumMax> copy(window);
+  copy.erase(copy.lower_bound(100), copy.lower_bound(300));
+  long rest = 0;
+  for (const auto &[key, value] : expected) {
+    rest += key < 100 || key >= 300 ? value : 0;
+  }
+  ASSERT_EQ(copy.aggregate().first, rest);
+  ASSERT_EQ(window.size(), expected.size());
+}
+
+TEST(S21AggregateMapTest, MIN_1) {
+  aggregate_map<std::string, int, MinAggregate<int>, std::less<>> prices{
+      {"apple", 3}, {"banana", 1}, {"cherry", 7}};
+  ASSERT_EQ(prices.aggregate("b", "d"), 1);
+  ASSERT_EQ(prices.aggregate(std::string("c"), std::string("d")), 7);
+  ASSERT_EQ(prices.aggregate("x", "z"), MinAggregate<int>::identity());
+  auto it = prices.find("banana");
+  ASSERT_EQ(it->second, 1);
+  ASSERT_EQ((++it)->first, "cherry");
+}
+
+TEST(S21AggregateMapTest, EMPTY_1) {
+  aggregate_map<int, long, SumAggregate<long>> sums;
+  aggregate_map<int, int, MinAggregate<int>> mins;
+  ASSERT_TRUE(sums.empty());
+  ASSERT_EQ(sums.size(), 0U);
+  ASSERT_EQ(sums.aggregate(), 0);
+  ASSERT_EQ(sums.aggregate(-100, 100), 0);
+  ASSERT_EQ(mins.aggregate(), MinAggregate<int>::identity());
+  ASSERT_TRUE(sums.begin() == sums.end());
+  ASSERT_TRUE(sums.find(1) == sums.end());
+  ASSERT_TRUE(sums.lower_bound(1) == sums.end());
+  ASSERT_TRUE(sums.upper_bound(1) == sums.end());
+  ASSERT_TRUE(sums.erase(sums.end()) == sums.end());
+  ASSERT_EQ(sums.erase(1), 0U);
+  ASSERT_FALSE(sums.contains(1));
+  ASSERT_EQ(sums.count(1), 0U);
+  ASSERT_THROW(sums.at(1), std::out_of_range);
+  sums.clear();
+  ASSERT_TRUE(sums.empty());
+}
+
+TEST(S21AggregateMapTest, ERASE_LAST_1) {
+  aggregate_map<int, long, SumAggregate<long>> sums{{5, 50}};
+  ASSERT_TRUE(sums.erase(sums.begin()) == sums.end());
+  ASSERT_TRUE(sums.empty());
+  ASSERT_EQ(sums.aggregate(), 0);
+
+  for (int key = 1; key <= 5; ++key) {
+    sums.insert(key, key * 10);
+  }
+  auto last = sums.find(5);
+  ASSERT_TRUE(sums.erase(last) == sums.end());
+  ASSERT_EQ(sums.aggregate(), 100);
+  ASSERT_EQ(sums.aggregate(4, 100), 40);
+  ASSERT_EQ((*sums.rbegin()).first, 4);
+}
+
+TEST(S21AggregateMapTest, INSERT_EXISTING_1) {
+  aggregate_map<int, int, MaxAggregate<int>> peaks{{1, 4}, {2, 9}, {3, 1}};
+  auto result = peaks.insert(2, 100);
+  ASSERT_FALSE(result.second);
+  ASSERT_EQ(result.first->second, 9);
+  ASSERT_EQ(peaks.aggregate(), 9);
+
+  result = peaks.insert_or_assign(2, 3);
+  ASSERT_FALSE(result.second);
+  ASSERT_EQ(peaks.at(2), 3);
+  ASSERT_EQ(peaks.aggregate(), 4);
+  ASSERT_EQ(peaks.aggregate(2, 4), 3);
+  ASSERT_TRUE(peaks.insert_or_assign(4, 7).second);
+  ASSERT_EQ(peaks.aggregate(), 7);
+  ASSERT_EQ(peaks.size(), 4U);
+}
+
+TEST(S21AggregateMapTest, BOUNDS_1) {
+  aggregate_map<int, int, SumAggregate<int>> sums;
+  for (int key = 0; key < 100; key += 10) {
+    sums.insert(key, 1);
+  }
+  ASSERT_EQ(sums.aggregate(10, 30), 2);
+  ASSERT_EQ(sums.aggregate(10, 31), 3);
+  ASSERT_EQ(sums.aggregate(9, 30), 2);
+  ASSERT_EQ(sums.aggregate(50, 20), 0);
+  ASSERT_EQ(sums.aggregate(-50, 0), 0);
+  ASSERT_EQ(sums.aggregate(90, 1000), 1);
+  ASSERT_EQ(sums.lower_bound(90)->first, 90);
+  ASSERT_TRUE(sums.upper_bound(90) == sums.end());
+  ASSERT_EQ(sums.lower_bound(-5), sums.begin());
+  ASSERT_EQ(sums.upper_bound(35)->first, 40);
+}
+
+TEST(S21AggregateMapTest, ERASE_RANGE_1) {
+  aggregate_map<int, int, CountAggregate> counts;
+  for (int key = 0; key < 200; ++key) {
+    counts.insert(key, key);
+  }
+  auto next = counts.erase(counts.begin(), counts.begin());
+  ASSERT_TRUE(next == counts.begin());
+  ASSERT_EQ(counts.aggregate(), 200U);
+
+  next = counts.erase(counts.lower_bound(150), counts.end());
+  ASSERT_TRUE(next == counts.end());
+  ASSERT_EQ(counts.aggregate(), 150U);
+  ASSERT_EQ(counts.aggregate(100, 300), 50U);
+
+  counts.erase(counts.begin(), counts.end());
+  ASSERT_TRUE(counts.empty());
+  ASSERT_EQ(counts.aggregate(), 0U);
+}
+
+TEST(S21AggregateMapTest, CUSTOM_COMPARE_1) {
+  aggregate_map<int, int, SumAggregate<int>, std::greater<int>> sums;
+  for (int key = 1; key <= 10; ++key) {
+    sums.insert(key, key);
+  }
+  ASSERT_EQ(sums.begin()->first, 10);
+  ASSERT_EQ(sums.aggregate(8, 4), 8 + 7 + 6 + 5);
+  ASSERT_EQ(sums.aggregate(4, 8), 0);
+  ASSERT_EQ(sums.lower_bound(11)->first, 10);
+  ASSERT_TRUE(sums.upper_bound(1) == sums.end());
+}
+
+TEST(S21AggregateMapTest, TRANSPARENT_LOOKUP_1) {
+  aggregate_map<std::string, int, SumAggregate<int>, std::less<>> stock{
+      {"apple", 3}, {"banana", 5}, {"cherry", 7}};
+  std::string_view banana = "banana";
+  ASSERT_EQ(stock.at(banana), 5);
+  ASSERT_TRUE(stock.contains("cherry"));
+  ASSERT_EQ(stock.find(banana)->second, 5);
+  ASSERT_TRUE(stock.find("grape") == stock.end());
+  ASSERT_EQ(stock.aggregate(std::string_view("b"), std::string_view("z")),
+            12);
+  ASSERT_EQ(stock.erase(banana), 1U);
+  ASSERT_EQ(stock.erase("banana"), 0U);
+  ASSERT_EQ(stock.aggregate(), 10);
+}
+
+TEST(S21AggregateMapTest, COPY_MOVE_SWAP_1) {
+  aggregate_map<int, long, SumAggregate<long>> first{{1, 1}, {2, 2}};
+  aggregate_map<int, long, SumAggregate<long>> copy(first);
+  copy.insert_or_assign(1, 10);
+  ASSERT_EQ(first.aggregate(), 3);
+  ASSERT_EQ(copy.aggregate(), 12);
+
+  aggregate_map<int, long, SumAggregate<long>> moved(std::move(copy));
+  ASSERT_EQ(moved.aggregate(), 12);
+  ASSERT_TRUE(copy.empty());
+  ASSERT_EQ(copy.aggregate(), 0);
+
+  first.swap(moved);
+  ASSERT_EQ(first.aggregate(), 12);
+  ASSERT_EQ(moved.aggregate(), 3);
+  moved = std::move(first);
+  ASSERT_EQ(moved.aggregate(), 12);
+  ASSERT_EQ(moved.size(), 2U);
+}
+
+TEST(S21AggregateMapTest, ITERATOR_1) {
+  aggregate_map<int, int, SumAggregate<int>> sums{{3, 30}, {1, 10}, {2, 20}};
+  auto it = sums.end();
+  --it;
+  ASSERT_EQ(it->first, 3);
+  it--;
+  ASSERT_EQ((*it).second, 20);
+  std::vector<int> keys;
+  for (auto rit = sums.rbegin(); rit != sums.rend(); ++rit) {
+    keys.push_back(rit->first);
+  }
+  ASSERT_EQ(keys, (std::vector<int>{3, 2, 1}));
+  ASSERT_EQ(sums.erase(sums.find(2))->first, 3);
+  ASSERT_EQ(sums.aggregate(), 40);
+}
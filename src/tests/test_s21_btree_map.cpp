@@ -0,0 +1,205 @@
+#include <gtest/gtest.h>
+
+#include <map>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+
+#include "../containersplus/s21_btree_map.h"
+
+using namespace s21;
+
+TEST(S21BtreeMapTest, INSERT_1) {
+  btree_map<int, std::string> nums;
+  ASSERT_TRUE(nums.insert({2, "two"}).second);
+  ASSERT_TRUE(nums.insert(1, "one").second);
+  ASSERT_FALSE(nums.insert(2, "second two").second);
+  ASSERT_EQ(nums.size(), 2U);
+  ASSERT_EQ(nums.at(2), "two");
+  ASSERT_THROW(nums.at(3), std::out_of_range);
+}
+
+TEST(S21BtreeMapTest, OPERATOR_BRACKETS_1) {
+  btree_map<int, int> nums;
+  for (int i = 0; i < 1000; ++i) {
+    nums[i % 100] += i;
+  }
+  ASSERT_EQ(nums.size(), 100U);
+  ASSERT_EQ(nums[7], 7 * 10 + 100 * 45);
+}
+
+TEST(S21BtreeMapTest, INSERT_OR_ASSIGN_1) {
+  btree_map<int, int> nums{{1, 10}, {2, 20}};
+  ASSERT_FALSE(nums.insert_or_assign(2, 25).second);
+  ASSERT_TRUE(nums.insert_or_assign(3, 30).second);
+  ASSERT_EQ(nums.at(2), 25);
+  ASSERT_EQ(nums.at(3), 30);
+}
+
+TEST(S21BtreeMapTest, ITERATOR_1) {
+  btree_map<int, int> nums;
+  std::map<int, int> expected;
+  for (int i = 0; i < 5000; ++i) {
+    int key = (i * 7919) % 5000;
+    nums.insert(key, i);
+    expected.insert({key, i});
+  }
+  auto it = nums.begin();
+  for (const auto &item : expected) {
+    ASSERT_EQ((*it).first, item.first);
+    ASSERT_EQ((*it).second, item.second);
+    ++it;
+  }
+  ASSERT_TRUE(it == nums.end());
+  --it;
+  ASSERT_EQ((*it).first, 4999);
+  ASSERT_EQ((*nums.rbegin()).first, 4999);
+}
+
+TEST(S21BtreeMapTest, ERASE_1) {
+  btree_map<int, int> nums;
+  for (int i = 0; i < 3000; ++i) {
+    nums[i] = i * 2;
+  }
+  for (int i = 0; i < 3000; i += 2) {
+    ASSERT_EQ(nums.erase(i), 1U);
+  }
+  ASSERT_EQ(nums.erase(0), 0U);
+  nums.erase(nums.find(1));
+  ASSERT_EQ(nums.size(), 1499U);
+  ASSERT_FALSE(nums.contains(1));
+  ASSERT_EQ(nums.at(2999), 5998);
+  int expected = 3;
+  for (auto it = nums.begin(); it != nums.end(); ++it, expected += 2) {
+    ASSERT_EQ((*it).first, expected);
+  }
+}
+
+TEST(S21BtreeMapTest, ITERATOR_WRITE_1) {
+  btree_map<int, std::string> words{{1, "one"}, {2, "two"}, {3, "three"}};
+  auto it = words.find(2);
+  ASSERT_EQ(it->first, 2);
+  it->second = "zwei";
+  (*words.begin()).second += "!";
+  for (auto [key, value] : words) {
+    value += "?";
+    ASSERT_NE(key, 0);
+  }
+  ASSERT_EQ(words.at(1), "one!?");
+  ASSERT_EQ(words.at(2), "zwei?");
+  ASSERT_EQ(words.rbegin()->second, "three?");
+  std::pair<const int, std::string> copy = *it;
+  ASSERT_EQ(copy.second, "zwei?");
+}
+
+TEST(S21BtreeMapTest, CONST_ITERATOR_1) {
+  using Map = btree_map<int, std::string>;
+  static_assert(
+      std::is_same_v<decltype(std::declval<const Map &>().begin()->second),
+                     const std::string &>);
+  static_assert(!std::is_assignable_v<
+                decltype((std::declval<const Map &>().find(1)->second)),
+                std::string>);
+  static_assert(!std::is_convertible_v<Map::const_iterator, Map::iterator>);
+
+  Map words{{1, "one"}, {2, "two"}, {3, "three"}};
+  const Map &view = words;
+  Map::const_iterator it = view.find(2);
+  ASSERT_EQ(it->second, "two");
+  ASSERT_TRUE(it == words.find(2));
+  ASSERT_TRUE(words.begin() != it);
+  std::pair<const int, std::string> copy = *it;
+  ASSERT_EQ(copy.second, "two");
+  ASSERT_EQ(view.lower_bound(2), it);
+  ASSERT_EQ(view.upper_bound(2)->first, 3);
+  ASSERT_EQ((*view.rbegin()).first, 3);
+  ASSERT_EQ(std::distance(view.cbegin(), view.cend()), 3);
+
+  auto next = words.erase(it);
+  ASSERT_EQ(next->first, 3);
+  next->second = "drei";
+  ASSERT_EQ(words.at(3), "drei");
+  ASSERT_EQ(view.find(2), view.end());
+}
+
+TEST(S21BtreeMapTest, ERASE_ITERATOR_1) {
+  btree_map<int, int> nums;
+  for (int i = 0; i < 2000; ++i) {
+    nums[i] = i;
+  }
+  auto it = nums.begin();
+  while (it != nums.end()) {
+    it = it->first % 3 == 0 ? nums.erase(it) : std::next(it);
+  }
+  ASSERT_EQ(nums.size(), 1333U);
+  int expected = 1;
+  for (it = nums.begin(); it != nums.end(); ++it) {
+    ASSERT_EQ(it->first, expected);
+    expected += expected % 3 == 1 ? 1 : 2;
+  }
+  ASSERT_EQ(nums.erase(nums.find(1997))->first, 1999);
+  ASSERT_TRUE(nums.erase(nums.find(1999)) == nums.end());
+  ASSERT_TRUE(nums.erase(nums.end()) == nums.end());
+}
+
+TEST(S21BtreeMapTest, BOUNDS_1) {
+  btree_map<int, int> nums;
+  for (int i = 0; i < 1000; i += 10) {
+    nums[i] = i;
+  }
+  ASSERT_EQ((*nums.lower_bound(15)).first, 20);
+  ASSERT_EQ((*nums.lower_bound(20)).first, 20);
+  ASSERT_EQ((*nums.upper_bound(20)).first, 30);
+  ASSERT_TRUE(nums.lower_bound(991) == nums.end());
+  auto range = nums.equal_range(500);
+  ASSERT_EQ((*range.first).first, 500);
+  ASSERT_EQ((*range.second).first, 510);
+}
+
+TEST(S21BtreeMapTest, COPY_SWAP_1) {
+  btree_map<int, int> first{{1, 1}, {2, 2}};
+  btree_map<int, int> second(first);
+  second[3] = 3;
+  ASSERT_EQ(first.size(), 2U);
+  first.swap(second);
+  ASSERT_EQ(first.size(), 3U);
+  ASSERT_EQ(second.size(), 2U);
+  btree_map<int, int> moved(std::move(first));
+  ASSERT_EQ(moved.size(), 3U);
+  ASSERT_TRUE(first.empty());
+}
+
+TEST(S21BtreeMapTest, TRANSPARENT_LOOKUP_1) {
+  btree_map<std::string, int, std::less<>> words;
+  for (int i = 0; i < 200; ++i) {
+    words[std::to_string(i)] = i;
+  }
+  std::string_view key = "150";
+  ASSERT_EQ(words.at(key), 150);
+  ASSERT_TRUE(words.contains("42"));
+  ASSERT_EQ(words.erase(key), 1U);
+  ASSERT_FALSE(words.contains(key));
+  ASSERT_EQ(words.erase(words.find("42"))->first, "43");
+  ASSERT_EQ(words.erase(words.cbegin())->first, "1");
+  ASSERT_EQ(words.size(), 197U);
+}
+
+TEST(S21BtreeMapTest, MERGE_1) {
+  btree_map<int, std::string> first, second;
+  for (int i = 0; i < 600; i += 2) {
+    first.insert(i, "first");
+  }
+  for (int i = 0; i < 600; i += 3) {
+    second.insert(i, "second");
+  }
+  first.merge(second);
+  ASSERT_EQ(first.size(), 400U);
+  ASSERT_EQ(first.at(6), "first");
+  ASSERT_EQ(first.at(9), "second");
+  ASSERT_EQ(second.size(), 100U);
+  for (auto it = second.begin(); it != second.end(); ++it) {
+    ASSERT_EQ(it->first % 6, 0);
+    ASSERT_EQ(it->second, "second");
+  }
+}
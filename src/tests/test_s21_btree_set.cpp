@@ -0,0 +1,277 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <functional>
+#include <iterator>
+#include <set>
+#include <string>
+#include <string_view>
+
+#include "../containersplus/s21_btree_multiset.h"
+#include "../containersplus/s21_btree_set.h"
+#include "test_random.h"
+
+using namespace s21;
+
+TEST(S21BtreeSetTest, INSERT_1) {
+  btree_set<int> nums{5, 3, 8, 3};
+  ASSERT_EQ(nums.size(), 3U);
+  ASSERT_FALSE(nums.insert(5).second);
+  auto result = nums.insert(4);
+  ASSERT_TRUE(result.second);
+  ASSERT_EQ(*result.first, 4);
+}
+
+TEST(S21BtreeSetTest, RANDOM_1) {
+  btree_set<int> nums;
+  std::set<int> expected;
+  TestRandom random(1);
+  for (int i = 0; i < 20000; ++i) {
+    unsigned state = random.next();
+    int key = (state >> 8) % 3000;
+    if (state % 3 == 0) {
+      ASSERT_EQ(nums.erase(key), expected.erase(key));
+    } else {
+      ASSERT_EQ(nums.insert(key).second, expected.insert(key).second);
+    }
+  }
+  ASSERT_EQ(nums.size(), expected.size());
+  ASSERT_TRUE(std::equal(nums.begin(), nums.end(), expected.begin(),
+                         expected.end()));
+  ASSERT_TRUE(std::equal(nums.rbegin(), nums.rend(), expected.rbegin(),
+                         expected.rend()));
+}
+
+TEST(S21BtreeSetTest, FIND_1) {
+  btree_set<std::string> words{"pear", "apple", "plum"};
+  ASSERT_EQ(*words.find("apple"), "apple");
+  ASSERT_TRUE(words.find("grape") == words.end());
+  ASSERT_TRUE(words.contains("plum"));
+  ASSERT_EQ(words.count("pear"), 1U);
+  ASSERT_EQ(*words.lower_bound("b"), "pear");
+}
+
+TEST(S21BtreeSetTest, CLEAR_1) {
+  btree_set<int> nums;
+  for (int i = 0; i < 1000; ++i) {
+    nums.insert(i);
+  }
+  nums.clear();
+  ASSERT_TRUE(nums.empty());
+  ASSERT_TRUE(nums.begin() == nums.end());
+  nums.insert(1);
+  ASSERT_EQ(*nums.begin(), 1);
+}
+
+TEST(S21BtreeMultisetTest, INSERT_1) {
+  btree_multiset<int> nums;
+  for (int i = 0; i < 3000; ++i) {
+    nums.insert(i % 10);
+  }
+  ASSERT_EQ(nums.size(), 3000U);
+  ASSERT_EQ(nums.count(3), 300U);
+  auto range = nums.equal_range(3);
+  ASSERT_EQ(*range.first, 3);
+  ASSERT_EQ(*range.second, 4);
+}
+
+TEST(S21BtreeMultisetTest, ERASE_1) {
+  btree_multiset<int> nums{1, 2, 2, 2, 3};
+  nums.erase(nums.find(2));
+  ASSERT_EQ(nums.count(2), 2U);
+  ASSERT_EQ(nums.erase(2), 2U);
+  ASSERT_EQ(nums.erase(2), 0U);
+  ASSERT_EQ(nums.size(), 2U);
+  ASSERT_FALSE(nums.contains(2));
+}
+
+TEST(S21BtreeSetTest, MERGE_1) {
+  btree_set<int> first, second;
+  for (int i = 0; i < 600; i += 2) {
+    first.insert(i);
+  }
+  for (int i = 0; i < 600; i += 3) {
+    second.insert(i);
+  }
+  first.merge(second);
+  ASSERT_EQ(first.size(), 400U);
+  ASSERT_EQ(second.size(), 100U);
+  ASSERT_TRUE(second.contains(594));
+  ASSERT_FALSE(second.contains(9));
+
+  btree_multiset<int> many{1, 2, 2};
+  btree_multiset<int> more{2, 3};
+  many.merge(more);
+  ASSERT_EQ(many.size(), 5U);
+  ASSERT_EQ(many.count(2), 3U);
+  ASSERT_TRUE(more.empty());
+}
+
+TEST(S21BtreeSetTest, EMPTY_1) {
+  btree_set<int> nums;
+  ASSERT_TRUE(nums.empty());
+  ASSERT_EQ(nums.size(), 0U);
+  ASSERT_GT(nums.max_size(), 0U);
+  ASSERT_TRUE(nums.begin() == nums.end());
+  ASSERT_TRUE(nums.rbegin() == nums.rend());
+  ASSERT_TRUE(nums.find(0) == nums.end());
+  ASSERT_TRUE(nums.lower_bound(0) == nums.end());
+  ASSERT_TRUE(nums.upper_bound(0) == nums.end());
+  ASSERT_FALSE(nums.contains(0));
+  ASSERT_EQ(nums.erase(0), 0U);
+  ASSERT_TRUE(nums.erase(nums.end()) == nums.end());
+  btree_set<int> other;
+  nums.merge(other);
+  ASSERT_TRUE(nums.empty());
+}
+
+TEST(S21BtreeSetTest, ERASE_LAST_1) {
+  btree_set<int> one{7};
+  ASSERT_TRUE(one.erase(one.begin()) == one.end());
+  ASSERT_TRUE(one.empty());
+  ASSERT_TRUE(one.begin() == one.end());
+  ASSERT_TRUE(one.insert(8).second);
+
+  btree_set<int> nums;
+  for (int i = 0; i < 1000; ++i) {
+    nums.insert(i);
+  }
+  for (int i = 999; i >= 0; --i) {
+    auto last = std::prev(nums.end());
+    ASSERT_EQ(*last, i);
+    ASSERT_TRUE(nums.erase(last) == nums.end());
+  }
+  ASSERT_TRUE(nums.empty());
+}
+
+TEST(S21BtreeSetTest, ERASE_ITERATOR_1) {
+  btree_set<int> nums;
+  for (int i = 0; i < 500; ++i) {
+    nums.insert(i);
+  }
+  // Erasing may rebalance leaves, the returned iterator must still point at
+  // the successor
+  auto iter = nums.begin();
+  while (iter != nums.end()) {
+    int key = *iter;
+    iter = nums.erase(iter);
+    if (iter != nums.end()) {
+      ASSERT_EQ(*iter, key + 1);
+      ++iter;
+    }
+  }
+  ASSERT_EQ(nums.size(), 250U);
+  ASSERT_EQ(*nums.begin(), 1);
+  ASSERT_EQ(*nums.rbegin(), 499);
+}
+
+TEST(S21BtreeSetTest, BOUNDS_1) {
+  btree_set<int> nums;
+  for (int i = 0; i < 1000; i += 10) {
+    nums.insert(i);
+  }
+  ASSERT_EQ(*nums.lower_bound(10), 10);
+  ASSERT_EQ(*nums.upper_bound(10), 20);
+  ASSERT_EQ(*nums.lower_bound(11), 20);
+  ASSERT_EQ(*nums.lower_bound(-5), 0);
+  ASSERT_TRUE(nums.lower_bound(991) == nums.end());
+  ASSERT_TRUE(nums.upper_bound(990) == nums.end());
+  auto range = nums.equal_range(500);
+  ASSERT_EQ(*range.first, 500);
+  ASSERT_EQ(*range.second, 510);
+  range = nums.equal_range(505);
+  ASSERT_TRUE(range.first == range.second);
+}
+
+TEST(S21BtreeSetTest, CUSTOM_COMPARE_1) {
+  btree_set<int, std::greater<int>> nums;
+  for (int i = 0; i < 300; ++i) {
+    nums.insert(i);
+  }
+  ASSERT_EQ(*nums.begin(), 299);
+  ASSERT_EQ(*nums.rbegin(), 0);
+  ASSERT_EQ(*nums.lower_bound(150), 150);
+  ASSERT_EQ(*nums.upper_bound(150), 149);
+  ASSERT_TRUE(nums.key_comp()(2, 1));
+  ASSERT_TRUE(std::is_sorted(nums.begin(), nums.end(), std::greater<int>()));
+}
+
+TEST(S21BtreeSetTest, TRANSPARENT_LOOKUP_1) {
+  btree_set<std::string, std::less<>> words{"pear", "apple", "plum"};
+  std::string_view plum = "plum";
+  ASSERT_EQ(*words.find(plum), "plum");
+  ASSERT_TRUE(words.contains(std::string_view("apple")));
+  ASSERT_EQ(words.count(std::string_view("grape")), 0U);
+  ASSERT_EQ(*words.lower_bound(std::string_view("b")), "pear");
+  ASSERT_TRUE(words.upper_bound(plum) == words.end());
+  auto range = words.equal_range(std::string_view("pear"));
+  ASSERT_EQ(*range.second, "plum");
+  ASSERT_EQ(words.erase(plum), 1U);
+  ASSERT_EQ(words.erase(plum), 0U);
+  auto next = words.erase(words.begin());
+  ASSERT_EQ(*next, "pear");
+  ASSERT_EQ(words.size(), 1U);
+}
+
+TEST(S21BtreeSetTest, COPY_MOVE_SWAP_1) {
+  btree_set<int> first;
+  for (int i = 0; i < 200; ++i) {
+    first.insert(i);
+  }
+  btree_set<int> copy(first);
+  copy.erase(0);
+  ASSERT_TRUE(first.contains(0));
+  ASSERT_EQ(copy.size(), 199U);
+
+  btree_set<int> moved(std::move(copy));
+  ASSERT_TRUE(copy.empty());
+  ASSERT_EQ(moved.size(), 199U);
+  btree_set<int> small{-1};
+  small.swap(moved);
+  ASSERT_EQ(small.size(), 199U);
+  ASSERT_EQ(*moved.begin(), -1);
+  moved = first;
+  ASSERT_EQ(moved.size(), 200U);
+  first = std::move(small);
+  ASSERT_EQ(*first.begin(), 1);
+}
+
+TEST(S21BtreeMultisetTest, EMPTY_1) {
+  btree_multiset<int> nums;
+  ASSERT_TRUE(nums.empty());
+  ASSERT_TRUE(nums.begin() == nums.end());
+  ASSERT_EQ(nums.count(0), 0U);
+  auto range = nums.equal_range(0);
+  ASSERT_TRUE(range.first == nums.end());
+  ASSERT_TRUE(range.second == nums.end());
+  ASSERT_EQ(nums.erase(0), 0U);
+  ASSERT_TRUE(nums.erase(nums.end()) == nums.end());
+}
+
+TEST(S21BtreeMultisetTest, ERASE_LAST_1) {
+  btree_multiset<int> nums;
+  for (int i = 0; i < 600; ++i) {
+    nums.insert(i / 100);
+  }
+  ASSERT_EQ(nums.count(5), 100U);
+  auto last = std::prev(nums.end());
+  ASSERT_EQ(*last, 5);
+  ASSERT_TRUE(nums.erase(last) == nums.end());
+  ASSERT_EQ(nums.count(5), 99U);
+  ASSERT_EQ(nums.erase(5), 99U);
+  ASSERT_EQ(*nums.rbegin(), 4);
+  ASSERT_TRUE(nums.upper_bound(4) == nums.end());
+}
+
+TEST(S21BtreeMultisetTest, TRANSPARENT_LOOKUP_1) {
+  btree_multiset<std::string, std::less<>> words{"b", "a", "b", "c", "b"};
+  std::string_view b = "b";
+  ASSERT_EQ(words.count(b), 3U);
+  ASSERT_EQ(*words.find(b), "b");
+  ASSERT_EQ(*words.upper_bound(b), "c");
+  auto range = words.equal_range(b);
+  ASSERT_EQ(std::distance(range.first, range.second), 3);
+  ASSERT_EQ(words.erase(b), 3U);
+  ASSERT_FALSE(words.contains(b));
+  ASSERT_EQ(words.size(), 2U);
+}
@@ -0,0 +1,268 @@
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <functional>
+#include <map>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#include "../containersplus/s21_concurrent_map.h"
+#include "test_random.h"
+
+using namespace s21;
+
+TEST(S21ConcurrentMapTest, INSERT_ERASE_1) {
+  concurrent_map<int, std::string> words{{2, "two"}, {1, "one"}};
+  ASSERT_FALSE(words.insert(1, "uno"));
+  ASSERT_EQ(words.at(1), "one");
+  ASSERT_FALSE(words.insert_or_assign(1, "uno"));
+  ASSERT_EQ(*words.get(1), "uno");
+  ASSERT_TRUE(words.insert({3, "three"}));
+  ASSERT_EQ(words.size(), 3U);
+  ASSERT_EQ(words.erase(2), 1U);
+  ASSERT_EQ(words.erase(2), 0U);
+  ASSERT_FALSE(words.get(2).has_value());
+  ASSERT_THROW(words.at(2), std::out_of_range);
+  words.clear();
+  ASSERT_TRUE(words.empty());
+  ASSERT_FALSE(words.contains(1));
+}
+
+TEST(S21ConcurrentMapTest, MODEL_1) {
+  concurrent_map<int, int> nums;
+  std::map<int, int> expected;
+  TestRandom random(5);
+  for (int i = 0; i < 5000; ++i) {
+    unsigned state = random.next();
+    int key = (state >> 8) % 500;
+    if ((state >> 20) % 3 == 0) {
+      ASSERT_EQ(nums.erase(key), expected.erase(key));
+    } else {
+      nums.insert_or_assign(key, i);
+      expected[key] = i;
+    }
+  }
+  ASSERT_EQ(nums.size(), expected.size());
+  auto iter = expected.begin();
+  nums.for_each([&](int key, int value) {
+    ASSERT_EQ(key, iter->first);
+    ASSERT_EQ(value, iter->second);
+    ++iter;
+  });
+  ASSERT_TRUE(iter == expected.end());
+  std::vector<int> keys;
+  nums.for_each_in_range(100, 200, [&](int key, int) {
+    keys.push_back(key);
+    return keys.size() < 5;
+  });
+  std::vector<int> first_keys;
+  for (auto item = expected.lower_bound(100);
+       item != expected.end() && first_keys.size() < 5; ++item) {
+    first_keys.push_back(item->first);
+  }
+  ASSERT_EQ(keys, first_keys);
+}
+
+// Even keys are never touched by the writer, odd keys come and go. Every
+// scan must see all even keys and only complete values.
+TEST(S21ConcurrentMapTest, READERS_WITH_WRITER_1) {
+  concurrent_map<int, int> nums;
+  for (int key = 0; key < 1000; key += 2) {
+    nums.insert(key, key * 10);
+  }
+  std::atomic<bool> done{false};
+  std::atomic<int> failures{0};
+  std::vector<std::thread> readers;
+  for (int t = 0; t < 3; ++t) {
+    readers.emplace_back([&] {
+      while (!done.load()) {
+        int evens = 0;
+        nums.for_each([&](int key, int value) {
+          if (key % 2 == 0) {
+            ++evens;
+          }
+          if (value != key * 10) {
+            ++failures;
+          }
+        });
+        if (evens != 500 || !nums.contains(998) || nums.at(500) != 5000) {
+          ++failures;
+        }
+      }
+    });
+  }
+  for (int round = 0; round < 20; ++round) {
+    for (int key = 1; key < 1000; key += 2) {
+      nums.insert_or_assign(key, key * 10);
+    }
+    for (int key = 1; key < 1000; key += 2) {
+      nums.erase(key);
+    }
+  }
+  done.store(true);
+  for (std::thread &reader : readers) {
+    reader.join();
+  }
+  ASSERT_EQ(failures.load(), 0);
+  ASSERT_EQ(nums.size(), 500U);
+}
+
+TEST(S21ConcurrentMapTest, EMPTY_1) {
+  concurrent_map<int, int> nums;
+  ASSERT_TRUE(nums.empty());
+  ASSERT_EQ(nums.size(), 0U);
+  ASSERT_GT(nums.max_size(), 0U);
+  ASSERT_FALSE(nums.contains(0));
+  ASSERT_EQ(nums.count(0), 0U);
+  ASSERT_FALSE(nums.get(0).has_value());
+  ASSERT_THROW(nums.at(0), std::out_of_range);
+  ASSERT_EQ(nums.erase(0), 0U);
+  int visited = 0;
+  nums.for_each([&visited](int, int) { ++visited; });
+  nums.for_each_in_range(-100, 100, [&visited](int, int) { ++visited; });
+  ASSERT_EQ(visited, 0);
+  nums.clear();
+  ASSERT_TRUE(nums.empty());
+}
+
+TEST(S21ConcurrentMapTest, ERASE_LAST_1) {
+  concurrent_map<int, std::string> words{{1, "one"}};
+  ASSERT_EQ(words.erase(1), 1U);
+  ASSERT_TRUE(words.empty());
+  ASSERT_FALSE(words.contains(1));
+  ASSERT_TRUE(words.insert(1, "uno"));
+  ASSERT_EQ(words.at(1), "uno");
+
+  for (int key = 2; key <= 5; ++key) {
+    words.insert(key, std::to_string(key));
+  }
+  ASSERT_EQ(words.erase(5), 1U);
+  ASSERT_EQ(words.erase(1), 1U);
+  std::vector<int> keys;
+  words.for_each(
+      [&keys](int key, const std::string &) { keys.push_back(key); });
+  ASSERT_EQ(keys, (std::vector<int>{2, 3, 4}));
+}
+
+TEST(S21ConcurrentMapTest, INSERT_OR_ASSIGN_1) {
+  concurrent_map<int, int> nums;
+  ASSERT_TRUE(nums.insert_or_assign(1, 10));
+  ASSERT_FALSE(nums.insert_or_assign(1, 20));
+  ASSERT_EQ(nums.size(), 1U);
+  ASSERT_EQ(nums.at(1), 20);
+  ASSERT_FALSE(nums.insert(1, 30));
+  ASSERT_EQ(nums.at(1), 20);
+}
+
+TEST(S21ConcurrentMapTest, FOR_EACH_STOP_1) {
+  concurrent_map<int, int> nums;
+  for (int key = 0; key < 100; ++key) {
+    nums.insert(key, key * key);
+  }
+  std::vector<int> seen;
+  nums.for_each([&seen](int key, int) {
+    seen.push_back(key);
+    return key < 3;
+  });
+  ASSERT_EQ(seen, (std::vector<int>{0, 1, 2, 3}));
+
+  seen.clear();
+  nums.for_each_in_range(10, 90, [&seen](int key, int) {
+    seen.push_back(key);
+    return false;
+  });
+  ASSERT_EQ(seen, std::vector<int>{10});
+}
+
+TEST(S21ConcurrentMapTest, RANGE_BOUNDS_1) {
+  concurrent_map<int, int> nums;
+  for (int key = 0; key < 50; key += 5) {
+    nums.insert(key, key);
+  }
+  auto collect = [&nums](int from, int to) {
+    std::vector<int> keys;
+    nums.for_each_in_range(from, to, [&keys](int key, int) {
+      keys.push_back(key);
+    });
+    return keys;
+  };
+  ASSERT_EQ(collect(10, 25), (std::vector<int>{10, 15, 20}));
+  ASSERT_EQ(collect(11, 26), (std::vector<int>{15, 20, 25}));
+  ASSERT_TRUE(collect(20, 20).empty());
+  ASSERT_TRUE(collect(30, 10).empty());
+  ASSERT_TRUE(collect(46, 1000).empty());
+  ASSERT_EQ(collect(-10, 1).size(), 1U);
+  ASSERT_EQ(collect(-10, 1000).size(), 10U);
+}
+
+TEST(S21ConcurrentMapTest, CUSTOM_COMPARE_1) {
+  concurrent_map<int, int, std::greater<int>> nums;
+  for (int key = 1; key <= 10; ++key) {
+    nums.insert(key, -key);
+  }
+  std::vector<int> keys;
+  nums.for_each([&keys](int key, int) { keys.push_back(key); });
+  ASSERT_EQ(keys.front(), 10);
+  ASSERT_EQ(keys.back(), 1);
+
+  keys.clear();
+  nums.for_each_in_range(8, 4, [&keys](int key, int) { keys.push_back(key); });
+  ASSERT_EQ(keys, (std::vector<int>{8, 7, 6, 5}));
+  ASSERT_TRUE(nums.key_comp()(2, 1));
+}
+
+TEST(S21ConcurrentMapTest, TRANSPARENT_LOOKUP_1) {
+  concurrent_map<std::string, int, std::less<>> words{{"one", 1},
+                                                      {"two", 2}};
+  std::string_view two = "two";
+  ASSERT_EQ(words.at(two), 2);
+  ASSERT_EQ(*words.get("one"), 1);
+  ASSERT_FALSE(words.get(std::string_view("three")).has_value());
+  ASSERT_TRUE(words.contains(two));
+  ASSERT_EQ(words.count("one"), 1U);
+  ASSERT_THROW(words.at(std::string_view("zero")), std::out_of_range);
+  ASSERT_EQ(words.erase(two), 1U);
+  ASSERT_EQ(words.erase("two"), 0U);
+  ASSERT_EQ(words.size(), 1U);
+}
+
+TEST(S21ConcurrentMapTest, SEQUENTIAL_KEYS_1) {
+  concurrent_map<int, int> nums;
+  for (int key = 0; key < 5000; ++key) {
+    ASSERT_TRUE(nums.insert(key, key));
+  }
+  for (int key = 4999; key >= 0; key -= 2) {
+    ASSERT_EQ(nums.erase(key), 1U);
+  }
+  ASSERT_EQ(nums.size(), 2500U);
+  int expected = 0;
+  nums.for_each([&expected](int key, int value) {
+    ASSERT_EQ(key, expected);
+    ASSERT_EQ(value, expected);
+    expected += 2;
+  });
+  ASSERT_EQ(expected, 5000);
+}
+
+TEST(S21ConcurrentMapTest, WRITERS_1) {
+  concurrent_map<int, int> nums;
+  std::vector<std::thread> writers;
+  for (int t = 0; t < 4; ++t) {
+    writers.emplace_back([&nums, t] {
+      for (int i = 0; i < 500; ++i) {
+        nums.insert(i * 4 + t, t);
+      }
+      for (int i = 0; i < 500; i += 2) {
+        nums.erase(i * 4 + t);
+      }
+    });
+  }
+  for (std::thread &writer : writers) {
+    writer.join();
+  }
+  ASSERT_EQ(nums.size(), 1000U);
+  ASSERT_EQ(nums.at(4 * 1 + 3), 3);
+  ASSERT_FALSE(nums.contains(4 * 2 + 1));
+}
@@ -0,0 +1,175 @@
+#include <gtest/gtest.h>
+
+#include <map>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "../containersplus/s21_flat_map.h"
+
+using namespace s21;
+
+TEST(S21FlatMapTest, INSERT_1) {
+  flat_map<int, std::string> nums;
+  ASSERT_TRUE(nums.insert({3, "three"}).second);
+  ASSERT_TRUE(nums.insert(1, "one").second);
+  ASSERT_TRUE(nums.insert(2, "two").second);
+  ASSERT_FALSE(nums.insert(2, "second two").second);
+  ASSERT_EQ(nums.size(), 3U);
+  ASSERT_EQ(nums.at(2), "two");
+  ASSERT_THROW(nums.at(4), std::out_of_range);
+  int expected = 1;
+  for (auto it = nums.begin(); it != nums.end(); ++it, ++expected) {
+    ASSERT_EQ((*it).first, expected);
+  }
+}
+
+TEST(S21FlatMapTest, OPERATOR_BRACKETS_1) {
+  flat_map<int, int> nums;
+  for (int i = 0; i < 500; ++i) {
+    nums[(i * 37) % 50] += 1;
+  }
+  ASSERT_EQ(nums.size(), 50U);
+  ASSERT_EQ(nums[0], 10);
+  nums.insert_or_assign(0, 7);
+  ASSERT_EQ(nums.at(0), 7);
+}
+
+TEST(S21FlatMapTest, BULK_INSERT_1) {
+  flat_map<int, int> nums{{10, 1}, {30, 1}};
+  std::vector<std::pair<int, int>> batch{{20, 2}, {10, 2}, {5, 2}, {20, 3}};
+  nums.insert(batch.begin(), batch.end());
+  std::map<int, int> expected{{5, 2}, {10, 1}, {20, 2}, {30, 1}};
+  ASSERT_EQ(nums.size(), expected.size());
+  auto it = nums.begin();
+  for (const auto &item : expected) {
+    ASSERT_EQ((*it).first, item.first);
+    ASSERT_EQ((*it).second, item.second);
+    ++it;
+  }
+}
+
+TEST(S21FlatMapTest, ITERATOR_WRITE_1) {
+  flat_map<int, std::string> words{{1, "one"}, {2, "two"}, {3, "three"}};
+  auto it = words.find(2);
+  ASSERT_EQ(it->first, 2);
+  it->second = "zwei";
+  (*words.begin()).second += "!";
+  for (auto [key, value] : words) {
+    value += "?";
+    ASSERT_NE(key, 0);
+  }
+  ASSERT_EQ(words.at(1), "one!?");
+  ASSERT_EQ(words.at(2), "zwei?");
+  ASSERT_EQ(words.rbegin()->second, "three?");
+  std::pair<const int, std::string> copy = *it;
+  ASSERT_EQ(copy.second, "zwei?");
+}
+
+TEST(S21FlatMapTest, CONST_ITERATOR_1) {
+  using Map = flat_map<int, std::string>;
+  static_assert(
+      std::is_same_v<decltype(std::declval<const Map &>().begin()->second),
+                     const std::string &>);
+  static_assert(!std::is_assignable_v<
+                decltype((std::declval<const Map &>().find(1)->second)),
+                std::string>);
+  static_assert(!std::is_convertible_v<Map::const_iterator, Map::iterator>);
+
+  Map words{{1, "one"}, {2, "two"}, {3, "three"}};
+  const Map &view = words;
+  Map::const_iterator it = view.find(2);
+  ASSERT_EQ(it->second, "two");
+  ASSERT_TRUE(it == words.find(2));
+  ASSERT_TRUE(words.begin() != it);
+  std::pair<const int, std::string> copy = *it;
+  ASSERT_EQ(copy.second, "two");
+  ASSERT_EQ(view.lower_bound(2), it);
+  ASSERT_EQ(view.upper_bound(2)->first, 3);
+  ASSERT_EQ(view.equal_range(4).first, view.end());
+  ASSERT_EQ((*view.rbegin()).first, 3);
+  ASSERT_EQ(std::distance(view.cbegin(), view.cend()), 3);
+
+  auto next = words.erase(it);
+  ASSERT_EQ(next->first, 3);
+  next->second = "drei";
+  ASSERT_EQ(words.at(3), "drei");
+}
+
+TEST(S21FlatMapTest, INSERT_KEY_VALUE_1) {
+  // Two arguments of the same type that is not an iterator pick the
+  // key and value overload
+  flat_map<long, long> numbers;
+  ASSERT_TRUE(numbers.insert(1, 2).second);
+  ASSERT_FALSE(numbers.insert(1, 3).second);
+  ASSERT_EQ(numbers.at(1), 2);
+}
+
+TEST(S21FlatMapTest, ERASE_1) {
+  flat_map<int, int> nums{{1, 1}, {2, 2}, {3, 3}};
+  auto next = nums.erase(nums.find(2));
+  ASSERT_EQ((*next).first, 3);
+  ASSERT_EQ(nums.erase(3), 1U);
+  ASSERT_EQ(nums.erase(3), 0U);
+  ASSERT_EQ(nums.size(), 1U);
+}
+
+TEST(S21FlatMapTest, BOUNDS_1) {
+  flat_map<int, int> nums;
+  for (int i = 0; i < 100; i += 10) {
+    nums[i] = i;
+  }
+  ASSERT_EQ((*nums.lower_bound(15)).first, 20);
+  ASSERT_EQ((*nums.lower_bound(20)).first, 20);
+  ASSERT_EQ((*nums.upper_bound(20)).first, 30);
+  ASSERT_TRUE(nums.lower_bound(91) == nums.end());
+  ASSERT_TRUE(nums.lower_bound(-1) == nums.begin());
+}
+
+TEST(S21FlatMapTest, EXTRACT_REPLACE_1) {
+  flat_map<int, std::string> nums{{2, "b"}, {1, "a"}};
+  const int *keys = nums.begin().key;
+  auto parts = nums.extract_sequence();
+  ASSERT_TRUE(nums.empty());
+  ASSERT_EQ(parts.keys.data(), keys);
+  ASSERT_EQ(parts.values[1], "b");
+
+  parts.keys.push_back(3);
+  parts.values.push_back("c");
+  keys = parts.keys.data();
+  nums.replace(std::move(parts.keys), std::move(parts.values));
+  ASSERT_EQ(nums.at(3), "c");
+  ASSERT_EQ(nums.begin().key, keys);
+
+  vector<int> unsorted{2, 1};
+  vector<std::string> values{"b", "a"};
+  ASSERT_THROW(nums.replace(std::move(unsorted), std::move(values)),
+               std::invalid_argument);
+}
+
+TEST(S21FlatMapTest, TRANSPARENT_LOOKUP_1) {
+  flat_map<std::string, int, std::less<>> words{{"one", 1}, {"two", 2}};
+  std::string_view two = "two";
+  ASSERT_EQ(words.at(two), 2);
+  ASSERT_TRUE(words.contains("one"));
+  words[std::string_view("three")] = 3;
+  ASSERT_EQ(words.erase(two), 1U);
+  ASSERT_EQ(words.size(), 2U);
+  ASSERT_EQ(words.erase(words.find("one"))->first, "three");
+  auto next = words.erase(words.cbegin());
+  ASSERT_TRUE(words.empty());
+  ASSERT_EQ(next, words.end());
+}
+
+TEST(S21FlatMapTest, MERGE_1) {
+  flat_map<int, std::string> first{{1, "a"}, {3, "c"}, {5, "e"}};
+  flat_map<int, std::string> second{{2, "b"}, {3, "x"}, {6, "f"}};
+  first.merge(second);
+  ASSERT_EQ(first.size(), 5U);
+  ASSERT_EQ(first.at(3), "c");
+  ASSERT_EQ(first.at(6), "f");
+  ASSERT_EQ(second.size(), 1U);
+  ASSERT_EQ(second.at(3), "x");
+}
@@ -0,0 +1,212 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <functional>
+#include <set>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "../containersplus/s21_flat_set.h"
+#include "test_random.h"
+
+using namespace s21;
+
+TEST(S21FlatSetTest, INSERT_1) {
+  flat_set<int> nums{5, 1, 3, 3};
+  ASSERT_EQ(nums.size(), 3U);
+  ASSERT_FALSE(nums.insert(5).second);
+  auto result = nums.insert(4);
+  ASSERT_TRUE(result.second);
+  ASSERT_EQ(*result.first, 4);
+  std::vector<int> expected{1, 3, 4, 5};
+  ASSERT_TRUE(std::equal(nums.begin(), nums.end(), expected.begin(),
+                         expected.end()));
+}
+
+TEST(S21FlatSetTest, BULK_INSERT_1) {
+  flat_set<int> nums;
+  std::set<int> expected;
+  TestRandom random(7);
+  for (int round = 0; round < 20; ++round) {
+    std::vector<int> batch;
+    for (int i = 0; i < 200; ++i) {
+      batch.push_back(random.below(1000));
+    }
+    nums.insert(batch.begin(), batch.end());
+    expected.insert(batch.begin(), batch.end());
+    ASSERT_EQ(nums.size(), expected.size());
+  }
+  ASSERT_TRUE(std::equal(nums.begin(), nums.end(), expected.begin(),
+                         expected.end()));
+}
+
+TEST(S21FlatSetTest, LOOKUP_1) {
+  flat_set<std::string> words{"pear", "apple", "plum"};
+  ASSERT_EQ(*words.find("apple"), "apple");
+  ASSERT_TRUE(words.find("grape") == words.end());
+  ASSERT_TRUE(words.contains("plum"));
+  ASSERT_EQ(*words.lower_bound("b"), "pear");
+  ASSERT_EQ(*words.upper_bound("pear"), "plum");
+  ASSERT_TRUE(words.upper_bound("plum") == words.end());
+  ASSERT_EQ(words.erase("pear"), 1U);
+  ASSERT_EQ(*words.rbegin(), "plum");
+}
+
+TEST(S21FlatSetTest, EXTRACT_REPLACE_1) {
+  flat_set<int> nums{3, 1, 2};
+  const int *data = nums.begin();
+  vector<int> keys = nums.extract_sequence();
+  ASSERT_TRUE(nums.empty());
+  ASSERT_EQ(keys.data(), data);
+  keys.push_back(4);
+  data = keys.data();
+  nums.replace(std::move(keys));
+  ASSERT_EQ(nums.size(), 4U);
+  ASSERT_EQ(nums.begin(), data);
+
+  vector<int> duplicated{1, 1};
+  ASSERT_THROW(nums.replace(std::move(duplicated)), std::invalid_argument);
+}
+
+TEST(S21FlatSetTest, MERGE_1) {
+  flat_set<std::string> first{"apple", "pear"};
+  flat_set<std::string> second{"fig", "pear", "plum"};
+  first.merge(second);
+  std::vector<std::string> expected{"apple", "fig", "pear", "plum"};
+  ASSERT_TRUE(std::equal(first.begin(), first.end(), expected.begin(),
+                         expected.end()));
+  ASSERT_EQ(second.size(), 1U);
+  ASSERT_TRUE(second.contains("pear"));
+}
+
+TEST(S21FlatSetTest, EMPTY_1) {
+  flat_set<int> nums;
+  ASSERT_TRUE(nums.empty());
+  ASSERT_EQ(nums.size(), 0U);
+  ASSERT_GT(nums.max_size(), 0U);
+  ASSERT_TRUE(nums.begin() == nums.end());
+  ASSERT_TRUE(nums.rbegin() == nums.rend());
+  ASSERT_TRUE(nums.find(0) == nums.end());
+  ASSERT_TRUE(nums.lower_bound(0) == nums.end());
+  ASSERT_FALSE(nums.contains(0));
+  ASSERT_EQ(nums.erase(0), 0U);
+
+  std::vector<int> none;
+  nums.insert(none.begin(), none.end());
+  flat_set<int> other;
+  nums.merge(other);
+  ASSERT_TRUE(nums.empty());
+  ASSERT_TRUE(nums.extract_sequence().empty());
+  nums.replace(vector<int>());
+  ASSERT_TRUE(nums.empty());
+}
+
+TEST(S21FlatSetTest, ERASE_LAST_1) {
+  flat_set<int> one{7};
+  ASSERT_TRUE(one.erase(one.begin()) == one.end());
+  ASSERT_TRUE(one.empty());
+  ASSERT_TRUE(one.insert(8).second);
+
+  flat_set<int> nums{1, 2, 3, 4};
+  auto next = nums.erase(nums.end() - 1);
+  ASSERT_TRUE(next == nums.end());
+  ASSERT_EQ(*nums.rbegin(), 3);
+  next = nums.erase(nums.begin() + 1);
+  ASSERT_EQ(*next, 3);
+  ASSERT_EQ(nums.size(), 2U);
+  ASSERT_EQ(nums.erase(3), 1U);
+  ASSERT_EQ(nums.erase(1), 1U);
+  ASSERT_TRUE(nums.empty());
+}
+
+TEST(S21FlatSetTest, BOUNDS_1) {
+  flat_set<int> nums;
+  for (int i = 0; i < 100; i += 10) {
+    nums.insert(i);
+  }
+  ASSERT_EQ(*nums.lower_bound(10), 10);
+  ASSERT_EQ(*nums.upper_bound(10), 20);
+  ASSERT_EQ(*nums.lower_bound(11), 20);
+  ASSERT_EQ(*nums.lower_bound(-5), 0);
+  ASSERT_TRUE(nums.lower_bound(91) == nums.end());
+  ASSERT_TRUE(nums.upper_bound(90) == nums.end());
+  auto range = nums.equal_range(50);
+  ASSERT_EQ(range.second - range.first, 1);
+  range = nums.equal_range(55);
+  ASSERT_TRUE(range.first == range.second);
+  ASSERT_EQ(*range.first, 60);
+}
+
+TEST(S21FlatSetTest, BULK_INSERT_EDGES_1) {
+  flat_set<int> nums{10, 20, 30};
+  std::vector<int> batch{30, 5, 5, 40, 20, 35};
+  nums.insert(batch.begin(), batch.end());
+  std::vector<int> expected{5, 10, 20, 30, 35, 40};
+  ASSERT_TRUE(std::equal(nums.begin(), nums.end(), expected.begin(),
+                         expected.end()));
+
+  std::vector<int> present{40, 5, 10};
+  nums.insert(present.begin(), present.end());
+  ASSERT_EQ(nums.size(), 6U);
+  std::set<int> tail{100, 50};
+  nums.insert(tail.begin(), tail.end());
+  ASSERT_EQ(*nums.rbegin(), 100);
+  ASSERT_EQ(nums.size(), 8U);
+}
+
+TEST(S21FlatSetTest, CUSTOM_COMPARE_1) {
+  flat_set<int, std::greater<int>> nums{1, 5, 3, 5};
+  ASSERT_EQ(nums.size(), 3U);
+  ASSERT_EQ(*nums.begin(), 5);
+  ASSERT_EQ(*nums.rbegin(), 1);
+  ASSERT_EQ(*nums.lower_bound(4), 3);
+  ASSERT_TRUE(nums.upper_bound(1) == nums.end());
+  std::vector<int> batch{2, 6};
+  nums.insert(batch.begin(), batch.end());
+  ASSERT_TRUE(std::is_sorted(nums.begin(), nums.end(), std::greater<int>()));
+  ASSERT_TRUE(nums.key_comp()(2, 1));
+
+  vector<int> ascending{1, 2};
+  ASSERT_THROW(nums.replace(std::move(ascending)), std::invalid_argument);
+  vector<int> descending{2, 1};
+  nums.replace(std::move(descending));
+  ASSERT_EQ(*nums.begin(), 2);
+}
+
+TEST(S21FlatSetTest, TRANSPARENT_LOOKUP_1) {
+  flat_set<std::string, std::less<>> words{"pear", "apple", "plum"};
+  std::string_view plum = "plum";
+  ASSERT_EQ(*words.find(plum), "plum");
+  ASSERT_TRUE(words.contains(std::string_view("apple")));
+  ASSERT_EQ(words.count(std::string_view("grape")), 0U);
+  ASSERT_EQ(*words.lower_bound(std::string_view("b")), "pear");
+  ASSERT_TRUE(words.upper_bound(plum) == words.end());
+  auto range = words.equal_range(std::string_view("pear"));
+  ASSERT_EQ(*range.second, "plum");
+  ASSERT_EQ(words.erase(plum), 1U);
+  ASSERT_EQ(words.erase(plum), 0U);
+  auto next = words.erase(words.begin());
+  ASSERT_EQ(*next, "pear");
+  ASSERT_EQ(words.size(), 1U);
+}
+
+TEST(S21FlatSetTest, COPY_MOVE_SWAP_1) {
+  flat_set<int> first{1, 2, 3};
+  flat_set<int> copy(first);
+  copy.erase(1);
+  ASSERT_TRUE(first.contains(1));
+  ASSERT_EQ(copy.size(), 2U);
+
+  const int *data = copy.begin();
+  flat_set<int> moved(std::move(copy));
+  ASSERT_EQ(moved.begin(), data);
+  flat_set<int> small{-1};
+  small.swap(moved);
+  ASSERT_EQ(small.begin(), data);
+  ASSERT_EQ(*moved.begin(), -1);
+  moved = first;
+  ASSERT_EQ(moved.size(), 3U);
+  first = std::move(small);
+  ASSERT_EQ(*first.begin(), 2);
+}
@@ -0,0 +1,102 @@
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <cstdio>
+#include <map>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "../containers/s21_map.h"
+#include "../containersplus/s21_frozen_map.h"
+
+using namespace s21;
+
+struct Quote {
+  double bid;
+  double ask;
+  int32_t size;
+};
+
+TEST(S21FrozenMapTest, SNAPSHOT_1) {
+  std::string path = testing::TempDir() + "s21_frozen_map_1.bin";
+  map<int64_t, Quote> quotes;
+  std::map<int64_t, Quote> expected;
+  for (int64_t i = 0; i < 3000; ++i) {
+    int64_t key = (i * 104729) % 50021 - 25000;
+    Quote quote{i * 0.5, i * 0.5 + 1, static_cast<int32_t>(i)};
+    quotes.insert_or_assign(key, quote);
+    expected[key] = quote;
+  }
+  save_snapshot(quotes, path);
+  quotes.clear();
+
+  frozen_map<int64_t, Quote> frozen(path);
+  ASSERT_EQ(frozen.size(), expected.size());
+  auto want = expected.begin();
+  for (auto [key, quote] : frozen) {
+    ASSERT_EQ(key, want->first);
+    ASSERT_EQ(quote.size, want->second.size);
+    ++want;
+  }
+  for (const auto &[key, quote] : expected) {
+    ASSERT_DOUBLE_EQ(frozen.at(key).ask, quote.ask);
+  }
+  ASSERT_THROW(frozen.at(25001), std::out_of_range);
+  ASSERT_EQ(frozen.find(25001), frozen.end());
+
+  auto lower = frozen.lower_bound(-100);
+  ASSERT_EQ(lower.key(), expected.lower_bound(-100)->first);
+  auto upper = frozen.upper_bound(lower.key());
+  ASSERT_EQ(upper, ++lower);
+  ASSERT_EQ((*--frozen.end()).first, expected.rbegin()->first);
+  std::remove(path.c_str());
+}
+
+TEST(S21FrozenMapTest, SNAPSHOT_2) {
+  std::string path = testing::TempDir() + "s21_frozen_map_2.bin";
+  map<int, int> small{{3, 30}, {1, 10}, {2, 20}};
+  save_snapshot(small, path);
+  ASSERT_THROW((frozen_map<int, long>(path)), std::runtime_error);
+
+  frozen_map<int, int> first(path);
+  small[4] = 40;
+  save_snapshot(small, path);
+  frozen_map<int, int> second(path);
+  ASSERT_EQ(first.size(), 3U);
+  ASSERT_EQ(second.size(), 4U);
+  ASSERT_FALSE(first.contains(4));
+  ASSERT_EQ(second.at(4), 40);
+
+  first = std::move(second);
+  ASSERT_EQ(first.at(2), 20);
+  ASSERT_EQ(first.count(4), 1U);
+  ASSERT_TRUE(second.empty());
+  std::remove(path.c_str());
+}
+
+TEST(S21FrozenMapTest, BUILD_1) {
+  map<uint32_t, double> prices{{30, 3.5}, {10, 1.5}, {20, 2.5}};
+  frozen_map<uint32_t, double> frozen(prices.begin(), prices.end());
+  ASSERT_EQ(frozen.size(), 3U);
+  ASSERT_DOUBLE_EQ(frozen.at(20), 2.5);
+  ASSERT_EQ(frozen.lower_bound(11).key(), 20U);
+  ASSERT_EQ(frozen.upper_bound(30), frozen.end());
+
+  frozen_map<int, char> unsorted{{5, 'a'}, {-1, 'b'}, {5, 'c'}, {3, 'd'}};
+  std::string walked;
+  for (auto [key, letter] : unsorted) {
+    walked += letter;
+  }
+  ASSERT_EQ(walked, "bda");
+
+  std::vector<int> keys{5, 4, 3, -1, -2};
+  std::vector<frozen_map<int, char>::iterator> found;
+  unsorted.find_many(keys, found);
+  ASSERT_EQ(found.size(), keys.size());
+  ASSERT_EQ(found[0].value(), 'a');
+  ASSERT_EQ(found[1], unsorted.end());
+  ASSERT_EQ(found[2].value(), 'd');
+  ASSERT_EQ(found[3].value(), 'b');
+  ASSERT_EQ(found[4], unsorted.end());
+}
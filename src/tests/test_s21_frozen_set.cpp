@@ -0,0 +1,144 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "../containers/s21_set.h"
+#include "../containersplus/s21_frozen_set.h"
+
+using namespace s21;
+
+TEST(S21FrozenSetTest, SNAPSHOT_1) {
+  std::string path = testing::TempDir() + "s21_frozen_set_1.bin";
+  set<uint64_t> ids;
+  std::vector<uint64_t> expected;
+  for (uint64_t i = 0; i < 5000; ++i) {
+    ids.insert(i * 7919 % 10007);
+  }
+  for (uint64_t id : ids) {
+    expected.push_back(id);
+  }
+  save_snapshot(ids, path);
+
+  frozen_set<uint64_t> frozen(path);
+  ASSERT_EQ(frozen.size(), ids.size());
+  ASSERT_TRUE(std::equal(frozen.begin(), frozen.end(), expected.begin(),
+                         expected.end()));
+  for (uint64_t key = 0; key < 10010; key += 3) {
+    ASSERT_EQ(frozen.contains(key), ids.contains(key));
+    auto lower = frozen.lower_bound(key);
+    auto tree_lower = ids.lower_bound(key);
+    ASSERT_EQ(lower == frozen.end(), tree_lower == ids.end());
+    if (lower != frozen.end()) {
+      ASSERT_EQ(*lower, *tree_lower);
+    }
+  }
+  ASSERT_EQ(frozen.find(10008), frozen.end());
+  ASSERT_EQ(*frozen.rbegin(), expected.back());
+
+  frozen_set<uint64_t> moved(std::move(frozen));
+  ASSERT_TRUE(frozen.empty());
+  ASSERT_EQ(moved.count(expected[10]), 1U);
+  std::remove(path.c_str());
+}
+
+TEST(S21FrozenSetTest, SNAPSHOT_2) {
+  std::string path = testing::TempDir() + "s21_frozen_set_2.bin";
+  set<int> empty;
+  save_snapshot(empty, path);
+  frozen_set<int> none(path);
+  ASSERT_TRUE(none.empty());
+  ASSERT_EQ(none.begin(), none.end());
+  ASSERT_FALSE(none.contains(1));
+
+  ASSERT_THROW(frozen_set<int64_t> wrong(path), std::runtime_error);
+  ASSERT_THROW(frozen_set<int> missing(path + ".missing"),
+               std::runtime_error);
+  FILE *file = std::fopen(path.c_str(), "wb");
+  std::fputs("not a snapshot", file);
+  std::fclose(file);
+  ASSERT_THROW(frozen_set<int> garbage(path), std::runtime_error);
+  std::remove(path.c_str());
+}
+
+TEST(S21FrozenSetTest, EYTZINGER_1) {
+  for (size_t n = 0; n < 70; ++n) {
+    std::vector<int> sorted;
+    for (size_t i = 0; i < n; ++i) {
+      sorted.push_back(static_cast<int>(i) * 2);
+    }
+    frozen_set<int> frozen(sorted.begin(), sorted.end());
+    ASSERT_TRUE(std::equal(frozen.begin(), frozen.end(), sorted.begin(),
+                           sorted.end()));
+    ASSERT_TRUE(std::equal(frozen.rbegin(), frozen.rend(), sorted.rbegin(),
+                           sorted.rend()));
+    for (int key = -1; key <= static_cast<int>(2 * n); ++key) {
+      auto want = std::lower_bound(sorted.begin(), sorted.end(), key);
+      auto got = frozen.lower_bound(key);
+      ASSERT_EQ(got == frozen.end(), want == sorted.end());
+      if (want != sorted.end()) {
+        ASSERT_EQ(*got, *want);
+      }
+      auto after = std::upper_bound(sorted.begin(), sorted.end(), key);
+      ASSERT_EQ(std::distance(frozen.begin(), frozen.upper_bound(key)),
+                after - sorted.begin());
+    }
+  }
+}
+
+template <typename Key>
+void checkContainsMany(const std::vector<Key> &stored,
+                       const std::vector<Key> &probes) {
+  set<Key> tree(stored.begin(), stored.end());
+  frozen_set<Key> frozen(tree.begin(), tree.end());
+  std::vector<bool> present;
+  std::vector<typename frozen_set<Key>::iterator> found;
+  frozen.contains_many(probes, present);
+  frozen.find_many(probes, found);
+  ASSERT_EQ(present.size(), probes.size());
+  for (size_t i = 0; i < probes.size(); ++i) {
+    ASSERT_EQ(present[i], tree.contains(probes[i]));
+    ASSERT_EQ(found[i], frozen.find(probes[i]));
+  }
+}
+
+TEST(S21FrozenSetTest, CONTAINS_MANY_1) {
+  unsigned long long state = 88172645463325252ULL;
+  auto next = [&state] {
+    state ^= state << 13;
+    state ^= state >> 7;
+    state ^= state << 17;
+    return state;
+  };
+  std::vector<uint64_t> wide, wide_probes;
+  std::vector<int64_t> signed_wide, signed_wide_probes;
+  std::vector<uint32_t> narrow, narrow_probes;
+  std::vector<int32_t> signed_narrow, signed_narrow_probes;
+  std::vector<double> reals, real_probes;
+  for (int i = 0; i < 3000; ++i) {
+    uint64_t bits = next();
+    uint64_t probe = i % 2 == 0 ? bits : next();
+    wide.push_back(bits);
+    wide_probes.push_back(probe);
+    signed_wide.push_back(static_cast<int64_t>(bits));
+    signed_wide_probes.push_back(static_cast<int64_t>(probe));
+    narrow.push_back(static_cast<uint32_t>(bits >> 40));
+    narrow_probes.push_back(static_cast<uint32_t>(probe >> 40));
+    signed_narrow.push_back(static_cast<int32_t>(bits >> 40));
+    signed_narrow_probes.push_back(static_cast<int32_t>(probe >> 40));
+    reals.push_back(static_cast<double>(bits % 5000) - 2500);
+    real_probes.push_back(static_cast<double>(probe % 5000) - 2500);
+  }
+  wide_probes.push_back(0);
+  wide_probes.push_back(~0ULL);
+  checkContainsMany(wide, wide_probes);
+  checkContainsMany(signed_wide, signed_wide_probes);
+  checkContainsMany(narrow, narrow_probes);
+  checkContainsMany(signed_narrow, signed_narrow_probes);
+  checkContainsMany(reals, real_probes);
+  checkContainsMany(std::vector<int>{}, std::vector<int>{1, 2, 3});
+}
@@ -0,0 +1,279 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <iterator>
+#include <limits>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "../containersplus/s21_interval_map.h"
+#include "test_random.h"
+
+using namespace s21;
+
+TEST(S21IntervalMapTest, STABBING_1) {
+  interval_map<interval<int>, std::string> shifts{
+      {{0, 8}, "night"}, {{6, 14}, "early"}, {{12, 20}, "late"},
+      {{18, 24}, "evening"}};
+  std::vector<std::string> names;
+  shifts.for_each_containing(
+      7, [&](const interval<int> &, std::string &name) {
+        names.push_back(name);
+      });
+  ASSERT_EQ(names, (std::vector<std::string>{"night", "early"}));
+  ASSERT_EQ(shifts.count_containing(8), 1U);
+  ASSERT_EQ(shifts.count_containing(13), 2U);
+  ASSERT_EQ(shifts.count_containing(24), 0U);
+  ASSERT_EQ(shifts.count_containing(-1), 0U);
+
+  auto found = shifts.containing(19);
+  ASSERT_EQ(found.size(), 2U);
+  ASSERT_EQ(found[0]->second, "late");
+  found[1]->second = "night shift";
+  ASSERT_EQ(shifts.containing(23)[0]->second, "night shift");
+}
+
+TEST(S21IntervalMapTest, OVERLAP_1) {
+  interval_map<std::pair<long, long>, int> validity;
+  validity.insert({10, 20}, 1);
+  validity.insert({15, 25}, 2);
+  validity.insert({30, 40}, 3);
+  validity.insert({15, 25}, 4);
+  ASSERT_EQ(validity.size(), 4U);
+
+  std::vector<int> ids;
+  for (auto it : validity.overlapping(20, 30)) {
+    ids.push_back(it->second);
+  }
+  ASSERT_EQ(ids, (std::vector<int>{2, 4}));
+  ASSERT_TRUE(validity.overlapping(25, 30).empty());
+  ASSERT_TRUE(validity.overlapping(12, 12).empty());
+
+  int visited = 0;
+  validity.for_each_overlapping(0, 100, [&](const auto &, int) {
+    return ++visited < 2;
+  });
+  ASSERT_EQ(visited, 2);
+
+  ASSERT_EQ(validity.erase({15, 25}), 2U);
+  ASSERT_EQ(validity.erase({15, 25}), 0U);
+  ASSERT_EQ(validity.count_containing(17), 1U);
+  ASSERT_EQ(validity.find({30, 40})->second, 3);
+  ASSERT_EQ(validity.find({30, 41}), validity.end());
+}
+
+TEST(S21IntervalMapTest, RANDOM_1) {
+  interval_map<interval<int>, int> tree;
+  std::vector<std::pair<interval<int>, int>> expected;
+  TestRandom random(3);
+  auto next = [&random] { return static_cast<int>(random.below(1000)); };
+  for (int step = 0; step < 2000; ++step) {
+    if (step % 4 == 3 && !expected.empty()) {
+      size_t index = static_cast<size_t>(next()) % expected.size();
+      auto it = tree.find(expected[index].first);
+      while (it->second != expected[index].second) {
+        ++it;
+      }
+      tree.erase(it);
+      expected.erase(expected.begin() + static_cast<long>(index));
+    } else {
+      int start = next();
+      interval<int> span{start, start + next() % 50};
+      tree.insert(span, step);
+      expected.push_back({span, step});
+    }
+    int lo = next(), hi = lo + next() % 30;
+    std::vector<int> want, got;
+    for (const auto &[span, id] : expected) {
+      if (lo < hi && span.start < hi && lo < span.end) {
+        want.push_back(id);
+      }
+    }
+    for (auto it : tree.overlapping(lo, hi)) {
+      got.push_back(it->second);
+    }
+    std::sort(want.begin(), want.end());
+    std::sort(got.begin(), got.end());
+    ASSERT_EQ(got, want);
+
+    size_t stabbed = 0;
+    for (const auto &item : expected) {
+      stabbed += item.first.start <= lo && lo < item.first.end ? 1 : 0;
+    }
+    ASSERT_EQ(tree.count_containing(lo), stabbed);
+  }
+  ASSERT_EQ(tree.size(), expected.size());
+}
+
+TEST(S21IntervalMapTest, EMPTY_1) {
+  interval_map<interval<int>, int> tree;
+  ASSERT_TRUE(tree.empty());
+  ASSERT_EQ(tree.size(), 0U);
+  ASSERT_TRUE(tree.begin() == tree.end());
+  ASSERT_TRUE(tree.find({0, 1}) == tree.end());
+  ASSERT_FALSE(tree.contains({0, 1}));
+  ASSERT_EQ(tree.count_containing(0), 0U);
+  ASSERT_TRUE(tree.containing(0).empty());
+  ASSERT_TRUE(tree.overlapping(-100, 100).empty());
+  ASSERT_EQ(tree.erase({0, 1}), 0U);
+  ASSERT_TRUE(tree.erase(tree.end()) == tree.end());
+  tree.clear();
+  ASSERT_TRUE(tree.empty());
+}
+
+TEST(S21IntervalMapTest, ERASE_LAST_1) {
+  interval_map<interval<int>, int> tree{{{0, 10}, 1}};
+  ASSERT_TRUE(tree.erase(tree.begin()) == tree.end());
+  ASSERT_TRUE(tree.empty());
+  ASSERT_EQ(tree.count_containing(5), 0U);
+
+  // The longest interval holds the largest end of the tree, removing it
+  // must shrink the end points the queries prune by
+  tree.insert({0, 100}, 1);
+  tree.insert({1, 2}, 2);
+  tree.insert({3, 4}, 3);
+  ASSERT_EQ(tree.count_containing(50), 1U);
+  ASSERT_EQ(tree.erase({0, 100}), 1U);
+  ASSERT_EQ(tree.count_containing(50), 0U);
+  ASSERT_TRUE(tree.overlapping(5, 1000).empty());
+
+  auto last = std::prev(tree.end());
+  ASSERT_EQ(last->second, 3);
+  ASSERT_TRUE(tree.erase(last) == tree.end());
+  ASSERT_EQ(tree.overlapping(0, 1000).size(), 1U);
+}
+
+TEST(S21IntervalMapTest, HALF_OPEN_1) {
+  interval_map<interval<int>, char> tree{
+      {{5, 10}, 'a'}, {{10, 15}, 'b'}, {{7, 7}, 'e'}};
+  ASSERT_EQ(tree.count_containing(5), 1U);
+  ASSERT_EQ(tree.containing(10)[0]->second, 'b');
+  ASSERT_EQ(tree.count_containing(10), 1U);
+  ASSERT_EQ(tree.count_containing(15), 0U);
+  ASSERT_EQ(tree.count_containing(7), 1U);
+  ASSERT_EQ(tree.overlapping(0, 5).size(), 0U);
+  ASSERT_EQ(tree.overlapping(9, 10).size(), 1U);
+  ASSERT_EQ(tree.overlapping(9, 11).size(), 2U);
+  ASSERT_EQ(tree.overlapping(15, 20).size(), 0U);
+  ASSERT_TRUE(tree.overlapping(8, 8).empty());
+  ASSERT_TRUE(tree.overlapping(12, 6).empty());
+}
+
+TEST(S21IntervalMapTest, DUPLICATES_1) {
+  interval_map<interval<int>, int> tree;
+  tree.insert({1, 5}, 10);
+  tree.insert({1, 5}, 20);
+  tree.insert({1, 3}, 30);
+  tree.insert({1, 5}, 40);
+  ASSERT_EQ(tree.size(), 4U);
+  ASSERT_EQ(tree.begin()->second, 30);
+
+  auto it = tree.find({1, 5});
+  ASSERT_EQ(it->second, 10);
+  ASSERT_EQ((++it)->second, 20);
+  ASSERT_EQ((++it)->second, 40);
+  it = tree.erase(tree.find({1, 5}));
+  ASSERT_EQ(it->second, 20);
+  ASSERT_EQ(tree.count_containing(4), 2U);
+  ASSERT_EQ(tree.erase({1, 5}), 2U);
+  ASSERT_EQ(tree.size(), 1U);
+  ASSERT_EQ(tree.count_containing(2), 1U);
+}
+
+TEST(S21IntervalMapTest, POINT_TYPES_1) {
+  interval_map<interval<int>, int> wide{
+      {{std::numeric_limits<int>::min(), std::numeric_limits<int>::max()}, 1},
+      {{-20, -10}, 2}};
+  ASSERT_EQ(wide.count_containing(0), 1U);
+  ASSERT_EQ(wide.count_containing(-15), 2U);
+  ASSERT_EQ(wide.count_containing(std::numeric_limits<int>::min()), 1U);
+  ASSERT_EQ(wide.count_containing(std::numeric_limits<int>::max()), 0U);
+
+  interval_map<std::pair<double, double>, std::string> spans{
+      {{0.5, 1.5}, "a"}, {{1.25, 2.0}, "b"}};
+  ASSERT_EQ(spans.count_containing(1.3), 2U);
+  ASSERT_EQ(spans.count_containing(1.5), 1U);
+  ASSERT_EQ(spans.overlapping(1.9, 3.0)[0]->second, "b");
+}
+
+TEST(S21IntervalMapTest, ITERATOR_1) {
+  interval_map<interval<int>, int> tree{
+      {{3, 4}, 1}, {{1, 9}, 2}, {{1, 2}, 3}, {{2, 3}, 4}};
+  std::vector<int> values;
+  for (const auto &item : tree) {
+    values.push_back(item.second);
+  }
+  ASSERT_EQ(values, (std::vector<int>{3, 2, 4, 1}));
+
+  values.clear();
+  for (auto it = tree.rbegin(); it != tree.rend(); ++it) {
+    values.push_back(it->second);
+  }
+  ASSERT_EQ(values, (std::vector<int>{1, 4, 2, 3}));
+
+  auto it = tree.find({2, 3});
+  it->second = 40;
+  ASSERT_EQ(tree.containing(2).back()->second, 40);
+  ASSERT_EQ((--it)->first.end, 9);
+}
+
+TEST(S21IntervalMapTest, COPY_MOVE_SWAP_1) {
+  interval_map<interval<int>, int> first{{{0, 10}, 1}, {{5, 15}, 2}};
+  interval_map<interval<int>, int> copy(first);
+  copy.insert({20, 30}, 3);
+  copy.erase({0, 10});
+  ASSERT_EQ(first.count_containing(2), 1U);
+  ASSERT_EQ(first.count_containing(25), 0U);
+  ASSERT_EQ(copy.count_containing(2), 0U);
+  ASSERT_EQ(copy.count_containing(25), 1U);
+
+  interval_map<interval<int>, int> moved(std::move(copy));
+  ASSERT_TRUE(copy.empty());
+  ASSERT_EQ(moved.size(), 2U);
+  first.swap(moved);
+  ASSERT_EQ(first.count_containing(25), 1U);
+  ASSERT_EQ(moved.count_containing(2), 1U);
+  moved = std::move(first);
+  ASSERT_EQ(moved.count_containing(12), 1U);
+  ASSERT_EQ(moved.count_containing(2), 0U);
+}
+
+TEST(S21IntervalMapTest, VISIT_STOP_1) {
+  interval_map<interval<int>, int> tree;
+  for (int i = 0; i < 50; ++i) {
+    tree.insert({i, i + 100}, i);
+  }
+  std::vector<int> seen;
+  tree.for_each_containing(60, [&seen](const interval<int> &, int value) {
+    seen.push_back(value);
+    return seen.size() < 3;
+  });
+  ASSERT_EQ(seen, (std::vector<int>{0, 1, 2}));
+
+  int visited = 0;
+  tree.for_each_overlapping(200, 300, [&visited](const auto &, int) {
+    ++visited;
+  });
+  ASSERT_EQ(visited, 0);
+  tree.for_each_overlapping(148, 300, [&visited](const auto &, int value) {
+    visited += value;
+  });
+  ASSERT_EQ(visited, 49);
+}
+
+TEST(S21IntervalMapTest, NESTED_1) {
+  interval_map<interval<int>, int> tree;
+  for (int i = 0; i < 1000; ++i) {
+    tree.insert({i, 2000 - i}, i);
+  }
+  ASSERT_EQ(tree.count_containing(1000), 1000U);
+  ASSERT_EQ(tree.count_containing(10), 11U);
+  ASSERT_EQ(tree.count_containing(1995), 5U);
+  for (int i = 0; i < 1000; i += 2) {
+    ASSERT_EQ(tree.erase({i, 2000 - i}), 1U);
+  }
+  ASSERT_EQ(tree.count_containing(1000), 500U);
+  ASSERT_EQ(tree.count_containing(1), 1U);
+  ASSERT_EQ(tree.overlapping(1990, 1991).size(), 5U);
+}
@@ -1,6 +1,11 @@
 #include <gtest/gtest.h>
 
 #include <string>
+#include <string_view>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
 
 #include "../containers/s21_map.h"
 
@@ -151,8 +156,63 @@ TEST(S21MapTest, END_1) {
   nums.insert({1, "One"});
   nums.insert({2, "Two"});
   auto it = nums.end();
+  --it;
 
-  ASSERT_EQ(it, nullptr);
+  ASSERT_EQ((*it).first, 2);
+  ASSERT_EQ((*it).second, "Two");
+}
+
+TEST(S21MapTest, REVERSE_ITERATOR_1) {
+  map<int, int> nums;
+  for (int i = 0; i < 100; ++i) {
+    nums.insert({i, i * 10});
+  }
+  nums.erase(nums.nth(99));
+  nums.erase(nums.begin());
+
+  int expected = 98;
+  for (auto it = nums.rbegin(); it != nums.rend(); ++it, --expected) {
+    ASSERT_EQ((*it).first, expected);
+    ASSERT_EQ((*it).second, expected * 10);
+  }
+  ASSERT_EQ(expected, 0);
+}
+
+TEST(S21MapTest, TRANSPARENT_LOOKUP_1) {
+  map<std::string, int, std::less<>> nums{{"one", 1}, {"two", 2}};
+  std::string_view two = "two";
+
+  ASSERT_EQ(nums.at(two), 2);
+  ASSERT_EQ(nums.at("one"), 1);
+  ASSERT_TRUE(nums.contains(two));
+  ASSERT_FALSE(nums.contains("three"));
+  ASSERT_EQ(nums.count("one"), 1U);
+  ASSERT_EQ((*nums.find(two)).second, 2);
+  ASSERT_TRUE(nums.find("zero") == nums.end());
+  ASSERT_THROW(nums.at(std::string_view("zero")), std::out_of_range);
+
+  nums[std::string_view("three")] = 3;
+  ASSERT_EQ(nums.at("three"), 3);
+  ASSERT_EQ(nums.rank(two), 2U);
+  ASSERT_EQ(nums.erase(two), 1U);
+  ASSERT_EQ(nums.erase("two"), 0U);
+  ASSERT_EQ(nums.size(), 2U);
+}
+
+TEST(S21MapTest, TRANSPARENT_ERASE_ITERATOR_1) {
+  using Map = map<std::string, int, std::less<>>;
+  static_assert(std::is_same_v<decltype(std::declval<Map &>().erase(
+                                   std::declval<Map::const_iterator>())),
+                               Map::iterator>);
+  Map nums{{"one", 1}, {"three", 3}, {"two", 2}};
+  const Map &view = nums;
+
+  Map::const_iterator first = view.begin();
+  ASSERT_EQ((*nums.erase(first)).first, "three");
+  ASSERT_EQ((*nums.erase(nums.find("three"))).first, "two");
+  ASSERT_EQ(nums.size(), 1U);
+  ASSERT_EQ(nums.erase("two"), 1U);
+  ASSERT_TRUE(nums.empty());
 }
 
 TEST(S21MapTest, EMPTY_1) {
@@ -276,3 +336,503 @@ TEST(S21MapTest, CONTAINS_3) {
 
   ASSERT_EQ(nums.contains(2), false);
 }
+
+TEST(S21MapTest, SYZE_3) {
+  map<int, int> nums;
+  for (int i = 0; i < 1000; ++i) {
+    nums.insert({(i * 37) % 1000, i});
+  }
+  ASSERT_EQ(nums.size(), 1000U);
+  for (int i = 0; i < 1000; i += 2) {
+    nums.erase(nums.nth(nums.rank(i)));
+  }
+  ASSERT_EQ(nums.size(), 500U);
+}
+
+TEST(S21MapTest, NTH_1) {
+  map<int, std::string> nums = {{5, "Five"}, {1, "One"}, {3, "Three"}};
+
+  ASSERT_EQ((*nums.nth(0)).first, 1);
+  ASSERT_EQ((*nums.nth(1)).second, "Three");
+  ASSERT_EQ((*nums.nth(2)).first, 5);
+  ASSERT_EQ(nums.nth(3), nums.end());
+}
+
+TEST(S21MapTest, RANK_1) {
+  map<int, std::string> nums = {{5, "Five"}, {1, "One"}, {3, "Three"}};
+
+  ASSERT_EQ(nums.rank(0), 0U);
+  ASSERT_EQ(nums.rank(3), 1U);
+  ASSERT_EQ(nums.rank(4), 2U);
+  ASSERT_EQ(nums.rank(10), 3U);
+}
+
+TEST(S21MapTest, COUNT_RANGE_1) {
+  map<int, int> nums;
+  for (int i = 0; i < 100; ++i) {
+    nums.insert({i * 2, i});
+  }
+
+  ASSERT_EQ(nums.count_range(0, 200), 100U);
+  ASSERT_EQ(nums.count_range(10, 20), 5U);
+  ASSERT_EQ(nums.count_range(11, 12), 0U);
+  ASSERT_EQ(nums.count_range(20, 10), 0U);
+}
+
+TEST(S21MapTest, ERASE_2) {
+  map<int, std::string> nums;
+  std::map<int, std::string> expected;
+  for (int i = 0; i < 200; ++i) {
+    int key = (i * 73) % 200;
+    nums.insert({key, std::to_string(key)});
+    expected[key] = std::to_string(key);
+  }
+  for (int i = 0; i < 200; i += 3) {
+    nums.erase(nums.nth(nums.rank(i)));
+    expected.erase(i);
+  }
+
+  ASSERT_EQ(nums.size(), expected.size());
+  auto it1 = nums.begin();
+  auto it2 = expected.begin();
+  while (it1 != nums.end() && it2 != expected.end()) {
+    ASSERT_EQ(*it1, *it2);
+    ++it1;
+    ++it2;
+  }
+  ASSERT_EQ(it1, nums.end());
+}
+
+TEST(S21MapTest, ITERATOR_STABILITY_1) {
+  map<int, std::string> nums;
+  auto pinned = nums.insert({500, "Five hundred"}).first;
+  for (int i = 0; i < 1000; ++i) {
+    nums.insert({i, std::to_string(i)});
+  }
+  ASSERT_EQ((*pinned).first, 500);
+  ASSERT_EQ((*pinned).second, "Five hundred");
+
+  for (int i = 0; i < 1000; ++i) {
+    if (i != 500) {
+      nums.erase(nums.nth(nums.rank(i)));
+    }
+  }
+  ASSERT_EQ(nums.size(), 1U);
+  ASSERT_EQ(nums.begin(), pinned);
+  ASSERT_EQ((*pinned).second, "Five hundred");
+}
+
+TEST(S21MapTest, CLEAR_2) {
+  map<int, std::string> nums;
+  for (int round = 0; round < 3; ++round) {
+    for (int i = 0; i < 100; ++i) {
+      nums.insert({i, std::string(32, 'a' + round)});
+    }
+    ASSERT_EQ(nums.size(), 100U);
+    ASSERT_EQ(nums.at(42), std::string(32, 'a' + round));
+    nums.clear();
+    ASSERT_EQ(nums.empty(), true);
+  }
+}
+
+TEST(S21MapTest, MOVE_ASSIGN_1) {
+  map<int, int> nums;
+  {
+    map<int, int> other;
+    for (int i = 0; i < 100; ++i) {
+      other.insert({i, i * i});
+    }
+    nums.insert({-1, 1});
+    nums = std::move(other);
+  }
+
+  ASSERT_EQ(nums.size(), 100U);
+  ASSERT_EQ(nums.at(9), 81);
+  ASSERT_EQ(nums.contains(-1), false);
+}
+
+TEST(S21MapTest, RANGE_CONSTRUCTOR_1) {
+  std::vector<std::pair<int, std::string>> sorted;
+  for (int i = 0; i < 1000; ++i) {
+    sorted.push_back({i * 2, std::to_string(i)});
+  }
+  map<int, std::string> nums(sorted.begin(), sorted.end());
+
+  ASSERT_EQ(nums.size(), 1000U);
+  int expected = 0;
+  for (auto it = nums.begin(); it != nums.end(); ++it, expected += 2) {
+    ASSERT_EQ((*it).first, expected);
+  }
+  ASSERT_EQ(nums.at(1998), "999");
+
+  nums.insert({1, "odd"});
+  nums.erase(nums.nth(0));
+  ASSERT_EQ((*nums.begin()).first, 1);
+  ASSERT_EQ(nums.size(), 1000U);
+}
+
+TEST(S21MapTest, RANGE_CONSTRUCTOR_2) {
+  std::vector<std::pair<int, std::string>> unsorted = {
+      {3, "Three"}, {1, "One"}, {2, "Two"}, {1, "Uno"}};
+  map<int, std::string> nums(unsorted.begin(), unsorted.end());
+
+  ASSERT_EQ(nums.size(), 3U);
+  ASSERT_EQ(nums.at(1), "One");
+  ASSERT_EQ((*nums.nth(2)).second, "Three");
+}
+
+TEST(S21MapTest, SET_UNION_1) {
+  map<int, std::string> nums{{1, "One"}, {3, "Three"}};
+  map<int, std::string> other{{2, "Two"}, {3, "Drei"}};
+  nums.set_union(other);
+
+  ASSERT_EQ(other.empty(), true);
+  ASSERT_EQ(nums.size(), 3U);
+  ASSERT_EQ(nums.at(2), "Two");
+  ASSERT_EQ(nums.at(3), "Three");
+}
+
+TEST(S21MapTest, SET_INTERSECTION_PARALLEL_1) {
+  ThreadPool workers(4);
+  map<int, int> nums, other;
+  for (int i = 0; i < 80000; ++i) {
+    nums.insert({i, i});
+    other.insert({i * 2, -i});
+  }
+  nums.set_intersection(other, workers);
+
+  ASSERT_EQ(nums.size(), 40000U);
+  ASSERT_EQ(nums.at(10), 10);
+  ASSERT_EQ(nums.contains(11), false);
+}
+
+TEST(S21MapTest, INSERT_HINT_1) {
+  map<int, int> nums;
+  for (int i = 0; i < 1000; ++i) {
+    nums.insert(nums.end(), {i, i * 2});
+  }
+  auto last = nums.find(999);
+  for (int i = 1000; i < 2000; ++i) {
+    last = nums.insert(last, {i, i * 2});
+  }
+  ASSERT_EQ(nums.size(), 2000U);
+  int expected = 0;
+  for (auto item : nums) {
+    ASSERT_EQ(item.first, expected);
+    ASSERT_EQ(item.second, expected * 2);
+    ++expected;
+  }
+  ASSERT_EQ((*nums.begin()).first, 0);
+  ASSERT_EQ((*--nums.end()).first, 1999);
+
+  auto present = nums.insert(nums.begin(), {500, 0});
+  ASSERT_EQ((*present).second, 1000);
+  auto wrong_hint = nums.emplace_hint(nums.begin(), -1, 7);
+  ASSERT_EQ((*wrong_hint).first, -1);
+  ASSERT_EQ((*nums.begin()).second, 7);
+  nums.insert(nums.find(10), {5000, 1});
+  ASSERT_EQ((*--nums.end()).first, 5000);
+  ASSERT_EQ(nums.rank(5000), 2001U);
+}
+
+namespace {
+struct Counted {
+  static int constructed;
+  static int copied;
+  int value;
+  explicit Counted(int v = 0) : value(v) { ++constructed; }
+  Counted(const Counted &other) : value(other.value) { ++copied; }
+  Counted(Counted &&other) noexcept : value(other.value) {}
+  Counted &operator=(const Counted &other) {
+    value = other.value;
+    ++copied;
+    return *this;
+  }
+  Counted &operator=(Counted &&other) noexcept {
+    value = other.value;
+    return *this;
+  }
+};
+int Counted::constructed = 0;
+int Counted::copied = 0;
+}  // namespace
+
+TEST(S21MapTest, EMPLACE_1) {
+  map<std::string, Counted> items;
+  Counted::constructed = Counted::copied = 0;
+  auto result = items.try_emplace("a", 1);
+  ASSERT_TRUE(result.second);
+  ASSERT_FALSE(items.try_emplace("a", 2).second);
+  ASSERT_EQ(Counted::constructed, 1);
+  ASSERT_EQ(items.at("a").value, 1);
+
+  ASSERT_TRUE(items.emplace("b", Counted(3)).second);
+  ASSERT_FALSE(items.emplace(std::string("b"), Counted(4)).second);
+  ASSERT_TRUE(items.insert({"c", Counted(5)}).second);
+  ASSERT_FALSE(items.insert_or_assign("c", Counted(6)).second);
+  ASSERT_EQ(items.at("c").value, 6);
+  items["d"].value = 7;
+  ASSERT_EQ(Counted::copied, 0);
+
+  std::string key = "e";
+  items.try_emplace(std::move(key), 8);
+  ASSERT_EQ(items.at("e").value, 8);
+  items.emplace_hint(items.end(), "f", Counted(9));
+  ASSERT_EQ(items.at("f").value, 9);
+  ASSERT_EQ(items.size(), 6U);
+  ASSERT_EQ(Counted::copied, 0);
+}
+
+TEST(S21MapTest, ITERATOR_REFERENCE_1) {
+  map<std::string, Counted> items;
+  items.try_emplace("a", 1);
+  items.try_emplace("b", 2);
+  items.try_emplace("c", 3);
+  Counted::copied = 0;
+  for (auto &[key, item] : items) {
+    item.value *= 10;
+  }
+  for (const auto &entry : items) {
+    ASSERT_EQ(entry.second.value % 10, 0);
+  }
+  ASSERT_EQ(Counted::copied, 0);
+
+  auto iter = items.find("b");
+  ASSERT_EQ(iter->first, "b");
+  iter->second.value = 25;
+  ASSERT_EQ(&(*iter).second, &items.at("b"));
+  ASSERT_EQ(items.at("b").value, 25);
+
+  map<std::string, Counted>::const_iterator citer(items.begin().current);
+  ASSERT_EQ(citer->second.value, 10);
+  ASSERT_EQ(&*citer, &*items.begin());
+}
+
+TEST(S21MapTest, NODE_HANDLE_1) {
+  map<int, std::string> source{{1, "one"}, {2, "two"}, {3, "three"}};
+  map<int, std::string> target{{3, "drei"}};
+  const std::string *two = &source.at(2);
+
+  auto node = source.extract(2);
+  ASSERT_FALSE(node.empty());
+  ASSERT_EQ(node.key(), 2);
+  ASSERT_EQ(&node.mapped(), two);
+  ASSERT_EQ(source.size(), 2U);
+  ASSERT_TRUE(source.extract(5).empty());
+
+  auto result = target.insert(std::move(node));
+  ASSERT_TRUE(result.inserted);
+  ASSERT_TRUE(result.node.empty());
+  ASSERT_EQ(result.position->first, 2);
+  ASSERT_EQ(target.at(2), "two");
+  ASSERT_EQ(&target.at(2), two);
+
+  result = target.insert(source.extract(source.find(3)));
+  ASSERT_FALSE(result.inserted);
+  ASSERT_EQ(result.position->second, "drei");
+  ASSERT_EQ(result.node.mapped(), "three");
+  ASSERT_FALSE(target.insert(map<int, std::string>::node_type()).inserted);
+
+  // Back into the map it came from the node is relinked as well
+  const std::string *one = &source.at(1);
+  ASSERT_TRUE(source.insert(source.extract(1)).inserted);
+  ASSERT_EQ(&source.at(1), one);
+}
+
+TEST(S21MapTest, NODE_HANDLE_THREADS_1) {
+  // Maps that exchanged elements keep separate pools and can be changed
+  // from different threads
+  map<int, int> first{{1, 1}, {2, 2}};
+  map<int, int> second{{3, 3}};
+  second.insert(first.extract(1));
+  first.insert(second.extract(3));
+  second.merge(first);
+
+  std::thread writer([&first] {
+    for (int i = 100; i < 20000; ++i) {
+      first.insert({i, i});
+      first.erase(i - 50);
+    }
+  });
+  for (int i = 100; i < 20000; ++i) {
+    second.insert({i, -i});
+    second.erase(i - 50);
+  }
+  writer.join();
+  ASSERT_EQ(first.size(), 50U);
+  ASSERT_EQ(second.size(), 53U);
+  ASSERT_EQ(second.at(3), 3);
+  ASSERT_EQ(second.at(19999), -19999);
+}
+
+TEST(S21MapTest, CONST_ITERATE_1) {
+  map<int, char> letters{{2, 'b'}, {1, 'a'}, {3, 'c'}};
+  const map<int, char> &view = letters;
+  ASSERT_EQ(view.size(), 3U);
+  std::string joined;
+  for (const auto &item : view) {
+    joined += item.second;
+  }
+  ASSERT_EQ(joined, "abc");
+  ASSERT_EQ((*view.begin()).first, 1);
+  ASSERT_TRUE(view.begin() != view.end());
+}
+
+TEST(S21MapTest, MERGE_SPLICE_1) {
+  map<int, std::string> first{{1, "a"}, {3, "c"}, {5, "e"}};
+  map<int, std::string> second{{2, "b"}, {3, "x"}, {6, "f"}};
+  const std::string *six = &second.at(6);
+
+  first.merge(second);
+  ASSERT_EQ(&first.at(6), six);
+  ASSERT_EQ(first.size(), 5U);
+  ASSERT_EQ(first.at(3), "c");
+  ASSERT_EQ(first.at(6), "f");
+  ASSERT_EQ(second.size(), 1U);
+  ASSERT_EQ(second.at(3), "x");
+
+  auto iter = first.find(5);
+  first.swap(second);
+  ASSERT_EQ(second.size(), 5U);
+  ASSERT_EQ(first.size(), 1U);
+  ASSERT_EQ(iter->second, "e");
+  ASSERT_EQ(++iter, second.find(6));
+  ASSERT_EQ(first.begin()->second, "x");
+  second.erase(2);
+  first.insert({4, "d"});
+  ASSERT_EQ(first.size(), 2U);
+  ASSERT_EQ(second.size(), 4U);
+
+  // The nodes outlive the map they were allocated in
+  {
+    map<int, std::string> donor{{7, "g"}, {8, "h"}};
+    second.merge(donor);
+  }
+  ASSERT_EQ(second.at(7), "g");
+  second.erase(8);
+  second.insert({9, "i"});
+  ASSERT_EQ(second.size(), 6U);
+}
+
+TEST(S21MapTest, BOUNDS_1) {
+  map<int, char> events{{10, 'a'}, {20, 'b'}, {30, 'c'}, {40, 'd'}};
+  ASSERT_EQ(events.lower_bound(20)->second, 'b');
+  ASSERT_EQ(events.lower_bound(21)->second, 'c');
+  ASSERT_EQ(events.upper_bound(20)->second, 'c');
+  ASSERT_EQ(events.lower_bound(5), events.begin());
+  ASSERT_EQ(events.upper_bound(40), events.end());
+
+  auto range = events.equal_range(30);
+  ASSERT_EQ(range.first->first, 30);
+  ASSERT_EQ(range.second->first, 40);
+  range = events.equal_range(35);
+  ASSERT_EQ(range.first, range.second);
+}
+
+TEST(S21MapTest, ERASE_RANGE_1) {
+  map<int, int> numbers;
+  for (int i = 0; i < 100; ++i) {
+    numbers.insert(i, i * i);
+  }
+  auto next = numbers.erase(numbers.find(50));
+  ASSERT_EQ(next->first, 51);
+  ASSERT_EQ(numbers.size(), 99U);
+
+  next = numbers.erase(numbers.lower_bound(20), numbers.lower_bound(60));
+  ASSERT_EQ(next->first, 60);
+  ASSERT_EQ(numbers.size(), 60U);
+  ASSERT_EQ(std::prev(next)->first, 19);
+  ASSERT_EQ(numbers.nth(20)->first, 60);
+
+  next = numbers.erase(numbers.lower_bound(90), numbers.end());
+  ASSERT_EQ(next, numbers.end());
+  ASSERT_EQ(std::prev(numbers.end())->first, 89);
+  numbers.erase(numbers.begin(), numbers.end());
+  ASSERT_TRUE(numbers.empty());
+}
+
+TEST(S21MapTest, FOR_EACH_IN_RANGE_1) {
+  map<int, int> numbers;
+  for (int i = 0; i < 50; ++i) {
+    numbers.insert(i * 2, 0);
+  }
+  std::vector<int> seen;
+  numbers.for_each_in_range(11, 21, [&](int key, int &value) {
+    seen.push_back(key);
+    value = 1;
+  });
+  ASSERT_EQ(seen, (std::vector<int>{12, 14, 16, 18, 20}));
+  ASSERT_EQ(numbers.at(20), 1);
+  ASSERT_EQ(numbers.at(22), 0);
+
+  int visited = 0;
+  numbers.for_each_in_range(0, 100, [&](int, int) { return ++visited < 3; });
+  ASSERT_EQ(visited, 3);
+}
+
+TEST(S21MapTest, COPY_2) {
+  map<int, int> numbers;
+  for (int i = 0; i < 100; ++i) {
+    numbers.insert(i, i);
+  }
+  map<int, int> copy(numbers);
+  ASSERT_EQ(copy.size(), 100U);
+  ASSERT_EQ(copy.nth(42)->first, 42);
+  ASSERT_EQ(copy.rank(77), 77U);
+}
+
+TEST(S21MapTest, FIND_MANY_1) {
+  map<std::string, int> words{{"alpha", 1}, {"beta", 2}, {"gamma", 3}};
+  std::vector<std::string> keys{"gamma", "delta", "alpha", "alpha", ""};
+  std::vector<map<std::string, int>::iterator> found;
+  words.find_many(keys, found);
+  ASSERT_EQ(found[0]->second, 3);
+  ASSERT_EQ(found[1], words.end());
+  ASSERT_EQ(found[2]->second, 1);
+  ASSERT_EQ(found[3], found[2]);
+  ASSERT_EQ(found[4], words.end());
+
+  std::vector<bool> present;
+  words.contains_many(keys, present);
+  ASSERT_EQ(present, (std::vector<bool>{true, false, true, true, false}));
+}
+
+TEST(S21MapTest, STATS_1) {
+  map<int, int, std::less<int>, TreeCountStats> counted;
+  for (int i = 0; i < 1000; ++i) {
+    counted[i] = i;
+  }
+  auto stats = counted.stats();
+  ASSERT_TRUE(stats.counted);
+  ASSERT_EQ(stats.nodes, 1000U);
+  ASSERT_GE(stats.height, 10U);
+  ASSERT_LE(stats.height, stats.heightBound);
+  ASSERT_EQ(stats.heightBound, 14U);
+  ASSERT_GT(stats.rotations, 0U);
+  ASSERT_GT(stats.comparisons, 1000U);
+  ASSERT_GE(stats.bytesAllocated, 1000U * sizeof(std::pair<int, int>));
+  size_t leaves = 0;
+  for (size_t depth = 0; depth < stats.leafDepths.size(); ++depth) {
+    leaves += stats.leafDepths[depth];
+  }
+  ASSERT_EQ(stats.leafDepths.size(), stats.height);
+  ASSERT_GT(leaves, 250U);
+
+  counted.reset_stats();
+  ASSERT_EQ(counted.stats().comparisons, 0U);
+  ASSERT_TRUE(counted.contains(500));
+  stats = counted.stats();
+  ASSERT_EQ(stats.rotations, 0U);
+  ASSERT_GT(stats.comparisons, 0U);
+  ASSERT_LE(stats.comparisons, 2 * stats.height);
+
+  map<int, int> plain{{1, 1}};
+  stats = plain.stats();
+  ASSERT_FALSE(stats.counted);
+  ASSERT_EQ(stats.nodes, 1U);
+  ASSERT_EQ(stats.height, 1U);
+  ASSERT_EQ(stats.leafDepths, (std::vector<size_t>{1}));
+  ASSERT_EQ(stats.comparisons, 0U);
+  map<int, int> empty;
+  ASSERT_EQ(empty.stats().bytesAllocated, 0U);
+}
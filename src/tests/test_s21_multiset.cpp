@@ -1,6 +1,10 @@
 #include <gtest/gtest.h>
 
 #include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
 
 #include "../containersplus/s21_multiset.h"
 
@@ -55,7 +59,9 @@ TEST(S21MultisetTest, END_1) {
   multiset<int> nums{5, 3, 2, 7, 6, 8, 5, 3, 2, 7, 6, 8};
   auto it = nums.end();
 
-  ASSERT_EQ(it, nullptr);
+  ASSERT_EQ(*(--it), 8);
+  ASSERT_EQ(*(--it), 8);
+  ASSERT_EQ(*(--it), 7);
 }
 
 TEST(S21MultisetTest, EMPTY_1) {
@@ -152,7 +158,9 @@ TEST(S21MultisetTest, MERGE_1) {
   multiset<int> numbers_2{1, 1, 9, 7, 15};
   numbers_1.merge(numbers_2);
 
-  std::multiset<int> expected{1, 2, 4, 6, 7, 9, 10, 12, 15};
+  std::multiset<int> expected{1, 1, 2, 4, 6, 7, 9, 10, 12, 15};
+  ASSERT_EQ(numbers_1.size(), expected.size());
+  ASSERT_TRUE(numbers_2.empty());
 
   auto it1 = numbers_1.begin();
   auto it2 = expected.begin();
@@ -178,6 +186,8 @@ TEST(S21MultisetTest, MERGE_3) {
   letters_1.merge(letters_2);
 
   std::multiset<char> expected{'a', 'i', 'e', 'q', 'g', 'd', 'o'};
+  ASSERT_EQ(letters_1.size(), expected.size());
+  ASSERT_TRUE(letters_2.empty());
 
   auto it1 = letters_1.begin();
   auto it2 = expected.begin();
@@ -350,8 +360,267 @@ TEST(S21MultisetTest, EQUAL_RANGE_1) {
   ASSERT_EQ(*range_expected.second, 7);
 }
 
+TEST(S21MultisetTest, COUNT_4) {
+  multiset<int> nums;
+  for (int i = 0; i < 300; ++i) {
+    nums.insert(i % 10);
+  }
+
+  ASSERT_EQ(nums.size(), 300U);
+  ASSERT_EQ(nums.count(0), 30U);
+  ASSERT_EQ(nums.count(9), 30U);
+  ASSERT_EQ(nums.count(10), 0U);
+}
+
+TEST(S21MultisetTest, NTH_1) {
+  multiset<int> nums{5, 3, 3, 7, 1};
+
+  ASSERT_EQ(*nums.nth(0), 1);
+  ASSERT_EQ(*nums.nth(1), 3);
+  ASSERT_EQ(*nums.nth(2), 3);
+  ASSERT_EQ(*nums.nth(4), 7);
+  ASSERT_EQ(nums.rank(3), 1U);
+  ASSERT_EQ(nums.rank(5), 3U);
+  ASSERT_EQ(nums.count_range(3, 7), 3U);
+}
+
+TEST(S21MultisetTest, RANGE_CONSTRUCTOR_1) {
+  std::vector<int> sorted{1, 1, 2, 3, 3, 3, 4, 5, 5};
+  multiset<int> nums(sorted.begin(), sorted.end());
+
+  ASSERT_EQ(nums.size(), sorted.size());
+  ASSERT_EQ(nums.count(3), 3U);
+  nums.insert(3);
+  ASSERT_EQ(nums.count(3), 4U);
+
+  auto it = nums.begin();
+  for (int expected : {1, 1, 2, 3, 3, 3, 3, 4, 5, 5}) {
+    ASSERT_EQ(*it, expected);
+    ++it;
+  }
+}
+
+TEST(S21MultisetTest, SET_ALGEBRA_1) {
+  std::vector<int> a, b;
+  for (int i = 0; i < 600; ++i) {
+    a.push_back((i * 7) % 50);
+    b.push_back((i * 11) % 80);
+  }
+  std::multiset<int> std_a(a.begin(), a.end());
+  std::multiset<int> std_b(b.begin(), b.end());
+
+  std::vector<int> expected_union, expected_intersection, expected_difference,
+      expected_symmetric;
+  std::set_union(std_a.begin(), std_a.end(), std_b.begin(), std_b.end(),
+                 std::back_inserter(expected_union));
+  std::set_intersection(std_a.begin(), std_a.end(), std_b.begin(),
+                        std_b.end(), std::back_inserter(expected_intersection));
+  std::set_difference(std_a.begin(), std_a.end(), std_b.begin(), std_b.end(),
+                      std::back_inserter(expected_difference));
+  std::set_symmetric_difference(std_a.begin(), std_a.end(), std_b.begin(),
+                                std_b.end(),
+                                std::back_inserter(expected_symmetric));
+
+  multiset<int> nums_union(a.begin(), a.end()), other_union(b.begin(), b.end());
+  multiset<int> nums_intersection(a.begin(), a.end()),
+      other_intersection(b.begin(), b.end());
+  multiset<int> nums_difference(a.begin(), a.end()),
+      other_difference(b.begin(), b.end());
+  multiset<int> nums_symmetric(a.begin(), a.end()),
+      other_symmetric(b.begin(), b.end());
+  nums_union.set_union(other_union);
+  nums_intersection.set_intersection(other_intersection);
+  nums_difference.set_difference(other_difference);
+  nums_symmetric.set_symmetric_difference(other_symmetric);
+
+  ASSERT_EQ(other_union.size(), 0U);
+  ASSERT_EQ(other_symmetric.size(), 0U);
+  ASSERT_EQ(nums_union.size(), expected_union.size());
+  ASSERT_EQ(nums_intersection.size(), expected_intersection.size());
+  ASSERT_EQ(nums_difference.size(), expected_difference.size());
+  ASSERT_EQ(nums_symmetric.size(), expected_symmetric.size());
+  for (size_t k = 0; k < expected_union.size(); ++k) {
+    ASSERT_EQ(*nums_union.nth(k), expected_union[k]);
+  }
+  for (size_t k = 0; k < expected_intersection.size(); ++k) {
+    ASSERT_EQ(*nums_intersection.nth(k), expected_intersection[k]);
+  }
+  for (size_t k = 0; k < expected_difference.size(); ++k) {
+    ASSERT_EQ(*nums_difference.nth(k), expected_difference[k]);
+  }
+  auto it = nums_symmetric.begin();
+  for (size_t k = 0; k < expected_symmetric.size(); ++k, ++it) {
+    ASSERT_EQ(*it, expected_symmetric[k]);
+  }
+}
+
+TEST(S21MultisetTest, TRANSPARENT_LOOKUP_1) {
+  multiset<std::string, std::less<>> words{"b", "a", "b", "c", "b"};
+  std::string_view b = "b";
+
+  ASSERT_EQ(words.count(b), 3U);
+  ASSERT_TRUE(words.contains("c"));
+  ASSERT_EQ(*words.lower_bound(b), "b");
+  ASSERT_EQ(*words.upper_bound(b), "c");
+  auto range = words.equal_range("b");
+  ASSERT_EQ(words.rank(b), 1U);
+  std::size_t in_range = 0;
+  for (auto it = range.first; it != range.second; ++it) {
+    ++in_range;
+  }
+  ASSERT_EQ(in_range, 3U);
+  ASSERT_EQ(words.erase(b), 3U);
+  ASSERT_EQ(words.size(), 2U);
+  ASSERT_TRUE(words.upper_bound("c") == words.end());
+}
+
+TEST(S21MultisetTest, TRANSPARENT_ERASE_ITERATOR_1) {
+  using Multiset = multiset<std::string, std::less<>>;
+  static_assert(std::is_same_v<decltype(std::declval<Multiset &>().erase(
+                                   std::declval<Multiset::const_iterator>())),
+                               Multiset::iterator>);
+  Multiset words{"b", "a", "b"};
+  ASSERT_EQ(*words.erase(words.find("a")), "b");
+  auto next = words.erase(words.begin());
+  ASSERT_EQ(words.size(), 1U);
+  ASSERT_EQ(next, words.find("b"));
+  ASSERT_EQ(words.erase("b"), 1U);
+  ASSERT_TRUE(words.empty());
+}
+
+TEST(S21MultisetTest, INSERT_HINT_1) {
+  struct ByFirst {
+    bool operator()(const std::pair<int, int>& a,
+                    const std::pair<int, int>& b) const {
+      return a.first < b.first;
+    }
+  };
+  multiset<std::pair<int, int>, ByFirst> items;
+  for (int i = 0; i < 300; ++i) {
+    items.insert(items.end(), {i / 3, i});
+  }
+  // Equal keys land right before the hint
+  auto pos = items.insert(items.lower_bound({50, 0}), {50, -1});
+  ASSERT_EQ((*pos).second, -1);
+  ASSERT_EQ((*++pos).second, 150);
+  items.insert(items.end(), {0, -2});
+  ASSERT_EQ((*items.nth(3)).second, -2);
+  ASSERT_EQ((*items.begin()).second, 0);
+  ASSERT_EQ((*items.rbegin()).second, 299);
+  ASSERT_EQ(items.size(), 302U);
+  int previous = -1;
+  for (auto item : items) {
+    ASSERT_LE(previous, item.first);
+    previous = item.first;
+  }
+}
+
+TEST(S21MultisetTest, EMPLACE_1) {
+  multiset<std::string> words;
+  words.emplace(2, 'b');
+  words.emplace("bb");
+  std::string word = "a";
+  words.insert(std::move(word));
+  ASSERT_EQ(words.count("bb"), 2U);
+  ASSERT_EQ(*words.begin(), "a");
+  ASSERT_EQ(words.size(), 3U);
+}
+
 // TEST(S21MultisetTest, INSERT_MANY_1) {
 //   multiset<int> nums;
 //   nums.insert(1, 2, 3);
 //   nums.print();
 // }
+
+TEST(S21MultisetTest, NODE_HANDLE_1) {
+  multiset<int> source{1, 2, 2, 3};
+  multiset<int> target{2};
+
+  auto node = source.extract(2);
+  ASSERT_EQ(node.value(), 2);
+  ASSERT_EQ(source.count(2), 1U);
+  ASSERT_TRUE(source.extract(7).empty());
+  auto iter = target.insert(std::move(node));
+  ASSERT_EQ(*iter, 2);
+  ASSERT_EQ(target.count(2), 2U);
+  ASSERT_EQ(++iter, target.end());
+
+  target.insert(source.extract(source.begin()));
+  ASSERT_EQ(*target.begin(), 1);
+  ASSERT_EQ(source.size(), 2U);
+}
+
+TEST(S21MultisetTest, MERGE_SPLICE_1) {
+  multiset<int> first{1, 2, 2};
+  multiset<int> second{2, 3, 3};
+  const int *three = &*second.find(3);
+  first.merge(second);
+  std::multiset<int> expected{1, 2, 2, 2, 3, 3};
+  ASSERT_EQ(first.size(), expected.size());
+  ASSERT_TRUE(std::equal(first.begin(), first.end(), expected.begin()));
+  ASSERT_TRUE(second.empty());
+  ASSERT_EQ(second.begin(), second.end());
+  ASSERT_EQ(&*first.find(3), three);
+  ASSERT_EQ(first.count(2), 3U);
+
+  first.swap(second);
+  ASSERT_TRUE(first.empty());
+  ASSERT_EQ(second.size(), 6U);
+  ASSERT_EQ(*second.begin(), 1);
+}
+
+TEST(S21MultisetTest, ERASE_RANGE_1) {
+  multiset<int> numbers{1, 2, 2, 2, 3, 3, 4};
+  auto middle = std::next(numbers.lower_bound(2));
+  auto next = numbers.erase(middle);
+  ASSERT_EQ(*next, 2);
+  ASSERT_EQ(numbers.count(2), 2U);
+
+  ASSERT_EQ(numbers.erase(3), 2U);
+  ASSERT_EQ(numbers.size(), 4U);
+  next = numbers.erase(numbers.begin(), numbers.upper_bound(2));
+  ASSERT_EQ(*next, 4);
+  ASSERT_EQ(numbers.size(), 1U);
+
+  int total = 0;
+  multiset<int> more{1, 2, 2, 5};
+  more.for_each_in_range(2, 5, [&](int value) { total += value; });
+  ASSERT_EQ(total, 4);
+}
+
+TEST(S21MultisetTest, STATS_1) {
+  multiset<int, std::less<int>, TreeCountStats> counted;
+  for (int i = 1; i <= 7; ++i) {
+    counted.insert(i);
+  }
+  auto stats = counted.stats();
+  ASSERT_TRUE(stats.counted);
+  ASSERT_EQ(stats.nodes, 7U);
+  ASSERT_EQ(stats.height, 3U);
+  ASSERT_EQ(stats.leafDepths, (std::vector<size_t>{0, 0, 4}));
+  ASSERT_EQ(stats.rotations, 4U);
+  ASSERT_GT(stats.comparisons, 0U);
+  ASSERT_GT(stats.bytesAllocated, 0U);
+
+  counted.reset_stats();
+  counted.insert(4);
+  counted.insert(4);
+  stats = counted.stats();
+  ASSERT_EQ(stats.nodes, 9U);
+  ASSERT_EQ(counted.count(4), 3U);
+  ASSERT_LE(stats.height, stats.heightBound);
+  ASSERT_GT(stats.comparisons, 0U);
+  size_t leaves = 0;
+  for (size_t depth = 0; depth < stats.leafDepths.size(); ++depth) {
+    leaves += stats.leafDepths[depth];
+  }
+  ASSERT_GE(leaves, 4U);
+  ASSERT_EQ(stats.leafDepths.size(), stats.height);
+
+  multiset<int> plain{3, 3, 1};
+  stats = plain.stats();
+  ASSERT_FALSE(stats.counted);
+  ASSERT_EQ(stats.rotations, 0U);
+  ASSERT_EQ(stats.comparisons, 0U);
+  ASSERT_EQ(stats.nodes, 3U);
+}
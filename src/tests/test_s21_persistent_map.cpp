@@ -0,0 +1,221 @@
+#include <gtest/gtest.h>
+
+#include <functional>
+#include <iterator>
+#include <map>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "../containersplus/s21_persistent_map.h"
+#include "test_random.h"
+
+using namespace s21;
+
+TEST(S21PersistentMapTest, INSERT_1) {
+  persistent_map<int, std::string> empty;
+  auto one = empty.insert(2, "two");
+  auto two = one.insert({1, "one"});
+  auto same = two.insert(1, "uno");
+  ASSERT_TRUE(empty.empty());
+  ASSERT_EQ(one.size(), 1U);
+  ASSERT_EQ(two.size(), 2U);
+  ASSERT_EQ(same.at(1), "one");
+  ASSERT_EQ(two.insert_or_assign(1, "uno").at(1), "uno");
+  ASSERT_EQ(two.at(1), "one");
+  ASSERT_THROW(one.at(1), std::out_of_range);
+}
+
+TEST(S21PersistentMapTest, VERSIONS_1) {
+  std::vector<persistent_map<int, int>> versions{persistent_map<int, int>()};
+  std::vector<std::map<int, int>> expected{std::map<int, int>()};
+  TestRandom random(11);
+  for (int i = 0; i < 600; ++i) {
+    unsigned state = random.next();
+    int key = (state >> 8) % 200;
+    persistent_map<int, int> next = versions.back().snapshot();
+    std::map<int, int> model = expected.back();
+    if ((state >> 20) % 3 == 0) {
+      next = next.erase(key);
+      model.erase(key);
+    } else {
+      next = next.insert_or_assign(key, i);
+      model[key] = i;
+    }
+    versions.push_back(next);
+    expected.push_back(model);
+  }
+  for (size_t v = 0; v < versions.size(); ++v) {
+    ASSERT_EQ(versions[v].size(), expected[v].size());
+    auto iter = versions[v].begin();
+    for (const auto &item : expected[v]) {
+      ASSERT_EQ((*iter).first, item.first);
+      ASSERT_EQ((*iter).second, item.second);
+      ++iter;
+    }
+    ASSERT_TRUE(iter == versions[v].end());
+  }
+}
+
+TEST(S21PersistentMapTest, ITERATOR_1) {
+  persistent_map<int, char> letters{{3, 'c'}, {1, 'a'}, {2, 'b'}, {1, 'z'}};
+  ASSERT_EQ(letters.size(), 3U);
+  ASSERT_EQ(letters.at(1), 'a');
+  auto iter = letters.find(2);
+  ASSERT_EQ((*iter).second, 'b');
+  ASSERT_EQ((*--iter).first, 1);
+  ASSERT_EQ((*letters.rbegin()).first, 3);
+  ASSERT_TRUE(letters.find(4) == letters.end());
+  auto older = letters;
+  letters = letters.erase(2);
+  ASSERT_EQ((*++older.find(1)).first, 2);
+  ASSERT_EQ((*++letters.find(1)).first, 3);
+  ASSERT_EQ(letters.erase(7).size(), 2U);
+}
+
+TEST(S21PersistentMapTest, ITERATOR_REFERENCE_1) {
+  persistent_map<int, std::string> words;
+  for (int i = 0; i < 1000; ++i) {
+    words = words.insert(i, std::to_string(i));
+  }
+  auto iter = words.find(500);
+  const std::string *five_hundred = &iter->second;
+  auto newer = words.insert(1000, "1000").erase(0);
+  ASSERT_EQ(&words.find(500)->second, five_hundred);
+  ASSERT_EQ(&newer.find(500)->second, five_hundred);
+  ASSERT_EQ(&(*iter).second, five_hundred);
+
+  int expected = 1000;
+  for (auto rev = newer.rbegin(); rev != newer.rend(); ++rev, --expected) {
+    ASSERT_EQ(rev->first, expected);
+    ASSERT_EQ(rev->second, std::to_string(expected));
+  }
+  ASSERT_EQ(expected, 0);
+  auto copy = iter++;
+  ASSERT_EQ(copy->first, 500);
+  ASSERT_EQ(iter->first, 501);
+}
+
+TEST(S21PersistentMapTest, TRANSPARENT_LOOKUP_1) {
+  persistent_map<std::string, int, std::less<>> nums{{"one", 1}, {"two", 2}};
+  ASSERT_EQ(nums.at("two"), 2);
+  ASSERT_TRUE(nums.contains("one"));
+  ASSERT_EQ(nums.count("three"), 0U);
+  ASSERT_EQ(nums.erase("one").size(), 1U);
+  ASSERT_EQ(nums.size(), 2U);
+}
+
+TEST(S21PersistentMapTest, EMPTY_1) {
+  persistent_map<int, int> empty;
+  ASSERT_TRUE(empty.empty());
+  ASSERT_EQ(empty.size(), 0U);
+  ASSERT_GT(empty.max_size(), 0U);
+  ASSERT_TRUE(empty.begin() == empty.end());
+  ASSERT_TRUE(empty.rbegin() == empty.rend());
+  ASSERT_TRUE(empty.find(0) == empty.end());
+  ASSERT_FALSE(empty.contains(0));
+  ASSERT_EQ(empty.count(0), 0U);
+  ASSERT_THROW(empty.at(0), std::out_of_range);
+  ASSERT_TRUE(empty.erase(0).empty());
+  ASSERT_TRUE(empty.snapshot().empty());
+}
+
+TEST(S21PersistentMapTest, ERASE_LAST_1) {
+  persistent_map<int, int> one{{1, 10}};
+  auto none = one.erase(1);
+  ASSERT_TRUE(none.empty());
+  ASSERT_TRUE(none.begin() == none.end());
+  ASSERT_EQ(one.at(1), 10);
+  ASSERT_EQ(none.insert(1, 20).at(1), 20);
+
+  persistent_map<int, int> nums{{1, 1}, {2, 2}, {3, 3}, {4, 4}};
+  auto shorter = nums.erase(4);
+  ASSERT_EQ((*shorter.rbegin()).first, 3);
+  ASSERT_EQ((*std::prev(shorter.end())).first, 3);
+  ASSERT_EQ((*nums.rbegin()).first, 4);
+  auto last = nums.find(4);
+  ASSERT_TRUE(++last == nums.end());
+}
+
+TEST(S21PersistentMapTest, RANGE_CONSTRUCT_1) {
+  std::vector<std::pair<int, std::string>> items{
+      {5, "five"}, {1, "one"}, {5, "cinq"}, {3, "three"}, {1, "un"}};
+  persistent_map<int, std::string> words(items.begin(), items.end());
+  ASSERT_EQ(words.size(), 3U);
+  ASSERT_EQ(words.at(5), "five");
+  ASSERT_EQ(words.at(1), "one");
+
+  std::map<int, std::string> source{{2, "two"}, {4, "four"}};
+  persistent_map<int, std::string> copied(source.begin(), source.end());
+  ASSERT_EQ((*copied.begin()).second, "two");
+
+  std::vector<std::pair<int, std::string>> none;
+  persistent_map<int, std::string> empty(none.begin(), none.end());
+  ASSERT_TRUE(empty.empty());
+}
+
+TEST(S21PersistentMapTest, CUSTOM_COMPARE_1) {
+  persistent_map<int, int, std::greater<int>> nums;
+  for (int key = 1; key <= 10; ++key) {
+    nums = nums.insert(key, key * 10);
+  }
+  ASSERT_EQ((*nums.begin()).first, 10);
+  ASSERT_EQ((*nums.rbegin()).first, 1);
+  auto iter = nums.find(5);
+  ASSERT_EQ((*++iter).first, 4);
+  ASSERT_EQ(nums.erase(10).begin()->first, 9);
+  ASSERT_TRUE(nums.key_comp()(2, 1));
+}
+
+TEST(S21PersistentMapTest, TRANSPARENT_FIND_1) {
+  persistent_map<std::string, int, std::less<>> nums{
+      {"one", 1}, {"two", 2}, {"three", 3}};
+  std::string_view two = "two";
+  auto iter = nums.find(two);
+  ASSERT_EQ(iter->second, 2);
+  ASSERT_TRUE(++iter == nums.end());
+  ASSERT_TRUE(nums.find(std::string_view("four")) == nums.end());
+  ASSERT_EQ(nums.count(two), 1U);
+  ASSERT_THROW(nums.at(std::string_view("zero")), std::out_of_range);
+  auto fewer = nums.erase(two);
+  ASSERT_FALSE(fewer.contains(two));
+  ASSERT_TRUE(nums.contains(two));
+}
+
+TEST(S21PersistentMapTest, SWAP_1) {
+  persistent_map<int, int> first{{1, 1}};
+  persistent_map<int, int> second{{2, 2}, {3, 3}};
+  auto iter = second.find(3);
+  first.swap(second);
+  ASSERT_EQ(first.size(), 2U);
+  ASSERT_EQ(second.at(1), 1);
+  ASSERT_EQ(iter->second, 3);
+  ASSERT_TRUE(first.find(2) != first.end());
+
+  persistent_map<int, int> moved(std::move(first));
+  ASSERT_EQ(moved.size(), 2U);
+  second = moved;
+  moved = moved.erase(2);
+  ASSERT_EQ(second.size(), 2U);
+  ASSERT_EQ(moved.size(), 1U);
+}
+
+TEST(S21PersistentMapTest, SHARED_VERSIONS_1) {
+  persistent_map<int, int> base;
+  for (int key = 0; key < 1000; ++key) {
+    base = base.insert(key, key);
+  }
+  std::vector<persistent_map<int, int>> branches;
+  for (int key = 0; key < 1000; key += 100) {
+    branches.push_back(base.erase(key).insert_or_assign(key + 1, -1));
+  }
+  base = persistent_map<int, int>();
+  for (size_t i = 0; i < branches.size(); ++i) {
+    int key = static_cast<int>(i) * 100;
+    ASSERT_EQ(branches[i].size(), 999U);
+    ASSERT_FALSE(branches[i].contains(key));
+    ASSERT_EQ(branches[i].at(key + 1), -1);
+    ASSERT_EQ(branches[i].at(key + 2), key + 2);
+  }
+}
@@ -0,0 +1,48 @@
+#include <gtest/gtest.h>
+
+#include <set>
+#include <vector>
+
+#include "../containersplus/s21_persistent_set.h"
+
+using namespace s21;
+
+TEST(S21PersistentSetTest, INSERT_ERASE_1) {
+  persistent_set<int> base{5, 1, 3, 3};
+  auto added = base.insert(4);
+  auto removed = added.erase(1);
+  std::vector<int> expected{1, 3, 5};
+  ASSERT_TRUE(std::equal(base.begin(), base.end(), expected.begin(),
+                         expected.end()));
+  expected = {1, 3, 4, 5};
+  ASSERT_TRUE(std::equal(added.begin(), added.end(), expected.begin(),
+                         expected.end()));
+  expected = {3, 4, 5};
+  ASSERT_TRUE(std::equal(removed.begin(), removed.end(), expected.begin(),
+                         expected.end()));
+  ASSERT_EQ(*removed.rbegin(), 5);
+  ASSERT_FALSE(removed.contains(1));
+}
+
+TEST(S21PersistentSetTest, SNAPSHOTS_1) {
+  persistent_set<int> nums;
+  std::set<int> expected;
+  std::vector<persistent_set<int>> snapshots;
+  for (int i = 0; i < 1000; ++i) {
+    nums = nums.insert((i * 37) % 1000);
+    expected.insert((i * 37) % 1000);
+    if (i % 100 == 0) {
+      snapshots.push_back(nums.snapshot());
+    }
+  }
+  for (int i = 0; i < 1000; i += 2) {
+    nums = nums.erase(i);
+    expected.erase(i);
+  }
+  ASSERT_TRUE(std::equal(nums.begin(), nums.end(), expected.begin(),
+                         expected.end()));
+  for (size_t i = 0; i < snapshots.size(); ++i) {
+    ASSERT_EQ(snapshots[i].size(), i * 100 + 1);
+    ASSERT_TRUE(snapshots[i].contains(0));
+  }
+}
@@ -1,6 +1,10 @@
 #include <gtest/gtest.h>
 
 #include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
 
 #include "../Tree/tree.h"
 #include "../containers/s21_set.h"
@@ -148,14 +152,78 @@ TEST(S21SetTest, BEGIN_2) {
   set<int> nums;
   auto it = nums.begin();
 
-  ASSERT_EQ(it, nullptr);
+  ASSERT_EQ(it, nums.end());
 }
 
 TEST(S21SetTest, END_1) {
   set<int> nums{5, 3, 2, 7, 6, 8};
   auto it = nums.end();
 
-  ASSERT_EQ(it, nullptr);
+  ASSERT_EQ(*(--it), 8);
+}
+
+TEST(S21SetTest, END_2) {
+  set<int> nums;
+
+  ASSERT_EQ(nums.begin(), nums.end());
+  nums.insert(1);
+  ASSERT_EQ(++nums.begin(), nums.end());
+}
+
+TEST(S21SetTest, REVERSE_ITERATOR_1) {
+  set<int> nums;
+  for (int i = 0; i < 300; ++i) {
+    nums.insert((i * 17) % 300);
+  }
+
+  int expected = 299;
+  for (auto it = nums.rbegin(); it != nums.rend(); ++it, --expected) {
+    ASSERT_EQ(*it, expected);
+  }
+  ASSERT_EQ(expected, -1);
+}
+
+TEST(S21SetTest, TRANSPARENT_LOOKUP_1) {
+  set<std::string, std::less<>> words{"apple", "banana", "cherry"};
+  std::string_view banana = "banana";
+
+  ASSERT_TRUE(words.contains(banana));
+  ASSERT_FALSE(words.contains("grape"));
+  ASSERT_EQ(*words.find(banana), "banana");
+  ASSERT_TRUE(words.find("grape") == words.end());
+  ASSERT_EQ(words.count("apple"), 1U);
+  ASSERT_EQ(words.count_range("b", "c"), 1U);
+  ASSERT_EQ(words.erase(banana), 1U);
+  ASSERT_EQ(words.erase("banana"), 0U);
+  ASSERT_EQ(words.size(), 2U);
+}
+
+TEST(S21SetTest, TRANSPARENT_ERASE_ITERATOR_1) {
+  using Set = set<std::string, std::less<>>;
+  static_assert(std::is_same_v<decltype(std::declval<Set &>().erase(
+                                   std::declval<Set::const_iterator>())),
+                               Set::iterator>);
+  Set words{"apple", "banana", "cherry"};
+  const Set &view = words;
+
+  Set::const_iterator first = view.begin();
+  ASSERT_EQ(*words.erase(first), "banana");
+  ASSERT_EQ(*words.erase(words.find("banana")), "cherry");
+  ASSERT_EQ(words.size(), 1U);
+  ASSERT_EQ(words.erase("cherry"), 1U);
+  ASSERT_TRUE(words.empty());
+}
+
+TEST(S21SetTest, CUSTOM_COMPARE_1) {
+  set<int, std::greater<int>> nums{1, 5, 3, 4, 2};
+  int expected = 5;
+  for (auto it = nums.begin(); it != nums.end(); ++it, --expected) {
+    ASSERT_EQ(*it, expected);
+  }
+  ASSERT_EQ(expected, 0);
+  ASSERT_EQ(nums.erase(3), 1U);
+  ASSERT_FALSE(nums.contains(3));
+  ASSERT_EQ(*nums.nth(2), 2);
 }
 
 TEST(S21SetTest, EMPTY_1) {
@@ -343,3 +411,343 @@ TEST(S21SetTest, CONTAINS_3) {
   set<int> numbers;
   ASSERT_EQ(numbers.contains(2), false);
 }
+
+TEST(S21SetTest, NTH_1) {
+  set<int> nums;
+  for (int i = 0; i < 500; ++i) {
+    nums.insert((i * 7) % 500);
+  }
+
+  ASSERT_EQ(nums.size(), 500U);
+  for (int k = 0; k < 500; ++k) {
+    ASSERT_EQ(*nums.nth(k), k);
+    ASSERT_EQ(nums.rank(k), static_cast<size_t>(k));
+  }
+  ASSERT_EQ(nums.nth(500), nums.end());
+}
+
+TEST(S21SetTest, COUNT_RANGE_1) {
+  set<int> nums{1, 3, 5, 7, 9};
+  nums.erase(nums.find(5));
+
+  ASSERT_EQ(nums.size(), 4U);
+  ASSERT_EQ(nums.count_range(1, 9), 3U);
+  ASSERT_EQ(nums.count_range(2, 8), 2U);
+  ASSERT_EQ(nums.count_range(4, 6), 0U);
+}
+
+TEST(S21SetTest, ITERATOR_STABILITY_1) {
+  set<std::string> words;
+  auto pinned = words.insert("m").first;
+  std::set<std::string> expected{"m"};
+  for (char c = 'a'; c <= 'z'; ++c) {
+    for (char d = 'a'; d <= 'z'; ++d) {
+      words.insert(std::string{c, d});
+      expected.insert(std::string{c, d});
+    }
+  }
+  ASSERT_EQ(*pinned, "m");
+
+  auto it1 = words.begin();
+  auto it2 = expected.begin();
+  while (it1 != words.end() && it2 != expected.end()) {
+    ASSERT_EQ(*it1, *it2);
+    ++it1;
+    ++it2;
+  }
+  ASSERT_EQ(it1, words.end());
+  ASSERT_EQ(words.find("m"), pinned);
+}
+
+TEST(S21SetTest, CLEAR_3) {
+  set<long> nums;
+  for (long i = 0; i < 1000; ++i) {
+    nums.insert(i);
+  }
+  nums.clear();
+  ASSERT_EQ(nums.size(), 0U);
+  nums.insert(5);
+  ASSERT_EQ(*nums.begin(), 5);
+}
+
+TEST(S21SetTest, RANGE_CONSTRUCTOR_1) {
+  std::vector<int> sorted(777);
+  for (int i = 0; i < 777; ++i) {
+    sorted[i] = i;
+  }
+  set<int> nums(sorted.begin(), sorted.end());
+
+  ASSERT_EQ(nums.size(), 777U);
+  for (int i = 0; i < 777; i += 50) {
+    ASSERT_EQ(*nums.nth(i), i);
+  }
+  for (int i = 0; i < 777; i += 2) {
+    nums.erase(nums.find(i));
+  }
+  ASSERT_EQ(nums.size(), 388U);
+  ASSERT_EQ(*nums.begin(), 1);
+}
+
+TEST(S21SetTest, RANGE_CONSTRUCTOR_2) {
+  std::vector<int> with_duplicates{1, 2, 2, 3};
+  set<int> nums(with_duplicates.begin(), with_duplicates.end());
+
+  ASSERT_EQ(nums.size(), 3U);
+  ASSERT_EQ(*nums.nth(2), 3);
+}
+
+namespace {
+
+std::vector<int> Sequence(int count, int step, int offset) {
+  std::vector<int> result;
+  for (int i = 0; i < count; ++i) {
+    result.push_back((i * step + offset) % 5000);
+  }
+  return result;
+}
+
+template <typename Op>
+void CheckAlgebra(const std::vector<int> &a, const std::vector<int> &b,
+                  void (set<int>::*method)(set<int> &), Op op) {
+  set<int> left(a.begin(), a.end());
+  set<int> right(b.begin(), b.end());
+  std::set<int> std_left(a.begin(), a.end());
+  std::set<int> std_right(b.begin(), b.end());
+  std::vector<int> expected;
+  op(std_left.begin(), std_left.end(), std_right.begin(), std_right.end(),
+     std::back_inserter(expected));
+
+  (left.*method)(right);
+
+  ASSERT_EQ(right.size(), 0U);
+  ASSERT_EQ(left.size(), expected.size());
+  size_t k = 0;
+  for (auto it = left.begin(); it != left.end(); ++it, ++k) {
+    ASSERT_EQ(*it, expected[k]);
+    ASSERT_EQ(*left.nth(k), expected[k]);
+  }
+}
+
+}  // namespace
+
+TEST(S21SetTest, SET_UNION_1) {
+  CheckAlgebra(Sequence(3000, 7, 1), Sequence(200, 13, 5), &set<int>::set_union,
+               [](auto... args) { return std::set_union(args...); });
+  CheckAlgebra(Sequence(10, 3, 0), Sequence(4000, 11, 2), &set<int>::set_union,
+               [](auto... args) { return std::set_union(args...); });
+}
+
+TEST(S21SetTest, SET_INTERSECTION_1) {
+  CheckAlgebra(Sequence(3000, 7, 1), Sequence(2000, 3, 5),
+               &set<int>::set_intersection,
+               [](auto... args) { return std::set_intersection(args...); });
+}
+
+TEST(S21SetTest, SET_DIFFERENCE_1) {
+  CheckAlgebra(Sequence(3000, 7, 1), Sequence(2000, 3, 5),
+               &set<int>::set_difference,
+               [](auto... args) { return std::set_difference(args...); });
+  CheckAlgebra(Sequence(100, 7, 1), std::vector<int>(),
+               &set<int>::set_difference,
+               [](auto... args) { return std::set_difference(args...); });
+}
+
+TEST(S21SetTest, SET_SYMMETRIC_DIFFERENCE_1) {
+  CheckAlgebra(
+      Sequence(3000, 7, 1), Sequence(2000, 3, 5),
+      &set<int>::set_symmetric_difference,
+      [](auto... args) { return std::set_symmetric_difference(args...); });
+}
+
+TEST(S21SetTest, SET_UNION_2) {
+  set<std::string> tags{"a", "c", "e"};
+  auto pinned = tags.find("c");
+  {
+    set<std::string> other{"b", "c", "d"};
+    tags.set_union(other);
+    ASSERT_EQ(other.empty(), true);
+  }
+  tags.insert("f");
+
+  ASSERT_EQ(tags.size(), 6U);
+  ASSERT_EQ(*pinned, "c");
+  ASSERT_EQ(*tags.nth(1), "b");
+}
+
+TEST(S21SetTest, SET_UNION_PARALLEL_1) {
+  ThreadPool workers(4);
+  std::vector<int> a = Sequence(60000, 7, 1);
+  std::vector<int> b = Sequence(50000, 3, 2);
+  set<int> left(a.begin(), a.end()), right(b.begin(), b.end());
+  std::set<int> expected(a.begin(), a.end());
+  expected.insert(b.begin(), b.end());
+
+  left.set_union(right, workers);
+
+  ASSERT_EQ(right.size(), 0U);
+  ASSERT_EQ(left.size(), expected.size());
+  auto it = left.begin();
+  for (int value : expected) {
+    ASSERT_EQ(*it, value);
+    ++it;
+  }
+}
+
+TEST(S21SetTest, SET_DIFFERENCE_PARALLEL_1) {
+  ThreadPool workers(3);
+  set<int> left, right;
+  for (int i = 0; i < 100000; ++i) {
+    left.insert(i);
+    if (i % 3 == 0) {
+      right.insert(i);
+    }
+  }
+  set<int> intersection_left = left, intersection_right = right;
+
+  left.set_difference(right, workers);
+  intersection_left.set_intersection(intersection_right, workers);
+
+  ASSERT_EQ(left.size(), 66666U);
+  ASSERT_EQ(left.contains(3), false);
+  ASSERT_EQ(left.contains(4), true);
+  ASSERT_EQ(intersection_left.size(), 33334U);
+  ASSERT_EQ(*intersection_left.nth(1), 3);
+}
+
+TEST(S21SetTest, INSERT_HINT_1) {
+  set<int> nums;
+  for (int i = 0; i < 1000; i += 2) {
+    nums.insert(nums.end(), i);
+  }
+  for (int i = 1; i < 1000; i += 2) {
+    ASSERT_EQ(*nums.insert(nums.find(i + 1), i), i);
+  }
+  ASSERT_EQ(*nums.emplace_hint(nums.end(), 10), 10);
+  ASSERT_EQ(nums.size(), 1000U);
+  int expected = 0;
+  for (int key : nums) {
+    ASSERT_EQ(key, expected++);
+  }
+  ASSERT_EQ(*nums.nth(999), 999);
+}
+
+TEST(S21SetTest, EMPLACE_1) {
+  set<std::string> words;
+  std::string word = "pear";
+  ASSERT_TRUE(words.insert(std::move(word)).second);
+  ASSERT_TRUE(words.emplace(3, 'a').second);
+  ASSERT_FALSE(words.emplace("aaa").second);
+  ASSERT_FALSE(words.insert(std::string("pear")).second);
+  ASSERT_EQ(words.size(), 2U);
+  ASSERT_EQ(*words.begin(), "aaa");
+}
+
+TEST(S21SetTest, NODE_HANDLE_1) {
+  set<std::string> source{"apple", "pear", "plum"};
+  set<std::string> target{"plum"};
+  const std::string *pear = &*source.find("pear");
+
+  auto node = source.extract("pear");
+  ASSERT_EQ(&node.value(), pear);
+  ASSERT_EQ(source.size(), 2U);
+  node.value() = "peach";
+  auto result = target.insert(std::move(node));
+  ASSERT_TRUE(result.inserted);
+  ASSERT_EQ(*result.position, "peach");
+  ASSERT_EQ(*target.begin(), "peach");
+  ASSERT_EQ(&*target.begin(), pear);
+
+  result = target.insert(source.extract(source.find("plum")));
+  ASSERT_FALSE(result.inserted);
+  ASSERT_EQ(result.node.value(), "plum");
+  ASSERT_EQ(source.size(), 1U);
+
+  const std::string *apple = &*source.find("apple");
+  ASSERT_TRUE(source.insert(source.extract("apple")).inserted);
+  ASSERT_EQ(&*source.find("apple"), apple);
+}
+
+TEST(S21SetTest, MERGE_SPLICE_1) {
+  set<int> first{1, 3, 5};
+  set<int> second{2, 3, 4};
+  const int *four = &*second.find(4);
+  first.merge(second);
+  ASSERT_EQ(&*first.find(4), four);
+  ASSERT_EQ(first.size(), 5U);
+  ASSERT_TRUE(first.contains(4));
+  ASSERT_EQ(second.size(), 1U);
+  ASSERT_TRUE(second.contains(3));
+
+  first.swap(second);
+  ASSERT_EQ(first.size(), 1U);
+  ASSERT_EQ(second.size(), 5U);
+  second.clear();
+  ASSERT_TRUE(first.contains(3));
+}
+
+TEST(S21SetTest, BOUNDS_1) {
+  set<int> numbers{5, 10, 15, 20};
+  ASSERT_EQ(*numbers.lower_bound(10), 10);
+  ASSERT_EQ(*numbers.upper_bound(10), 15);
+  ASSERT_EQ(numbers.lower_bound(21), numbers.end());
+  auto range = numbers.equal_range(12);
+  ASSERT_EQ(range.first, range.second);
+  ASSERT_EQ(*range.first, 15);
+
+  auto next = numbers.erase(numbers.find(10));
+  ASSERT_EQ(*next, 15);
+  next = numbers.erase(numbers.begin(), numbers.lower_bound(20));
+  ASSERT_EQ(*next, 20);
+  ASSERT_EQ(numbers.size(), 1U);
+
+  std::vector<int> seen;
+  set<int> more{1, 2, 3, 4, 5, 6};
+  more.for_each_in_range(2, 5, [&](int value) { seen.push_back(value); });
+  ASSERT_EQ(seen, (std::vector<int>{2, 3, 4}));
+}
+
+TEST(S21SetTest, FIND_MANY_1) {
+  set<int> numbers;
+  for (int i = 0; i < 1000; i += 3) {
+    numbers.insert(i);
+  }
+  std::vector<int> keys;
+  for (int i = -5; i < 1005; ++i) {
+    keys.push_back((i * 37) % 1010);
+  }
+  std::vector<bool> present;
+  numbers.contains_many(keys, present);
+  std::vector<set<int>::iterator> found;
+  numbers.find_many(keys, found);
+  ASSERT_EQ(present.size(), keys.size());
+  ASSERT_EQ(found.size(), keys.size());
+  for (size_t i = 0; i < keys.size(); ++i) {
+    ASSERT_EQ(present[i], numbers.contains(keys[i]));
+    ASSERT_EQ(found[i], numbers.find(keys[i]));
+  }
+
+  set<int> empty;
+  empty.contains_many(keys, present);
+  ASSERT_EQ(std::count(present.begin(), present.end(), true), 0);
+  numbers.contains_many(std::vector<int>(), present);
+  ASSERT_TRUE(present.empty());
+}
+
+TEST(S21SetTest, STATS_1) {
+  set<int, std::less<int>, TreeCountStats> counted;
+  for (int i = 0; i < 64; ++i) {
+    counted.insert(i);
+  }
+  uint64_t rotations = counted.stats().rotations;
+  ASSERT_GT(rotations, 0U);
+  set<int, std::less<int>, TreeCountStats> copy(counted);
+  ASSERT_EQ(copy.stats().rotations, 0U);
+  ASSERT_EQ(copy.stats().nodes, 64U);
+  ASSERT_EQ(copy.key_comp()(1, 2), true);
+
+  set<int> sorted{1, 2, 3, 4, 5, 6, 7};
+  auto stats = sorted.stats();
+  ASSERT_EQ(stats.height, 3U);
+  ASSERT_EQ(stats.leafDepths, (std::vector<size_t>{0, 0, 4}));
+  ASSERT_EQ(stats.rotations, 0U);
+}
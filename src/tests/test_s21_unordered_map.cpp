@@ -0,0 +1,93 @@
+#include <gtest/gtest.h>
+
+#include <string>
+#include <unordered_map>
+
+#include "../containersplus/s21_unordered_map.h"
+
+using namespace s21;
+
+TEST(S21UnorderedMapTest, INSERT_1) {
+  unordered_map<int, std::string> nums;
+  ASSERT_TRUE(nums.insert({1, "one"}).second);
+  ASSERT_TRUE(nums.insert(2, "two").second);
+  auto result = nums.insert(2, "second two");
+  ASSERT_FALSE(result.second);
+  ASSERT_EQ(result.first->second, "two");
+  ASSERT_EQ(nums.size(), 2U);
+  ASSERT_EQ(nums.at(1), "one");
+  ASSERT_THROW(nums.at(3), std::out_of_range);
+}
+
+TEST(S21UnorderedMapTest, OPERATOR_BRACKETS_1) {
+  unordered_map<std::string, int> words;
+  for (int i = 0; i < 1000; ++i) {
+    words[std::to_string(i % 100)] += 1;
+  }
+  ASSERT_EQ(words.size(), 100U);
+  ASSERT_EQ(words["42"], 10);
+  ASSERT_LE(words.load_factor(), 0.875f);
+}
+
+TEST(S21UnorderedMapTest, INSERT_OR_ASSIGN_1) {
+  unordered_map<int, int> nums{{1, 10}};
+  ASSERT_FALSE(nums.insert_or_assign(1, 11).second);
+  ASSERT_TRUE(nums.insert_or_assign(2, 20).second);
+  ASSERT_EQ(nums.at(1), 11);
+  ASSERT_EQ(nums.at(2), 20);
+}
+
+TEST(S21UnorderedMapTest, ERASE_1) {
+  unordered_map<int, int> nums;
+  std::unordered_map<int, int> expected;
+  for (int i = 0; i < 5000; ++i) {
+    nums[i] = i;
+    expected[i] = i;
+  }
+  for (int i = 0; i < 5000; i += 3) {
+    ASSERT_EQ(nums.erase(i), 1U);
+    expected.erase(i);
+  }
+  ASSERT_EQ(nums.erase(0), 0U);
+  for (auto it = nums.begin(); it != nums.end();) {
+    it = it->first % 2 == 0 ? nums.erase(it) : ++it;
+  }
+  for (auto it = expected.begin(); it != expected.end();) {
+    it = it->first % 2 == 0 ? expected.erase(it) : ++it;
+  }
+  ASSERT_EQ(nums.size(), expected.size());
+  for (const auto &item : nums) {
+    ASSERT_EQ(expected.at(item.first), item.second);
+  }
+}
+
+TEST(S21UnorderedMapTest, MERGE_1) {
+  unordered_map<int, int> first{{1, 1}, {2, 2}};
+  unordered_map<int, int> second{{2, 20}, {3, 30}};
+  first.merge(second);
+  ASSERT_EQ(first.size(), 3U);
+  ASSERT_EQ(first.at(2), 2);
+  ASSERT_EQ(first.at(3), 30);
+  ASSERT_TRUE(first.contains(3));
+  ASSERT_FALSE(first.contains(4));
+  ASSERT_EQ(second.size(), 1U);
+  ASSERT_EQ(second.at(2), 20);
+}
+
+TEST(S21UnorderedMapTest, COPY_MOVE_CLEAR_1) {
+  unordered_map<int, std::string> nums;
+  nums.reserve(100);
+  size_t buckets = nums.bucket_count();
+  for (int i = 0; i < 100; ++i) {
+    nums[i] = std::to_string(i);
+  }
+  ASSERT_EQ(nums.bucket_count(), buckets);
+  unordered_map<int, std::string> copy(nums);
+  unordered_map<int, std::string> moved(std::move(nums));
+  ASSERT_EQ(copy.at(99), "99");
+  ASSERT_EQ(moved.at(50), "50");
+  ASSERT_TRUE(nums.empty());
+  moved.clear();
+  ASSERT_TRUE(moved.begin() == moved.end());
+  ASSERT_EQ(moved.bucket_count(), buckets);
+}
@@ -0,0 +1,214 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cctype>
+#include <functional>
+#include <string>
+#include <unordered_set>
+
+#include "../containersplus/s21_unordered_set.h"
+#include "test_random.h"
+
+using namespace s21;
+
+TEST(S21UnorderedSetTest, INSERT_1) {
+  unordered_set<int> nums{1, 2, 3, 2};
+  ASSERT_EQ(nums.size(), 3U);
+  ASSERT_FALSE(nums.insert(1).second);
+  auto result = nums.insert(4);
+  ASSERT_TRUE(result.second);
+  ASSERT_EQ(*result.first, 4);
+  ASSERT_EQ(nums.count(4), 1U);
+}
+
+TEST(S21UnorderedSetTest, RANDOM_1) {
+  unordered_set<long> nums;
+  std::unordered_set<long> expected;
+  TestRandom random(3);
+  for (int i = 0; i < 30000; ++i) {
+    unsigned state = random.next();
+    long key = static_cast<long>((state >> 8) % 4000) << 20;
+    if (state % 3 == 0) {
+      ASSERT_EQ(nums.erase(key), expected.erase(key));
+    } else {
+      ASSERT_EQ(nums.insert(key).second, expected.insert(key).second);
+    }
+  }
+  ASSERT_EQ(nums.size(), expected.size());
+  size_t seen = 0;
+  for (long key : nums) {
+    ASSERT_EQ(expected.count(key), 1U);
+    ++seen;
+  }
+  ASSERT_EQ(seen, expected.size());
+}
+
+TEST(S21UnorderedSetTest, FIND_1) {
+  unordered_set<std::string> words{"pear", "apple"};
+  ASSERT_EQ(*words.find("pear"), "pear");
+  ASSERT_TRUE(words.find("plum") == words.end());
+  words.erase(words.find("pear"));
+  ASSERT_FALSE(words.contains("pear"));
+  ASSERT_EQ(words.size(), 1U);
+}
+
+TEST(S21UnorderedSetTest, MERGE_1) {
+  unordered_set<std::string> first{"apple", "pear"};
+  unordered_set<std::string> second{"fig", "pear", "plum"};
+  first.merge(second);
+  ASSERT_EQ(first.size(), 4U);
+  ASSERT_TRUE(first.contains("plum"));
+  ASSERT_EQ(second.size(), 1U);
+  ASSERT_TRUE(second.contains("pear"));
+}
+
+TEST(S21UnorderedSetTest, EMPTY_1) {
+  unordered_set<int> nums;
+  ASSERT_TRUE(nums.empty());
+  ASSERT_EQ(nums.size(), 0U);
+  ASSERT_GT(nums.max_size(), 0U);
+  ASSERT_EQ(nums.load_factor(), 0.0f);
+  ASSERT_TRUE(nums.begin() == nums.end());
+  ASSERT_TRUE(nums.find(0) == nums.end());
+  ASSERT_FALSE(nums.contains(0));
+  ASSERT_EQ(nums.count(0), 0U);
+  ASSERT_EQ(nums.erase(0), 0U);
+  unordered_set<int> other;
+  nums.merge(other);
+  nums.clear();
+  ASSERT_TRUE(nums.empty());
+}
+
+TEST(S21UnorderedSetTest, ERASE_LAST_1) {
+  unordered_set<int> one{7};
+  ASSERT_TRUE(one.erase(one.begin()) == one.end());
+  ASSERT_TRUE(one.empty());
+  ASSERT_TRUE(one.begin() == one.end());
+  ASSERT_TRUE(one.insert(7).second);
+  ASSERT_EQ(one.erase(7), 1U);
+  ASSERT_FALSE(one.contains(7));
+
+  unordered_set<int> nums{1, 2, 3};
+  ASSERT_EQ(nums.erase(1) + nums.erase(2) + nums.erase(3), 3U);
+  ASSERT_TRUE(nums.begin() == nums.end());
+}
+
+TEST(S21UnorderedSetTest, ERASE_ITERATOR_1) {
+  unordered_set<int> nums;
+  for (int i = 0; i < 1000; ++i) {
+    nums.insert(i);
+  }
+  for (auto iter = nums.begin(); iter != nums.end();) {
+    if (*iter % 3 == 0) {
+      iter = nums.erase(iter);
+    } else {
+      ++iter;
+    }
+  }
+  ASSERT_EQ(nums.size(), 666U);
+  for (int i = 0; i < 1000; ++i) {
+    ASSERT_EQ(nums.contains(i), i % 3 != 0);
+  }
+}
+
+TEST(S21UnorderedSetTest, RESERVE_1) {
+  unordered_set<int> nums;
+  nums.reserve(1000);
+  size_t buckets = nums.bucket_count();
+  ASSERT_GE(buckets, 1000U);
+  nums.insert(0);
+  const int *first = &*nums.find(0);
+  for (int i = 1; i < 1000; ++i) {
+    nums.insert(i);
+  }
+  ASSERT_EQ(nums.bucket_count(), buckets);
+  ASSERT_EQ(&*nums.find(0), first);
+  ASSERT_GT(nums.load_factor(), 0.0f);
+  ASSERT_LE(nums.load_factor(), 1.0f);
+
+  nums.reserve(10);
+  ASSERT_EQ(nums.bucket_count(), buckets);
+  nums.clear();
+  ASSERT_EQ(nums.bucket_count(), buckets);
+  ASSERT_EQ(nums.load_factor(), 0.0f);
+}
+
+// Erased slots are reused, churn on a fixed key range must not grow the
+// table or lose keys behind deleted slots
+TEST(S21UnorderedSetTest, CHURN_1) {
+  unordered_set<int> nums;
+  for (int i = 0; i < 100; ++i) {
+    nums.insert(i);
+  }
+  size_t buckets = nums.bucket_count();
+  for (int round = 0; round < 50; ++round) {
+    for (int i = round % 2; i < 100; i += 2) {
+      ASSERT_EQ(nums.erase(i), 1U);
+    }
+    for (int i = round % 2; i < 100; i += 2) {
+      ASSERT_TRUE(nums.insert(i).second);
+    }
+  }
+  ASSERT_EQ(nums.size(), 100U);
+  ASSERT_LE(nums.bucket_count(), buckets * 2 + 1);
+  for (int i = 0; i < 100; ++i) {
+    ASSERT_TRUE(nums.contains(i));
+  }
+}
+
+struct CaseInsensitiveHash {
+  size_t operator()(const std::string &word) const {
+    std::string lower(word);
+    for (char &c : lower) {
+      c = static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+    }
+    return std::hash<std::string>()(lower);
+  }
+};
+
+struct CaseInsensitiveEqual {
+  bool operator()(const std::string &a, const std::string &b) const {
+    return a.size() == b.size() &&
+           std::equal(a.begin(), a.end(), b.begin(), [](char x, char y) {
+             return std::tolower(static_cast<unsigned char>(x)) ==
+                    std::tolower(static_cast<unsigned char>(y));
+           });
+  }
+};
+
+TEST(S21UnorderedSetTest, CUSTOM_HASH_1) {
+  unordered_set<std::string, CaseInsensitiveHash, CaseInsensitiveEqual> words{
+      "Pear", "pear", "APPLE"};
+  ASSERT_EQ(words.size(), 2U);
+  ASSERT_FALSE(words.insert("PEAR").second);
+  ASSERT_EQ(*words.find("apple"), "APPLE");
+  ASSERT_TRUE(words.contains("pEaR"));
+  ASSERT_EQ(words.erase("Apple"), 1U);
+  ASSERT_TRUE(words.key_eq()("a", "A"));
+  ASSERT_EQ(words.hash_function()("X"), words.hash_function()("x"));
+}
+
+TEST(S21UnorderedSetTest, COPY_MOVE_SWAP_1) {
+  unordered_set<int> first;
+  for (int i = 0; i < 200; ++i) {
+    first.insert(i);
+  }
+  unordered_set<int> copy(first);
+  copy.erase(0);
+  ASSERT_TRUE(first.contains(0));
+  ASSERT_EQ(copy.size(), 199U);
+
+  unordered_set<int> moved(std::move(copy));
+  ASSERT_TRUE(copy.empty());
+  ASSERT_TRUE(copy.begin() == copy.end());
+  unordered_set<int> small{-1};
+  small.swap(moved);
+  ASSERT_EQ(small.size(), 199U);
+  ASSERT_EQ(*moved.begin(), -1);
+  moved = first;
+  ASSERT_EQ(moved.size(), 200U);
+  first = std::move(small);
+  ASSERT_FALSE(first.contains(0));
+  copy.insert(5);
+  ASSERT_TRUE(copy.contains(5));
+}
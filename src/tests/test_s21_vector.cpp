@@ -1,5 +1,7 @@
 #include <gtest/gtest.h>
 
+#include <string>
+
 #include "../containers/s21_vector.h"
 
 using namespace s21;
@@ -39,6 +41,21 @@ TEST(VectorTest, CopyConstructor) {
   }
 }
 
+TEST(VectorTest, CopyConstructorReserved) {
+  vector<int> v1;
+  v1.reserve(8);
+  vector<int> v2(v1);
+  EXPECT_TRUE(v2.empty());
+  EXPECT_EQ(v2.capacity(), 0);
+  v2.push_back(7);
+  EXPECT_EQ(v2[0], 7);
+
+  v1.push_back(1);
+  vector<int> v3(v1);
+  EXPECT_EQ(v3.capacity(), 1);
+  EXPECT_EQ(v1.capacity(), 8);
+}
+
 TEST(VectorTest, MoveConstructor) {
   vector<int> v1{1, 2, 3, 4, 5};
   vector<int> v2(std::move(v1));
@@ -174,6 +191,31 @@ TEST(VectorTest, InsertAtEnd) {
   EXPECT_EQ(v[3], 4);
 }
 
+TEST(VectorTest, InsertEraseMiddleStrings) {
+  s21::vector<std::string> v;
+  v.push_back("a");
+  v.push_back("d");
+  v.insert(v.begin() + 1, std::string("c"));
+  v.insert(v.begin() + 1, std::string("b"));
+  EXPECT_EQ(v[0], "a");
+  EXPECT_EQ(v[1], "b");
+  EXPECT_EQ(v[2], "c");
+  EXPECT_EQ(v[3], "d");
+  v.erase(v.begin() + 1);
+  EXPECT_EQ(v.size(), 3);
+  EXPECT_EQ(v[1], "c");
+  EXPECT_EQ(v[2], "d");
+}
+
+TEST(VectorTest, CopyAssignEmpty) {
+  s21::vector<int> v{1, 2, 3};
+  s21::vector<int> empty;
+  v = empty;
+  EXPECT_TRUE(v.empty());
+  v.push_back(4);
+  EXPECT_EQ(v[0], 4);
+}
+
 TEST(VectorTest, EraseAtBegin) {
   s21::vector<int> v{1, 2, 3, 4};
   v.erase(v.begin());